@@ -0,0 +1,6 @@
+#include "bench.hpp"
+
+// yuki2d_bench [--dir bench] [--filter name] [--steps 600] [--warmup 60] [--out results.json]
+int main(int argc, char** argv) {
+    return yuki::benchMain(argc, argv, 1);
+}
@@ -0,0 +1,331 @@
+#include "alloc_tracker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#if defined(__GNUC__) && !defined(_WIN32)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#define YUKI_HAVE_DLADDR 1
+#endif
+
+namespace yuki {
+namespace {
+// Constant-initialized so operator new can use them before any static
+// constructor has run.
+struct Counters {
+    std::atomic<uint64_t> allocs{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<int64_t> liveBytes{0};
+    std::atomic<int64_t> liveBlocks{0};
+    std::atomic<uint64_t> tagAllocs[kAllocTagCount] = {};
+    std::atomic<uint64_t> tagBytes[kAllocTagCount] = {};
+    std::atomic<int64_t> tagLive[kAllocTagCount] = {};
+};
+Counters counters;
+
+thread_local AllocTag currentTag = AllocTag::General;
+
+// Open-addressed table keyed by return address; filled without allocating.
+constexpr size_t kMaxSites = 2048;
+constexpr size_t kSiteProbes = 32;
+struct SiteSlot {
+    std::atomic<uintptr_t> address{0};
+    std::atomic<uint64_t> allocs{0};
+    std::atomic<uint64_t> bytes{0};
+};
+SiteSlot sites[kMaxSites];
+std::atomic<bool> recordSites{false};
+std::atomic<uint64_t> droppedSites{0};
+
+[[maybe_unused]] void recordSite(uintptr_t address, size_t size) {
+    size_t slot = (address >> 4) * 0x9E3779B97F4A7C15ull % kMaxSites;
+    for (size_t probe = 0; probe < kSiteProbes; ++probe, slot = (slot + 1) % kMaxSites) {
+        SiteSlot& s = sites[slot];
+        uintptr_t seen = s.address.load(std::memory_order_relaxed);
+        if (seen == 0 && s.address.compare_exchange_strong(seen, address, std::memory_order_relaxed)) seen = address;
+        if (seen != address) continue;
+        s.allocs.fetch_add(1, std::memory_order_relaxed);
+        s.bytes.fetch_add(size, std::memory_order_relaxed);
+        return;
+    }
+    droppedSites.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string siteName(uintptr_t address) {
+    char buf[256];
+#ifdef YUKI_HAVE_DLADDR
+    Dl_info info{};
+    if (dladdr((void*)address, &info)) {
+        if (info.dli_sname) {
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+            std::free(demangled);
+            if (name.size() > 80) name = name.substr(0, 77) + "...";
+            std::snprintf(buf, sizeof(buf), "%s+0x%zx", name.c_str(), (size_t)(address - (uintptr_t)info.dli_saddr));
+            return buf;
+        }
+        if (info.dli_fname) {
+            // No exported symbol; module offset for addr2line.
+            std::string module = info.dli_fname;
+            size_t slash = module.find_last_of('/');
+            if (slash != std::string::npos) module = module.substr(slash + 1);
+            std::snprintf(buf, sizeof(buf), "%s+0x%zx", module.c_str(), (size_t)(address - (uintptr_t)info.dli_fbase));
+            return buf;
+        }
+    }
+#endif
+    std::snprintf(buf, sizeof(buf), "0x%zx", (size_t)address);
+    return buf;
+}
+
+std::string formatBytes(double bytes) {
+    char buf[32];
+    if (bytes >= 1024.0 * 1024.0) std::snprintf(buf, sizeof(buf), "%.1f MB", bytes / (1024.0 * 1024.0));
+    else if (bytes >= 1024.0) std::snprintf(buf, sizeof(buf), "%.1f KB", bytes / 1024.0);
+    else std::snprintf(buf, sizeof(buf), "%.0f B", bytes);
+    return buf;
+}
+
+#ifdef YUKI_ALLOC_TRACKING
+// Keeps the caller's memory at the default new alignment.
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) BlockHeader {
+    size_t size;
+    AllocTag tag;
+};
+
+void* trackedAlloc(size_t size, uintptr_t site) {
+    void* raw = std::malloc(sizeof(BlockHeader) + size);
+    if (!raw) return nullptr;
+    BlockHeader* header = static_cast<BlockHeader*>(raw);
+    header->size = size;
+    header->tag = currentTag;
+    size_t tag = (size_t)header->tag;
+    counters.allocs.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    counters.liveBytes.fetch_add((int64_t)size, std::memory_order_relaxed);
+    counters.liveBlocks.fetch_add(1, std::memory_order_relaxed);
+    counters.tagAllocs[tag].fetch_add(1, std::memory_order_relaxed);
+    counters.tagBytes[tag].fetch_add(size, std::memory_order_relaxed);
+    counters.tagLive[tag].fetch_add((int64_t)size, std::memory_order_relaxed);
+    if (recordSites.load(std::memory_order_relaxed)) recordSite(site, size);
+    return header + 1;
+}
+
+void* allocOrThrow(size_t size, uintptr_t site) {
+    for (;;) {
+        if (void* p = trackedAlloc(size, site)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void trackedFree(void* p) {
+    if (!p) return;
+    BlockHeader* header = static_cast<BlockHeader*>(p) - 1;
+    size_t tag = (size_t)header->tag;
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+    counters.liveBytes.fetch_sub((int64_t)header->size, std::memory_order_relaxed);
+    counters.liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+    counters.tagLive[tag].fetch_sub((int64_t)header->size, std::memory_order_relaxed);
+    std::free(header);
+}
+#endif
+} // namespace
+
+const char* allocTagName(AllocTag tag) {
+    switch (tag) {
+        case AllocTag::General: return "general";
+        case AllocTag::Script: return "script";
+        case AllocTag::Engine: return "engine";
+        case AllocTag::Render: return "render";
+        case AllocTag::Assets: return "assets";
+        case AllocTag::Ui: return "ui";
+        case AllocTag::Jobs: return "jobs";
+        case AllocTag::Count: break;
+    }
+    return "?";
+}
+
+AllocTracker::AllocTracker() {
+    reset();
+}
+
+bool AllocTracker::available() {
+#ifdef YUKI_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocTracker::endFrame() {
+    uint64_t allocs = counters.allocs.load(std::memory_order_relaxed);
+    uint64_t frees = counters.frees.load(std::memory_order_relaxed);
+    uint64_t bytes = counters.bytes.load(std::memory_order_relaxed);
+    last.allocs = allocs - baseAllocs;
+    last.frees = frees - baseFrees;
+    last.bytes = bytes - baseBytes;
+    baseAllocs = allocs;
+    baseFrees = frees;
+    baseBytes = bytes;
+    for (size_t t = 0; t < kAllocTagCount; ++t) {
+        uint64_t tagAllocs = counters.tagAllocs[t].load(std::memory_order_relaxed);
+        last.tagAllocs[t] = tagAllocs - baseTagAllocs[t];
+        baseTagAllocs[t] = tagAllocs;
+    }
+    ++frames;
+    totalAllocs += last.allocs;
+    peak = std::max(peak, last.allocs);
+}
+
+void AllocTracker::reset() {
+    last = FrameStats{};
+    frames = 0;
+    totalAllocs = 0;
+    peak = 0;
+    baseAllocs = counters.allocs.load(std::memory_order_relaxed);
+    baseFrees = counters.frees.load(std::memory_order_relaxed);
+    baseBytes = counters.bytes.load(std::memory_order_relaxed);
+    for (size_t t = 0; t < kAllocTagCount; ++t) baseTagAllocs[t] = counters.tagAllocs[t].load(std::memory_order_relaxed);
+    // Racing allocations may land in a slot being cleared; the counts are
+    // only approximate for that instant.
+    for (SiteSlot& s : sites) {
+        s.address.store(0, std::memory_order_relaxed);
+        s.allocs.store(0, std::memory_order_relaxed);
+        s.bytes.store(0, std::memory_order_relaxed);
+    }
+    droppedSites.store(0, std::memory_order_relaxed);
+}
+
+double AllocTracker::averageAllocs() const {
+    return frames ? (double)totalAllocs / (double)frames : 0.0;
+}
+
+int64_t AllocTracker::liveBytes() const {
+    return counters.liveBytes.load(std::memory_order_relaxed);
+}
+
+int64_t AllocTracker::liveBlocks() const {
+    return counters.liveBlocks.load(std::memory_order_relaxed);
+}
+
+AllocTracker::TagStats AllocTracker::tagStats(AllocTag tag) const {
+    size_t t = (size_t)tag;
+    TagStats stats;
+    if (t >= kAllocTagCount) return stats;
+    stats.allocs = counters.tagAllocs[t].load(std::memory_order_relaxed);
+    stats.bytes = counters.tagBytes[t].load(std::memory_order_relaxed);
+    stats.liveBytes = counters.tagLive[t].load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AllocTracker::setRecordSites(bool on) {
+    recordSites.store(on, std::memory_order_relaxed);
+}
+
+bool AllocTracker::isRecordingSites() const {
+    return recordSites.load(std::memory_order_relaxed);
+}
+
+std::vector<AllocTracker::Site> AllocTracker::topSites(size_t count) const {
+    std::vector<Site> found;
+    for (const SiteSlot& s : sites) {
+        uintptr_t address = s.address.load(std::memory_order_relaxed);
+        if (address == 0) continue;
+        Site site;
+        site.address = address;
+        site.allocs = s.allocs.load(std::memory_order_relaxed);
+        site.bytes = s.bytes.load(std::memory_order_relaxed);
+        found.push_back(site);
+    }
+    std::sort(found.begin(), found.end(), [](const Site& a, const Site& b) { return a.allocs > b.allocs; });
+    if (found.size() > count) found.resize(count);
+    for (Site& site : found) site.name = siteName(site.address);
+    return found;
+}
+
+std::vector<std::string> AllocTracker::report(size_t siteLines) const {
+    std::vector<std::string> out;
+    if (!available()) {
+        out.push_back("allocation tracking not compiled in (configure with -DYUKI_ALLOC_TRACKING=ON)");
+        return out;
+    }
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "last frame: %llu allocs (%s), %llu frees; avg %.1f, peak %llu over %llu frames",
+                  (unsigned long long)last.allocs, formatBytes((double)last.bytes).c_str(), (unsigned long long)last.frees,
+                  averageAllocs(), (unsigned long long)peak, (unsigned long long)frames);
+    out.push_back(buf);
+    std::snprintf(buf, sizeof(buf), "live: %s in %lld blocks", formatBytes((double)liveBytes()).c_str(), (long long)liveBlocks());
+    out.push_back(buf);
+    for (size_t t = 0; t < kAllocTagCount; ++t) {
+        TagStats stats = tagStats((AllocTag)t);
+        if (stats.allocs == 0) continue;
+        std::snprintf(buf, sizeof(buf), "  %-8s last %6llu  live %10s  total %llu",
+                      allocTagName((AllocTag)t), (unsigned long long)last.tagAllocs[t],
+                      formatBytes((double)stats.liveBytes).c_str(), (unsigned long long)stats.allocs);
+        out.push_back(buf);
+    }
+    if (siteLines == 0) return out;
+    std::vector<Site> top = topSites(siteLines);
+    if (top.empty()) {
+        out.push_back(isRecordingSites() ? "no allocation sites recorded yet" : "sites not recorded (allocs sites on)");
+        return out;
+    }
+    out.push_back("top sites:");
+    for (const Site& site : top) {
+        std::snprintf(buf, sizeof(buf), "  %8llu %10s  %s", (unsigned long long)site.allocs,
+                      formatBytes((double)site.bytes).c_str(), site.name.c_str());
+        out.push_back(buf);
+    }
+    uint64_t dropped = droppedSites.load(std::memory_order_relaxed);
+    if (dropped) out.push_back("  (" + std::to_string(dropped) + " allocations from untracked sites)");
+    return out;
+}
+
+AllocTracker& allocTracker() {
+    static AllocTracker tracker;
+    return tracker;
+}
+
+AllocScope::AllocScope(AllocTag tag) : previous(currentTag) {
+    currentTag = tag;
+}
+
+AllocScope::~AllocScope() {
+    currentTag = previous;
+}
+
+} // namespace yuki
+
+#ifdef YUKI_ALLOC_TRACKING
+// The aligned and nothrow forms are left to the standard library; the
+// nothrow ones forward here, the aligned ones are not tracked.
+void* operator new(std::size_t size) {
+    return yuki::allocOrThrow(size, (uintptr_t)__builtin_return_address(0));
+}
+
+void* operator new[](std::size_t size) {
+    return yuki::allocOrThrow(size, (uintptr_t)__builtin_return_address(0));
+}
+
+void operator delete(void* p) noexcept {
+    yuki::trackedFree(p);
+}
+
+void operator delete[](void* p) noexcept {
+    yuki::trackedFree(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    yuki::trackedFree(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    yuki::trackedFree(p);
+}
+#endif
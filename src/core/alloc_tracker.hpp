@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yuki {
+
+// Subsystem an allocation is charged to. The tag is per thread and set with
+// AllocScope; everything outside a scope counts as General.
+enum class AllocTag : uint8_t { General, Script, Engine, Render, Assets, Ui, Jobs, Count };
+constexpr size_t kAllocTagCount = (size_t)AllocTag::Count;
+const char* allocTagName(AllocTag tag);
+
+// Heap allocation counters fed by replacement global operator new/delete
+// (alloc_tracker.cpp, compiled in with the YUKI_ALLOC_TRACKING CMake
+// option). Counting is always on and lock-free; every block carries a small
+// header with its size and tag so frees update the live totals. Counts cover
+// all threads. The runner calls endFrame() once per frame to turn the running
+// totals into per-frame numbers.
+//
+// Allocation sites (the return address of operator new, resolved to a symbol
+// when reported) are only recorded while setRecordSites(true); allocations
+// made inside the standard library (std::string growth, for example) show up
+// under the library function.
+class AllocTracker {
+public:
+    struct TagStats {
+        uint64_t allocs = 0;
+        uint64_t bytes = 0;
+        int64_t liveBytes = 0;
+    };
+    struct FrameStats {
+        uint64_t allocs = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0; // requested by this frame's allocations
+        uint64_t tagAllocs[kAllocTagCount] = {};
+    };
+    struct Site {
+        uintptr_t address = 0;
+        uint64_t allocs = 0;
+        uint64_t bytes = 0;
+        std::string name; // symbol+offset or module+offset
+    };
+
+    AllocTracker();
+    AllocTracker(const AllocTracker&) = delete;
+    AllocTracker& operator=(const AllocTracker&) = delete;
+
+    // False when built without YUKI_ALLOC_TRACKING; all counters stay zero.
+    static bool available();
+
+    void endFrame();
+    // Starts a new measurement: the next endFrame() only counts allocations
+    // made from now on, averages and peaks restart, recorded sites are cleared.
+    void reset();
+
+    const FrameStats& lastFrame() const { return last; }
+    uint64_t framesMeasured() const { return frames; }
+    double averageAllocs() const;
+    uint64_t peakAllocs() const { return peak; }
+    int64_t liveBytes() const;
+    int64_t liveBlocks() const;
+    TagStats tagStats(AllocTag tag) const; // totals since startup
+
+    void setRecordSites(bool on);
+    bool isRecordingSites() const;
+    std::vector<Site> topSites(size_t count) const;
+
+    // Human readable summary shared by the console and --simulate.
+    std::vector<std::string> report(size_t siteLines) const;
+
+private:
+    FrameStats last;
+    uint64_t frames = 0;
+    uint64_t totalAllocs = 0;
+    uint64_t peak = 0;
+    uint64_t baseAllocs = 0;
+    uint64_t baseFrees = 0;
+    uint64_t baseBytes = 0;
+    uint64_t baseTagAllocs[kAllocTagCount] = {};
+};
+
+AllocTracker& allocTracker();
+
+// RAII subsystem tag for the current thread: `AllocScope scope(AllocTag::Render);`
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag tag);
+    ~AllocScope();
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+private:
+    AllocTag previous;
+};
+
+} // namespace yuki
@@ -1,10 +1,17 @@
 #include "aseprite_loader.hpp"
 #include "stb_image.h"
+#include "job_system.hpp"
 #include "log.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <fstream>
 #include <cstring>
 #include <cstdint>
 #include <cstdlib>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace yuki {
 namespace {
@@ -21,9 +28,418 @@ bool readPascalString(const unsigned char* data, size_t size, size_t& off, std::
     off += len;
     return true;
 }
+
+constexpr uint32_t kChunkOldPalette = 0x0004;
+constexpr uint32_t kChunkLayer = 0x2004;
+constexpr uint32_t kChunkCel = 0x2005;
+constexpr uint32_t kChunkTags = 0x2018;
+constexpr uint32_t kChunkPalette = 0x2019;
+constexpr uint32_t kChunkTileset = 0x2023;
+
+constexpr uint16_t kLayerVisible = 1;
+constexpr uint16_t kLayerBackground = 8;
+constexpr uint16_t kLayerReference = 64;
+constexpr uint16_t kLayerTypeGroup = 1;
+constexpr uint16_t kLayerTypeTilemap = 2;
+
+constexpr uint16_t kCelRaw = 0;
+constexpr uint16_t kCelLinked = 1;
+constexpr uint16_t kCelCompressed = 2;
+constexpr uint16_t kCelTilemap = 3;
+
+enum BlendMode {
+    BlendNormal = 0,
+    BlendMultiply = 1,
+    BlendScreen = 2,
+    BlendOverlay = 3,
+    BlendDarken = 4,
+    BlendLighten = 5,
+    BlendDifference = 10,
+    BlendAddition = 16,
+    BlendSubtract = 17,
+};
+
+struct Layer {
+    uint16_t flags = 0;
+    uint16_t type = 0;
+    uint16_t blend = BlendNormal;
+    uint8_t opacity = 255;
+    int tileset = -1;
+    bool visible = true;
+};
+
+// Points into the file buffer; pixels are decoded when the frame is composited.
+struct CelRef {
+    int layer = 0;
+    int x = 0;
+    int y = 0;
+    uint8_t opacity = 255;
+    uint16_t type = kCelRaw;
+    int16_t zIndex = 0;
+    const unsigned char* payload = nullptr;
+    size_t payloadSize = 0;
+};
+
+struct Tileset {
+    int tileW = 0;
+    int tileH = 0;
+    int count = 0;
+    std::vector<unsigned char> rgba; // tiles stacked vertically
+};
+
+struct Document {
+    int width = 0;
+    int height = 0;
+    int depth = 32;
+    int transparentIndex = 0;
+    std::array<uint32_t, 256> palette{}; // packed RGBA, little-endian byte order
+    std::vector<Layer> layers;
+    std::vector<std::vector<CelRef>> frameCels;
+    std::vector<std::pair<int, Tileset>> tilesets;
+};
+
+inline int mul255(int a, int b) {
+    int t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+bool inflate(const unsigned char* src, size_t srcSize, std::vector<unsigned char>& out, size_t expected) {
+    out.resize(expected);
+    if (expected == 0) return true;
+    int n = stbi_zlib_decode_buffer((char*)out.data(), (int)expected, (const char*)src, (int)srcSize);
+    return n >= 0 && (size_t)n >= expected;
 }
 
-bool loadAsepriteFile(const std::string& path, AseData& out) {
+// Converts `count` pixels of the document's color depth to RGBA.
+void toRGBA(const Document& doc, const unsigned char* src, size_t count, unsigned char* dst, bool transparentIndex) {
+    if (doc.depth == 32) {
+        std::memcpy(dst, src, count * 4);
+    } else if (doc.depth == 16) {
+        for (size_t i = 0; i < count; ++i) {
+            unsigned char v = src[i * 2];
+            dst[i * 4 + 0] = v;
+            dst[i * 4 + 1] = v;
+            dst[i * 4 + 2] = v;
+            dst[i * 4 + 3] = src[i * 2 + 1];
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            int idx = src[i];
+            uint32_t c = (transparentIndex && idx == doc.transparentIndex) ? 0u : doc.palette[(size_t)idx];
+            std::memcpy(dst + i * 4, &c, 4);
+        }
+    }
+}
+
+uint8_t blendChannel(int mode, int b, int s) {
+    switch (mode) {
+    case BlendMultiply: return (uint8_t)mul255(b, s);
+    case BlendScreen: return (uint8_t)(b + s - mul255(b, s));
+    case BlendOverlay: return (uint8_t)(b < 128 ? mul255(2 * b, s) : 255 - mul255(2 * (255 - b), 255 - s));
+    case BlendDarken: return (uint8_t)std::min(b, s);
+    case BlendLighten: return (uint8_t)std::max(b, s);
+    case BlendDifference: return (uint8_t)std::abs(b - s);
+    case BlendAddition: return (uint8_t)std::min(b + s, 255);
+    case BlendSubtract: return (uint8_t)std::max(b - s, 0);
+    default: return (uint8_t)s;
+    }
+}
+
+// Aseprite's normal blend for straight (non-premultiplied) alpha.
+inline void blendPixelNormal(unsigned char* d, const unsigned char* s, int opacity) {
+    int sa = mul255(s[3], opacity);
+    if (sa == 0) return;
+    int da = d[3];
+    if (da == 0) {
+        d[0] = s[0];
+        d[1] = s[1];
+        d[2] = s[2];
+        d[3] = (unsigned char)sa;
+        return;
+    }
+    int ra = sa + da - mul255(da, sa);
+    d[0] = (unsigned char)(d[0] + (s[0] - d[0]) * sa / ra);
+    d[1] = (unsigned char)(d[1] + (s[1] - d[1]) * sa / ra);
+    d[2] = (unsigned char)(d[2] + (s[2] - d[2]) * sa / ra);
+    d[3] = (unsigned char)ra;
+}
+
+void blendRowNormal(unsigned char* dst, const unsigned char* src, int n, int opacity) {
+    int i = 0;
+#if defined(__SSE2__)
+    // Four pixels at a time for the common cases: transparent source (skip),
+    // opaque source at full opacity (copy) and opaque destination, where the
+    // result alpha is 255 and the blend reduces to s*a + d*(255-a) / 255.
+    const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c128 = _mm_set1_epi16(128);
+    const __m128i c255 = _mm_set1_epi16(255);
+    const __m128i op = _mm_set1_epi16((short)opacity);
+    for (; i + 4 <= n; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i * 4));
+        __m128i sa = _mm_and_si128(s, alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(sa, zero)) == 0xFFFF) continue;
+        if (opacity == 255 && _mm_movemask_epi8(_mm_cmpeq_epi32(sa, alphaMask)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)(dst + i * 4), s);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(d, alphaMask), alphaMask)) != 0xFFFF) {
+            for (int k = 0; k < 4; ++k) blendPixelNormal(dst + (i + k) * 4, src + (i + k) * 4, opacity);
+            continue;
+        }
+        __m128i result[2];
+        for (int half = 0; half < 2; ++half) {
+            __m128i s16 = half == 0 ? _mm_unpacklo_epi8(s, zero) : _mm_unpackhi_epi8(s, zero);
+            __m128i d16 = half == 0 ? _mm_unpacklo_epi8(d, zero) : _mm_unpackhi_epi8(d, zero);
+            __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s16, 0xFF), 0xFF);
+            __m128i t = _mm_add_epi16(_mm_mullo_epi16(a, op), c128);
+            a = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+            __m128i x = _mm_add_epi16(_mm_mullo_epi16(s16, a), _mm_mullo_epi16(d16, _mm_sub_epi16(c255, a)));
+            x = _mm_add_epi16(x, c128);
+            result[half] = _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+        }
+        __m128i packed = _mm_or_si128(_mm_packus_epi16(result[0], result[1]), alphaMask);
+        _mm_storeu_si128((__m128i*)(dst + i * 4), packed);
+    }
+#endif
+    for (; i < n; ++i) blendPixelNormal(dst + i * 4, src + i * 4, opacity);
+}
+
+void blendRow(unsigned char* dst, const unsigned char* src, int n, int opacity, int mode) {
+    if (mode == BlendNormal) {
+        blendRowNormal(dst, src, n, opacity);
+        return;
+    }
+    // Separable modes: mix the colors, then composite normally with the source alpha.
+    unsigned char mixed[4];
+    for (int i = 0; i < n; ++i) {
+        const unsigned char* s = src + i * 4;
+        unsigned char* d = dst + i * 4;
+        if (d[3] == 0) {
+            blendPixelNormal(d, s, opacity);
+            continue;
+        }
+        mixed[0] = blendChannel(mode, d[0], s[0]);
+        mixed[1] = blendChannel(mode, d[1], s[1]);
+        mixed[2] = blendChannel(mode, d[2], s[2]);
+        mixed[3] = s[3];
+        blendPixelNormal(d, mixed, opacity);
+    }
+}
+
+// Composites a w*h RGBA image at (x, y), clipped to the canvas.
+void blendImage(const Document& doc, std::vector<unsigned char>& canvas, const unsigned char* img, int w, int h, int x, int y, int opacity, int mode) {
+    int x0 = std::max(0, x);
+    int x1 = std::min(doc.width, x + w);
+    if (x0 >= x1) return;
+    for (int iy = 0; iy < h; ++iy) {
+        int cy = y + iy;
+        if (cy < 0 || cy >= doc.height) continue;
+        unsigned char* dst = canvas.data() + ((size_t)cy * doc.width + x0) * 4;
+        const unsigned char* src = img + ((size_t)iy * w + (x0 - x)) * 4;
+        blendRow(dst, src, x1 - x0, opacity, mode);
+    }
+}
+
+const Tileset* findTileset(const Document& doc, int id) {
+    for (const auto& ts : doc.tilesets) {
+        if (ts.first == id) return &ts.second;
+    }
+    return nullptr;
+}
+
+// Decodes a cel into an RGBA image. Returns false on malformed data.
+bool decodeCel(const Document& doc, const Layer& layer, const CelRef& cel, std::vector<unsigned char>& scratch, std::vector<unsigned char>& rgba, int& w, int& h) {
+    const unsigned char* p = cel.payload;
+    size_t size = cel.payloadSize;
+    bool transparentIndex = !(layer.flags & kLayerBackground);
+    if (cel.type == kCelRaw || cel.type == kCelCompressed) {
+        if (size < 4) return false;
+        w = rd16(p);
+        h = rd16(p + 2);
+        size_t count = (size_t)w * (size_t)h;
+        size_t bytes = count * (size_t)(doc.depth / 8);
+        const unsigned char* pixels = p + 4;
+        if (cel.type == kCelRaw) {
+            if (size - 4 < bytes) return false;
+        } else {
+            if (!inflate(p + 4, size - 4, scratch, bytes)) return false;
+            pixels = scratch.data();
+        }
+        rgba.resize(count * 4);
+        toRGBA(doc, pixels, count, rgba.data(), transparentIndex);
+        return true;
+    }
+    if (cel.type == kCelTilemap) {
+        if (size < 32) return false;
+        int tilesW = rd16(p);
+        int tilesH = rd16(p + 2);
+        int bitsPerTile = rd16(p + 4);
+        uint32_t idMask = rd32(p + 6);
+        uint32_t xFlip = rd32(p + 10);
+        uint32_t yFlip = rd32(p + 14);
+        uint32_t dFlip = rd32(p + 18);
+        const Tileset* ts = findTileset(doc, layer.tileset);
+        if (!ts || bitsPerTile != 32) return false;
+        size_t tileCount = (size_t)tilesW * (size_t)tilesH;
+        if (!inflate(p + 32, size - 32, scratch, tileCount * 4)) return false;
+        w = tilesW * ts->tileW;
+        h = tilesH * ts->tileH;
+        rgba.assign((size_t)w * (size_t)h * 4, 0);
+        for (int ty = 0; ty < tilesH; ++ty) {
+            for (int tx = 0; tx < tilesW; ++tx) {
+                uint32_t raw = rd32(scratch.data() + ((size_t)ty * tilesW + tx) * 4);
+                int id = (int)(raw & idMask);
+                if (id <= 0 || id >= ts->count) continue;
+                bool fx = (raw & xFlip) != 0;
+                bool fy = (raw & yFlip) != 0;
+                bool fd = (raw & dFlip) != 0;
+                const unsigned char* tile = ts->rgba.data() + (size_t)id * ts->tileW * ts->tileH * 4;
+                for (int py = 0; py < ts->tileH; ++py) {
+                    for (int px = 0; px < ts->tileW; ++px) {
+                        int sx = px, sy = py;
+                        if (fd) std::swap(sx, sy);
+                        if (fx) sx = ts->tileW - 1 - sx;
+                        if (fy) sy = ts->tileH - 1 - sy;
+                        if (sx >= ts->tileW || sy >= ts->tileH) continue;
+                        size_t dst = ((size_t)(ty * ts->tileH + py) * w + (size_t)(tx * ts->tileW + px)) * 4;
+                        std::memcpy(rgba.data() + dst, tile + ((size_t)sy * ts->tileW + sx) * 4, 4);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool compositeFrame(const Document& doc, size_t frameIndex, std::vector<unsigned char>& canvas) {
+    canvas.assign((size_t)doc.width * (size_t)doc.height * 4, 0);
+    std::vector<CelRef> cels;
+    cels.reserve(doc.frameCels[frameIndex].size());
+    for (const CelRef& ref : doc.frameCels[frameIndex]) {
+        if (ref.layer < 0 || ref.layer >= (int)doc.layers.size()) continue;
+        const Layer& layer = doc.layers[(size_t)ref.layer];
+        if (!layer.visible || layer.type == kLayerTypeGroup) continue;
+        if (ref.type != kCelLinked) {
+            cels.push_back(ref);
+            continue;
+        }
+        // Linked cels reuse another frame's cel on the same layer, keeping
+        // their own position, opacity and z-index.
+        if (ref.payloadSize < 2) continue;
+        size_t linked = rd16(ref.payload);
+        if (linked >= doc.frameCels.size()) continue;
+        for (const CelRef& src : doc.frameCels[linked]) {
+            if (src.layer != ref.layer || src.type == kCelLinked) continue;
+            CelRef resolved = src;
+            resolved.x = ref.x;
+            resolved.y = ref.y;
+            resolved.opacity = ref.opacity;
+            resolved.zIndex = ref.zIndex;
+            cels.push_back(resolved);
+            break;
+        }
+    }
+    std::stable_sort(cels.begin(), cels.end(), [](const CelRef& a, const CelRef& b) {
+        int oa = a.layer + a.zIndex;
+        int ob = b.layer + b.zIndex;
+        if (oa != ob) return oa < ob;
+        return a.zIndex < b.zIndex;
+    });
+    std::vector<unsigned char> scratch;
+    std::vector<unsigned char> rgba;
+    for (const CelRef& cel : cels) {
+        const Layer& layer = doc.layers[(size_t)cel.layer];
+        int w = 0, h = 0;
+        if (!decodeCel(doc, layer, cel, scratch, rgba, w, h)) return false;
+        int opacity = mul255(cel.opacity, layer.opacity);
+        blendImage(doc, canvas, rgba.data(), w, h, cel.x, cel.y, opacity, layer.blend);
+    }
+    return true;
+}
+
+bool readLayer(const unsigned char* p, size_t size, bool opacityValid, Layer& out, int& childLevel) {
+    if (size < 16) return false;
+    out.flags = rd16(p);
+    out.type = rd16(p + 2);
+    childLevel = rd16(p + 4);
+    out.blend = rd16(p + 10);
+    out.opacity = opacityValid ? p[12] : 255;
+    size_t off = 16;
+    std::string name;
+    if (!readPascalString(p, size, off, name)) return false;
+    if (out.type == kLayerTypeTilemap) {
+        if (off + 4 > size) return false;
+        out.tileset = (int)rd32(p + off);
+    }
+    return true;
+}
+
+bool readTileset(const Document& doc, const unsigned char* p, size_t size, int& id, Tileset& out) {
+    if (size < 32) return false;
+    id = (int)rd32(p);
+    uint32_t flags = rd32(p + 4);
+    out.count = (int)rd32(p + 8);
+    out.tileW = rd16(p + 12);
+    out.tileH = rd16(p + 14);
+    size_t off = 32;
+    std::string name;
+    if (!readPascalString(p, size, off, name)) return false;
+    if (flags & 1) off += 8;
+    size_t pixels = (size_t)out.tileW * out.tileH * (size_t)out.count;
+    out.rgba.assign(pixels * 4, 0);
+    if (!(flags & 2)) return true;
+    if (off + 4 > size) return false;
+    uint32_t dataLen = rd32(p + off);
+    off += 4;
+    if (off + dataLen > size) return false;
+    std::vector<unsigned char> raw;
+    if (!inflate(p + off, dataLen, raw, pixels * (size_t)(doc.depth / 8))) return false;
+    toRGBA(doc, raw.data(), pixels, out.rgba.data(), true);
+    return true;
+}
+
+void readPalette(Document& doc, const unsigned char* p, size_t size) {
+    if (size < 20) return;
+    uint32_t first = rd32(p + 4);
+    uint32_t last = rd32(p + 8);
+    size_t off = 20;
+    for (uint32_t i = first; i <= last && i < 256; ++i) {
+        if (off + 6 > size) return;
+        uint16_t flags = rd16(p + off);
+        unsigned char rgba[4] = {p[off + 2], p[off + 3], p[off + 4], p[off + 5]};
+        off += 6;
+        std::memcpy(&doc.palette[i], rgba, 4);
+        if (flags & 1) {
+            std::string name;
+            if (!readPascalString(p, size, off, name)) return;
+        }
+    }
+}
+
+void readOldPalette(Document& doc, const unsigned char* p, size_t size) {
+    if (size < 2) return;
+    int packets = rd16(p);
+    size_t off = 2;
+    size_t index = 0;
+    for (int k = 0; k < packets; ++k) {
+        if (off + 2 > size) return;
+        index += p[off];
+        size_t count = p[off + 1] == 0 ? 256 : p[off + 1];
+        off += 2;
+        for (size_t c = 0; c < count; ++c, ++index) {
+            if (off + 3 > size || index >= 256) return;
+            unsigned char rgba[4] = {p[off], p[off + 1], p[off + 2], 255};
+            std::memcpy(&doc.palette[index], rgba, 4);
+            off += 3;
+        }
+    }
+}
+} // namespace
+
+bool loadAsepriteFile(const std::string& path, AseData& out, JobSystem& jobs) {
     std::ifstream file(path, std::ios::binary);
     if (!file) return false;
     std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
@@ -31,119 +447,108 @@ bool loadAsepriteFile(const std::string& path, AseData& out) {
     uint16_t magic = rd16(bytes.data() + 4);
     if (magic != 0xA5E0) return false;
     uint16_t frameCount = rd16(bytes.data() + 6);
-    uint16_t w = rd16(bytes.data() + 8);
-    uint16_t h = rd16(bytes.data() + 10);
-    uint16_t colorDepth = rd16(bytes.data() + 12);
-    if (colorDepth != 32) return false;
-    out.width = w;
-    out.height = h;
+    Document doc;
+    doc.width = rd16(bytes.data() + 8);
+    doc.height = rd16(bytes.data() + 10);
+    doc.depth = rd16(bytes.data() + 12);
+    uint32_t headerFlags = rd32(bytes.data() + 14);
+    doc.transparentIndex = bytes[28];
+    if (doc.depth != 32 && doc.depth != 16 && doc.depth != 8) {
+        logError("ase: unsupported color depth " + std::to_string(doc.depth) + " in " + path);
+        return false;
+    }
+    out.width = doc.width;
+    out.height = doc.height;
     out.frames.resize(frameCount);
     out.durationsMs.resize(frameCount);
+    doc.frameCels.resize(frameCount);
+
+    // Pass 1 (serial): walk the chunks, collect layers, palette, tilesets,
+    // tags and cel references. Pixel data is left in place.
+    std::vector<bool> visibleAtLevel;
+    bool hasNewPalette = false;
     size_t offset = 128;
     for (int fi = 0; fi < frameCount; ++fi) {
         if (offset + 16 > bytes.size()) return false;
         uint32_t frameBytes = rd32(bytes.data() + offset);
         uint16_t frameMagic = rd16(bytes.data() + offset + 4);
-        uint16_t chunkCount = rd16(bytes.data() + offset + 6);
+        uint32_t chunkCount = rd16(bytes.data() + offset + 6);
         uint16_t duration = rd16(bytes.data() + offset + 8);
+        uint32_t newChunkCount = rd32(bytes.data() + offset + 12);
         size_t frameStart = offset;
         offset += 16;
-        out.durationsMs[fi] = (int)duration;
-        if (chunkCount == 0xFFFF) {
-            if (offset + 4 > bytes.size()) return false;
-            chunkCount = rd32(bytes.data() + offset);
-            offset += 4;
-        }
         if (frameMagic != 0xF1FA) return false;
-        std::vector<unsigned char> canvas((size_t)w * (size_t)h * 4, 0);
-        for (int ci = 0; ci < chunkCount; ++ci) {
+        if (newChunkCount != 0) chunkCount = newChunkCount;
+        out.durationsMs[fi] = (int)duration;
+        for (uint32_t ci = 0; ci < chunkCount; ++ci) {
             if (offset + 6 > bytes.size()) return false;
             uint32_t chunkSize = rd32(bytes.data() + offset);
             uint16_t chunkType = rd16(bytes.data() + offset + 4);
             size_t chunkStart = offset;
-            offset += 6;
-            if (chunkStart + chunkSize > bytes.size()) return false;
-            if (chunkType == 0x2018) {
-                if (offset + 10 > bytes.size()) return false;
-                uint16_t tagCount = rd16(bytes.data() + offset);
-                offset += 2 + 8;
+            if (chunkSize < 6 || chunkStart + chunkSize > bytes.size()) return false;
+            const unsigned char* body = bytes.data() + chunkStart + 6;
+            size_t bodySize = chunkSize - 6;
+            if (chunkType == kChunkLayer) {
+                Layer layer;
+                int level = 0;
+                if (!readLayer(body, bodySize, (headerFlags & 1) != 0, layer, level)) return false;
+                bool parentVisible = level == 0 || (level - 1 < (int)visibleAtLevel.size() && visibleAtLevel[(size_t)level - 1]);
+                layer.visible = (layer.flags & kLayerVisible) && !(layer.flags & kLayerReference) && parentVisible;
+                visibleAtLevel.resize((size_t)level + 1);
+                visibleAtLevel[(size_t)level] = layer.visible;
+                doc.layers.push_back(layer);
+            } else if (chunkType == kChunkCel) {
+                if (bodySize < 16) return false;
+                CelRef cel;
+                cel.layer = rd16(body);
+                cel.x = rds16(body + 2);
+                cel.y = rds16(body + 4);
+                cel.opacity = body[6];
+                cel.type = rd16(body + 7);
+                cel.zIndex = rds16(body + 9);
+                cel.payload = body + 16;
+                cel.payloadSize = bodySize - 16;
+                doc.frameCels[(size_t)fi].push_back(cel);
+            } else if (chunkType == kChunkPalette) {
+                readPalette(doc, body, bodySize);
+                hasNewPalette = true;
+            } else if (chunkType == kChunkOldPalette) {
+                if (!hasNewPalette) readOldPalette(doc, body, bodySize);
+            } else if (chunkType == kChunkTileset) {
+                int id = 0;
+                Tileset ts;
+                if (!readTileset(doc, body, bodySize, id, ts)) return false;
+                doc.tilesets.emplace_back(id, std::move(ts));
+            } else if (chunkType == kChunkTags) {
+                if (bodySize < 10) return false;
+                uint16_t tagCount = rd16(body);
+                size_t off = 10;
                 for (int ti = 0; ti < tagCount; ++ti) {
-                    if (offset + 17 > bytes.size()) return false;
-                    uint16_t from = rd16(bytes.data() + offset);
-                    uint16_t to = rd16(bytes.data() + offset + 2);
-                    uint8_t direction = bytes[offset + 4];
-                    offset += 17;
-                    std::string name;
-                    if (!readPascalString(bytes.data(), bytes.size(), offset, name)) return false;
+                    if (off + 17 > bodySize) return false;
                     AseTag tag;
-                    tag.name = name;
-                    tag.from = from;
-                    tag.to = to;
-                    tag.direction = direction;
+                    tag.from = rd16(body + off);
+                    tag.to = rd16(body + off + 2);
+                    tag.direction = body[off + 4];
+                    off += 17;
+                    if (!readPascalString(body, bodySize, off, tag.name)) return false;
                     out.tags.push_back(tag);
                 }
-                offset = chunkStart + chunkSize;
-            } else if (chunkType == 0x2005) {
-                if (offset + 16 > bytes.size()) return false;
-                uint16_t layerIndex = rd16(bytes.data() + offset);
-                int16_t cx = rds16(bytes.data() + offset + 2);
-                int16_t cy = rds16(bytes.data() + offset + 4);
-                uint8_t opacity = bytes[offset + 6];
-                uint16_t celType = rd16(bytes.data() + offset + 7);
-                offset += 16;
-                (void)layerIndex;
-                if (celType == 0 || celType == 2) {
-                    if (offset + 4 > bytes.size()) return false;
-                    uint16_t cw = rd16(bytes.data() + offset);
-                    uint16_t ch = rd16(bytes.data() + offset + 2);
-                    offset += 4;
-                    size_t pixCount = (size_t)cw * (size_t)ch * 4;
-                    std::vector<unsigned char> celPixels;
-                    if (celType == 0) {
-                        if (offset + pixCount > bytes.size()) return false;
-                        celPixels.assign(bytes.begin() + offset, bytes.begin() + offset + pixCount);
-                        offset += pixCount;
-                    } else {
-                        size_t compSize = chunkStart + chunkSize - offset;
-                        int outLen = 0;
-                        char* raw = stbi_zlib_decode_malloc((const char*)(bytes.data() + offset), (int)compSize, &outLen);
-                        if (!raw) return false;
-                        celPixels.assign((unsigned char*)raw, (unsigned char*)raw + outLen);
-                        free(raw);
-                        offset += compSize;
-                        if (celPixels.size() < pixCount) return false;
-                    }
-                    for (uint16_t iy = 0; iy < ch; ++iy) {
-                        for (uint16_t ix = 0; ix < cw; ++ix) {
-                            size_t src = ((size_t)iy * cw + ix) * 4;
-                            int dstx = cx + ix;
-                            int dsty = cy + iy;
-                            if (dstx < 0 || dsty < 0 || dstx >= w || dsty >= h) continue;
-                            size_t dst = ((size_t)dsty * w + dstx) * 4;
-                            unsigned char r = celPixels[src + 0];
-                            unsigned char g = celPixels[src + 1];
-                            unsigned char b = celPixels[src + 2];
-                            unsigned char a = (unsigned char)((celPixels[src + 3] * opacity) / 255);
-                            float af = a / 255.0f;
-                            float inv = 1.0f - af;
-                            canvas[dst + 0] = (unsigned char)(r * af + canvas[dst + 0] * inv);
-                            canvas[dst + 1] = (unsigned char)(g * af + canvas[dst + 1] * inv);
-                            canvas[dst + 2] = (unsigned char)(b * af + canvas[dst + 2] * inv);
-                            canvas[dst + 3] = (unsigned char)(a + canvas[dst + 3] * inv);
-                        }
-                    }
-                } else if (celType == 1) {
-                    offset += 2;
-                }
-                offset = chunkStart + chunkSize;
-            } else {
-                offset = chunkStart + chunkSize;
             }
+            offset = chunkStart + chunkSize;
         }
-        out.frames[fi] = std::move(canvas);
         offset = frameStart + frameBytes;
         if (offset > bytes.size()) return false;
     }
+
+    // Pass 2 (parallel): decode and composite each frame independently.
+    std::atomic<bool> failed{false};
+    jobs.parallelFor(frameCount, 1, [&](size_t begin, size_t end) {
+        for (size_t fi = begin; fi < end; ++fi) {
+            if (!compositeFrame(doc, fi, out.frames[fi])) failed.store(true, std::memory_order_relaxed);
+        }
+    });
+    if (failed.load()) return false;
+
     if (out.tags.empty()) {
         AseTag t;
         t.name = "default";
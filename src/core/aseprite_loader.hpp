@@ -4,6 +4,8 @@
 #include <unordered_map>
 
 namespace yuki {
+class JobSystem;
+
 struct AseTag {
     std::string name;
     int from = 0;
@@ -19,5 +21,8 @@ struct AseData {
     std::vector<AseTag> tags;
 };
 
-bool loadAsepriteFile(const std::string& path, AseData& out);
+// Frames are decoded and composited in parallel on `jobs`: jobSystem() for
+// loads the main thread waits on, assetJobSystem() for background decodes so
+// their frame tasks never land in the main thread's queue.
+bool loadAsepriteFile(const std::string& path, AseData& out, JobSystem& jobs);
 }
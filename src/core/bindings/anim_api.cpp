@@ -2,15 +2,174 @@
 #include "state.hpp"
 #include "value_utils.hpp"
 #include "../renderer2d.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace yuki {
 namespace {
 BindingsState& st = bindingsState();
 
 Animation* getAnimation(int id) {
-    auto it = st.animations.find(id);
-    if (it == st.animations.end()) return nullptr;
-    return &it->second;
+    return st.animations.get(id);
+}
+
+double frameEndAt(const Animation& a, int i) {
+    return a.frameEnd.empty() ? (double)(i + 1) / a.fps : a.frameEnd[(size_t)i];
+}
+// Smallest i with end(i) > t (forward playback).
+int frameAfter(const Animation& a, double t) {
+    int n = (int)a.frames.size();
+    int i;
+    if (a.frameEnd.empty()) i = (int)std::floor(t * a.fps);
+    else i = (int)(std::upper_bound(a.frameEnd.begin(), a.frameEnd.end(), t) - a.frameEnd.begin());
+    return std::clamp(i, 0, n - 1);
+}
+// Smallest i with end(i) >= t (backward playback: t counts down from the end).
+int frameAtOrBefore(const Animation& a, double t) {
+    int n = (int)a.frames.size();
+    int i;
+    if (a.frameEnd.empty()) i = (int)std::ceil(t * a.fps) - 1;
+    else i = (int)(std::lower_bound(a.frameEnd.begin(), a.frameEnd.end(), t) - a.frameEnd.begin());
+    return std::clamp(i, 0, n - 1);
+}
+// One pass through the clip. Ping-pong plays 0..n-1 then n-2..1.
+double cycleLength(const Animation& a) {
+    int n = (int)a.frames.size();
+    if (n == 0 || (a.frameEnd.empty() && a.fps <= 0.0)) return 0.0;
+    double length = frameEndAt(a, n - 1);
+    if (a.direction == AnimDirection::PingPong && n > 2) length += frameEndAt(a, n - 2) - frameEndAt(a, 0);
+    return length;
+}
+int frameAtTime(const Animation& a, double t) {
+    int n = (int)a.frames.size();
+    // No timing (fps <= 0 without durations): the clip holds its first frame.
+    if (a.frameEnd.empty() && a.fps <= 0.0) return a.direction == AnimDirection::Reverse ? n - 1 : 0;
+    double length = frameEndAt(a, n - 1);
+    switch (a.direction) {
+    case AnimDirection::Forward: return frameAfter(a, t);
+    case AnimDirection::Reverse: return frameAtOrBefore(a, length - t);
+    case AnimDirection::PingPong:
+        if (t < length || n <= 2) return frameAfter(a, t);
+        return frameAtOrBefore(a, frameEndAt(a, n - 2) - (t - length));
+    }
+    return 0;
+}
+int lastFrameIndex(const Animation& a) {
+    int n = (int)a.frames.size();
+    if (a.direction == AnimDirection::Reverse) return 0;
+    if (a.direction == AnimDirection::PingPong && n > 2) return 1;
+    return n - 1;
+}
+std::vector<double> durationsToFrameEnd(const std::vector<Value>& durationsMs) {
+    std::vector<double> frameEnd;
+    frameEnd.reserve(durationsMs.size());
+    double total = 0.0;
+    for (const auto& v : durationsMs) {
+        double ms = v.isNumber() && v.numberVal > 0.0 ? v.numberVal : 100.0;
+        total += ms / 1000.0;
+        frameEnd.push_back(total);
+    }
+    return frameEnd;
+}
+bool parseDirection(const std::string& name, AnimDirection& out) {
+    if (name == "forward") out = AnimDirection::Forward;
+    else if (name == "reverse") out = AnimDirection::Reverse;
+    else if (name == "pingpong" || name == "ping_pong") out = AnimDirection::PingPong;
+    else return false;
+    return true;
+}
+
+Animator* getAnimator(const Value& v) {
+    if (!v.isNumber()) return nullptr;
+    return st.animators.get((int)v.numberVal);
+}
+int findParam(Animator& a, const std::string& name, bool create) {
+    for (size_t i = 0; i < a.paramNames.size(); ++i) {
+        if (a.paramNames[i] == name) return (int)i;
+    }
+    if (!create) return -1;
+    a.paramNames.push_back(name);
+    a.params.push_back(0.0);
+    return (int)a.paramNames.size() - 1;
+}
+int findState(const Animator& a, const std::string& name) {
+    for (size_t i = 0; i < a.states.size(); ++i) {
+        if (a.states[i].name == name) return (int)i;
+    }
+    return -1;
+}
+bool parseConditionOp(const std::string& op, AnimatorCondition::Op& out) {
+    if (op == ">") out = AnimatorCondition::Op::Greater;
+    else if (op == "<") out = AnimatorCondition::Op::Less;
+    else if (op == ">=") out = AnimatorCondition::Op::GreaterEqual;
+    else if (op == "<=") out = AnimatorCondition::Op::LessEqual;
+    else if (op == "==") out = AnimatorCondition::Op::Equal;
+    else if (op == "!=") out = AnimatorCondition::Op::NotEqual;
+    else return false;
+    return true;
+}
+bool conditionHolds(const Animator& a, const AnimatorCondition& c) {
+    double v = a.params[(size_t)c.param];
+    switch (c.op) {
+    case AnimatorCondition::Op::Greater: return v > c.value;
+    case AnimatorCondition::Op::Less: return v < c.value;
+    case AnimatorCondition::Op::GreaterEqual: return v >= c.value;
+    case AnimatorCondition::Op::LessEqual: return v <= c.value;
+    case AnimatorCondition::Op::Equal: return v == c.value;
+    case AnimatorCondition::Op::NotEqual: return v != c.value;
+    }
+    return false;
+}
+void enterState(Animator& a, Animation& anim, int index) {
+    const AnimatorState& s = a.states[(size_t)index];
+    a.current = index;
+    a.stateTime = 0.0;
+    anim.sheetId = s.sheetId;
+    anim.frames = s.frames;
+    anim.frameEnd = s.frameEnd;
+    anim.direction = s.direction;
+    anim.fps = s.fps;
+    anim.loop = s.loop;
+    restartAnimation(anim);
+    anim.playing = true;
+}
+// The first state added becomes the entry state right away so the animation
+// has frames before the next tick.
+int addState(Animator& a, AnimatorState state) {
+    int idx = findState(a, state.name);
+    if (idx >= 0) {
+        a.states[(size_t)idx] = std::move(state);
+    } else {
+        a.states.push_back(std::move(state));
+        idx = (int)a.states.size() - 1;
+    }
+    if (a.current < 0 || a.current == idx) {
+        if (Animation* anim = st.animations.get(a.animId)) enterState(a, *anim, idx);
+    }
+    return idx;
+}
+void evaluateAnimator(Animator& a, double dt) {
+    Animation* anim = st.animations.get(a.animId);
+    if (!anim || a.states.empty()) return;
+    if (a.current < 0 || a.current >= (int)a.states.size()) {
+        enterState(a, *anim, 0);
+        return;
+    }
+    double clipLength = cycleLength(*anim);
+    double normalized = clipLength > 0.0 ? a.stateTime / clipLength : 1.0;
+    for (const auto& t : a.transitions) {
+        if (t.to == a.current) continue;
+        if (t.from >= 0 && t.from != a.current) continue;
+        if (t.exitTime >= 0.0 && normalized < t.exitTime) continue;
+        bool ok = true;
+        for (const auto& c : t.conditions) {
+            if (!conditionHolds(a, c)) { ok = false; break; }
+        }
+        if (!ok) continue;
+        enterState(a, *anim, t.to);
+        return;
+    }
+    a.stateTime += dt;
 }
 } // namespace
 
@@ -28,13 +187,17 @@ Value apiAnimCreate(const std::vector<Value>& args) {
     bool loop = valueToBool(args[3]);
 
     Animation anim;
-    anim.id = st.animationCounter++;
     anim.sheetId = sheetId;
-    anim.frames = frames;
+    anim.frames = std::move(frames);
     anim.fps = fps;
     anim.loop = loop;
-    st.animations[anim.id] = anim;
-    return Value::number(anim.id);
+    int id = st.animations.insert(std::move(anim));
+    if (Animation* stored = st.animations.get(id)) stored->id = id;
+    return Value::number(id);
+}
+Value apiAnimDestroy(const std::vector<Value>& args) {
+    if (args.empty() || !args[0].isNumber()) return Value::boolean(false);
+    return Value::boolean(st.animations.erase((int)args[0].numberVal));
 }
 Value apiAnimPlay(const std::vector<Value>& args) {
     if (args.size() < 1) return Value::nilVal();
@@ -43,8 +206,7 @@ Value apiAnimPlay(const std::vector<Value>& args) {
     auto* anim = getAnimation(id);
     if (!anim) return Value::nilVal();
     if (reset) {
-        anim->currentIndex = 0;
-        anim->accumulator = 0.0;
+        restartAnimation(*anim);
     } else if (!anim->frames.empty() && anim->currentIndex >= (int)anim->frames.size()) {
         anim->currentIndex %= (int)anim->frames.size();
     }
@@ -60,10 +222,7 @@ Value apiAnimStop(const std::vector<Value>& args) {
 Value apiAnimReset(const std::vector<Value>& args) {
     if (args.empty()) return Value::nilVal();
     auto* anim = getAnimation((int)args[0].numberVal);
-    if (anim) {
-        anim->currentIndex = 0;
-        anim->accumulator = 0.0;
-    }
+    if (anim) restartAnimation(*anim);
     return Value::nilVal();
 }
 Value apiAnimSetPosition(const std::vector<Value>& args) {
@@ -119,13 +278,48 @@ Value apiAnimSetAlpha(const std::vector<Value>& args) {
 Value apiAnimDraw(const std::vector<Value>& args) {
     if (args.size() < 1 || !st.renderer) return Value::nilVal();
     auto* anim = getAnimation((int)args[0].numberVal);
-    if (!anim || anim->sheetId < 0) return Value::nilVal();
-    if (anim->frames.empty()) return Value::nilVal();
-    int frame = anim->frames[anim->currentIndex % (int)anim->frames.size()];
-    st.renderer->drawSpriteFrame(anim->sheetId, frame, anim->transform.x, anim->transform.y, anim->transform.rotationDeg, anim->transform.scaleX, anim->transform.scaleY, anim->transform.flipX, anim->transform.flipY, anim->transform.originX, anim->transform.originY, anim->alpha);
+    if (anim) drawAnimation(*anim);
     return Value::nilVal();
 }
 
+// anim_set_durations(anim_id, ms_array): one entry per frame; nil clears back to 1/fps.
+Value apiAnimSetDurations(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::boolean(false);
+    auto* anim = getAnimation((int)args[0].numberVal);
+    if (!anim) return Value::boolean(false);
+    if (args[1].isNil()) {
+        anim->frameEnd.clear();
+        return Value::boolean(true);
+    }
+    if (!args[1].isArray() || !args[1].arrayPtr || args[1].arrayPtr->size() != anim->frames.size()) return Value::boolean(false);
+    anim->frameEnd = durationsToFrameEnd(*args[1].arrayPtr);
+    double t = anim->accumulator;
+    double length = cycleLength(*anim);
+    anim->accumulator = length > 0.0 ? std::fmod(t, length) : 0.0;
+    if (!anim->frames.empty()) anim->currentIndex = frameAtTime(*anim, anim->accumulator);
+    return Value::boolean(true);
+}
+Value apiAnimSetDirection(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::boolean(false);
+    auto* anim = getAnimation((int)args[0].numberVal);
+    AnimDirection dir;
+    if (!anim || !parseDirection(args[1].toString(), dir)) return Value::boolean(false);
+    anim->direction = dir;
+    restartAnimation(*anim);
+    return Value::boolean(true);
+}
+
+void restartAnimation(Animation& anim) {
+    anim.accumulator = 0.0;
+    anim.currentIndex = anim.frames.empty() ? 0 : frameAtTime(anim, 0.0);
+}
+
+void drawAnimation(const Animation& anim) {
+    if (!st.renderer || anim.sheetId < 0 || anim.frames.empty()) return;
+    int frame = anim.frames[anim.currentIndex % (int)anim.frames.size()];
+    st.renderer->drawSpriteFrame(anim.sheetId, frame, anim.transform.x, anim.transform.y, anim.transform.rotationDeg, anim.transform.scaleX, anim.transform.scaleY, anim.transform.flipX, anim.transform.flipY, anim.transform.originX, anim.transform.originY, anim.alpha);
+}
+
 Value apiAnimGetPosition(const std::vector<Value>& args) {
     if (args.empty()) return Value::map({});
     auto* anim = getAnimation((int)args[0].numberVal);
@@ -160,21 +354,152 @@ Value apiAnimGetAlpha(const std::vector<Value>& args) {
     return Value::number(anim->alpha);
 }
 
+Value apiAnimatorCreate(const std::vector<Value>& args) {
+    Animator a;
+    if (!args.empty() && args[0].isNumber()) {
+        if (!st.animations.contains((int)args[0].numberVal)) return Value::number(-1);
+        a.animId = (int)args[0].numberVal;
+    } else {
+        a.animId = st.animations.insert(Animation{});
+        if (Animation* anim = st.animations.get(a.animId)) anim->id = a.animId;
+    }
+    int id = st.animators.insert(std::move(a));
+    if (Animator* stored = st.animators.get(id)) stored->id = id;
+    return Value::number(id);
+}
+Value apiAnimatorDestroy(const std::vector<Value>& args) {
+    if (args.empty() || !args[0].isNumber()) return Value::boolean(false);
+    return Value::boolean(st.animators.erase((int)args[0].numberVal));
+}
+Value apiAnimatorAnim(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(-1);
+    auto* a = getAnimator(args[0]);
+    return Value::number(a ? a->animId : -1);
+}
+Value apiAnimatorAddState(const std::vector<Value>& args) {
+    if (args.size() < 4) return Value::number(-1);
+    auto* a = getAnimator(args[0]);
+    if (!a) return Value::number(-1);
+    auto it = st.aseAssets.find((int)args[2].numberVal);
+    if (it == st.aseAssets.end()) return Value::number(-1);
+    const auto& asset = it->second;
+    std::string tag = args[3].toString();
+    auto fit = asset.tagFrames.find(tag);
+    if (fit == asset.tagFrames.end()) return Value::number(-1);
+    AnimatorState s;
+    s.name = args[1].toString();
+    s.sheetId = asset.sheetId;
+    s.frames = fit->second;
+    s.loop = args.size() > 4 ? valueToBool(args[4], true) : true;
+    double fpsOverride = args.size() > 5 && args[5].isNumber() ? args[5].numberVal : -1.0;
+    s.fps = fpsOverride > 0.0 ? fpsOverride : asset.tagFps.at(tag);
+    s.direction = asset.tagDirection.at(tag);
+    if (fpsOverride <= 0.0) s.frameEnd = asset.tagFrameEnd.at(tag);
+    return Value::number(addState(*a, std::move(s)));
+}
+Value apiAnimatorAddClip(const std::vector<Value>& args) {
+    if (args.size() < 5) return Value::number(-1);
+    auto* a = getAnimator(args[0]);
+    if (!a) return Value::number(-1);
+    AnimatorState s;
+    s.name = args[1].toString();
+    s.sheetId = (int)args[2].numberVal;
+    if (args[3].isArray() && args[3].arrayPtr) {
+        for (const auto& item : *args[3].arrayPtr) {
+            if (item.isNumber()) s.frames.push_back((int)item.numberVal);
+        }
+    }
+    s.fps = args[4].numberVal;
+    s.loop = args.size() > 5 ? valueToBool(args[5], true) : true;
+    return Value::number(addState(*a, std::move(s)));
+}
+// animator_add_transition(animator, from, to, conditions, exit_time)
+// from may be "*" for any state; conditions is [[param, op, value], ...].
+Value apiAnimatorAddTransition(const std::vector<Value>& args) {
+    if (args.size() < 3) return Value::boolean(false);
+    auto* a = getAnimator(args[0]);
+    if (!a) return Value::boolean(false);
+    AnimatorTransition t;
+    std::string from = args[1].toString();
+    if (from != "*") {
+        t.from = findState(*a, from);
+        if (t.from < 0) return Value::boolean(false);
+    }
+    t.to = findState(*a, args[2].toString());
+    if (t.to < 0) return Value::boolean(false);
+    if (args.size() > 3 && args[3].isArray() && args[3].arrayPtr) {
+        for (const auto& cv : *args[3].arrayPtr) {
+            if (!cv.isArray() || !cv.arrayPtr || cv.arrayPtr->size() < 3) return Value::boolean(false);
+            const auto& triple = *cv.arrayPtr;
+            AnimatorCondition c;
+            if (!parseConditionOp(triple[1].toString(), c.op)) return Value::boolean(false);
+            c.param = findParam(*a, triple[0].toString(), true);
+            c.value = triple[2].isBool() ? (triple[2].boolVal ? 1.0 : 0.0) : triple[2].numberVal;
+            t.conditions.push_back(c);
+        }
+    }
+    if (args.size() > 4 && args[4].isNumber()) t.exitTime = args[4].numberVal;
+    a->transitions.push_back(std::move(t));
+    return Value::boolean(true);
+}
+Value apiAnimatorSetParam(const std::vector<Value>& args) {
+    if (args.size() < 3) return Value::nilVal();
+    auto* a = getAnimator(args[0]);
+    if (!a) return Value::nilVal();
+    int idx = findParam(*a, args[1].toString(), true);
+    a->params[(size_t)idx] = args[2].isBool() ? (args[2].boolVal ? 1.0 : 0.0) : args[2].numberVal;
+    return Value::nilVal();
+}
+Value apiAnimatorGetParam(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::number(0);
+    auto* a = getAnimator(args[0]);
+    if (!a) return Value::number(0);
+    int idx = findParam(*a, args[1].toString(), false);
+    return Value::number(idx >= 0 ? a->params[(size_t)idx] : 0.0);
+}
+Value apiAnimatorState(const std::vector<Value>& args) {
+    if (args.empty()) return Value::nilVal();
+    auto* a = getAnimator(args[0]);
+    if (!a || a->current < 0 || a->current >= (int)a->states.size()) return Value::nilVal();
+    return Value::string(a->states[(size_t)a->current].name);
+}
+Value apiAnimatorPlay(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::boolean(false);
+    auto* a = getAnimator(args[0]);
+    if (!a) return Value::boolean(false);
+    int idx = findState(*a, args[1].toString());
+    Animation* anim = st.animations.get(a->animId);
+    if (idx < 0 || !anim) return Value::boolean(false);
+    enterState(*a, *anim, idx);
+    return Value::boolean(true);
+}
+
+Value apiAnimGetFrame(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(-1);
+    auto* anim = getAnimation((int)args[0].numberVal);
+    if (!anim || anim->frames.empty()) return Value::number(-1);
+    return Value::number(anim->frames[(size_t)anim->currentIndex % anim->frames.size()]);
+}
+
 void updateAnimationsTick(double dt) {
-    for (auto& kv : st.animations) {
-        Animation& a = kv.second;
-        if (!a.playing || a.frames.empty() || a.fps <= 0.0) continue;
-        if (a.currentIndex >= (int)a.frames.size()) a.currentIndex %= (int)a.frames.size();
+    for (Animator& a : st.animators) evaluateAnimator(a, dt);
+    for (Animation& a : st.animations) {
+        if (!a.playing || a.frames.empty()) continue;
+        double length = cycleLength(a);
+        if (length <= 0.0) continue;
+        // Time-based: one prefix-sum lookup per tick however large dt is.
         a.accumulator += dt;
-        double frameTime = 1.0 / a.fps;
-        while (a.accumulator >= frameTime) {
-            a.accumulator -= frameTime;
-            a.currentIndex++;
-            if (a.currentIndex >= (int)a.frames.size()) {
-                if (a.loop) a.currentIndex = 0;
-                else { a.currentIndex = (int)a.frames.size() - 1; a.playing = false; break; }
+        if (a.accumulator >= length) {
+            if (a.loop) {
+                a.accumulator = std::fmod(a.accumulator, length);
+            } else {
+                a.accumulator = length;
+                a.currentIndex = lastFrameIndex(a);
+                a.playing = false;
+                continue;
             }
         }
+        a.currentIndex = frameAtTime(a, a.accumulator);
     }
 }
 } // namespace yuki
@@ -3,7 +3,10 @@
 #include <vector>
 
 namespace yuki {
+struct Animation;
+
 Value apiAnimCreate(const std::vector<Value>& args);
+Value apiAnimDestroy(const std::vector<Value>& args);
 Value apiAnimPlay(const std::vector<Value>& args);
 Value apiAnimStop(const std::vector<Value>& args);
 Value apiAnimReset(const std::vector<Value>& args);
@@ -13,11 +16,27 @@ Value apiAnimSetScale(const std::vector<Value>& args);
 Value apiAnimSetRotation(const std::vector<Value>& args);
 Value apiAnimSetFlip(const std::vector<Value>& args);
 Value apiAnimSetAlpha(const std::vector<Value>& args);
+Value apiAnimSetDurations(const std::vector<Value>& args);
+Value apiAnimSetDirection(const std::vector<Value>& args);
 Value apiAnimDraw(const std::vector<Value>& args);
 Value apiAnimGetPosition(const std::vector<Value>& args);
 Value apiAnimGetScale(const std::vector<Value>& args);
 Value apiAnimGetRotation(const std::vector<Value>& args);
 Value apiAnimGetAlpha(const std::vector<Value>& args);
+Value apiAnimGetFrame(const std::vector<Value>& args);
+
+Value apiAnimatorCreate(const std::vector<Value>& args);
+Value apiAnimatorDestroy(const std::vector<Value>& args);
+Value apiAnimatorAnim(const std::vector<Value>& args);
+Value apiAnimatorAddState(const std::vector<Value>& args);
+Value apiAnimatorAddClip(const std::vector<Value>& args);
+Value apiAnimatorAddTransition(const std::vector<Value>& args);
+Value apiAnimatorSetParam(const std::vector<Value>& args);
+Value apiAnimatorGetParam(const std::vector<Value>& args);
+Value apiAnimatorState(const std::vector<Value>& args);
+Value apiAnimatorPlay(const std::vector<Value>& args);
 
 void updateAnimationsTick(double dt);
+void drawAnimation(const Animation& anim);
+void restartAnimation(Animation& anim);
 } // namespace yuki
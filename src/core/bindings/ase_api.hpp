@@ -0,0 +1,16 @@
+#pragma once
+#include "state.hpp"
+#include "../aseprite_loader.hpp"
+
+namespace yuki {
+// Rebuilds the per-tag frame lists, durations and directions of an asset.
+void buildAseTags(const AseData& data, BindingsState::AseAsset& asset);
+// Uploads decoded frames as a sheet and registers the asset; returns its id or -1.
+int registerAseAsset(const std::string& path, AseData&& data);
+// Hot reload: every changed asset file (normalized paths from the file
+// watcher) gets a decode + diff job; the results are applied on the main
+// thread at the start of a later frame, so a sheet's dirty frames and its tags
+// are swapped in together.
+void queueAseReloads(const std::vector<std::string>& changed);
+void applyAseReloads();
+} // namespace yuki
@@ -0,0 +1,197 @@
+#include "asset_api.hpp"
+#include "state.hpp"
+#include "ase_api.hpp"
+#include "../aseprite_loader.hpp"
+#include "../job_system.hpp"
+#include "../renderer2d.hpp"
+#include "../log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+namespace yuki {
+// Written by one decode job; read on the main thread once `counter` is done.
+struct AssetDecode {
+    JobSystem::Counter counter;
+    bool ok = false;
+    Renderer2D::DecodedImage image;
+    Renderer2D::DecodedFont font;
+    AseData ase;
+};
+
+namespace {
+BindingsState& st = bindingsState();
+
+std::filesystem::path resolvePath(const std::string& rel) {
+    std::filesystem::path p(rel);
+    if (p.is_absolute()) return p.lexically_normal();
+    if (!st.assetBase.empty()) return (std::filesystem::path(st.assetBase) / p).lexically_normal();
+    return p.lexically_normal();
+}
+
+void runDecode(AssetKind kind, const std::string& path, const std::string& metricsPath, AssetDecode& decode) {
+    switch (kind) {
+    case AssetKind::Sprite:
+    case AssetKind::SpriteSheet:
+        decode.ok = Renderer2D::decodeImage(path, decode.image);
+        break;
+    case AssetKind::Font:
+        decode.ok = Renderer2D::decodeFont(metricsPath, decode.font);
+        break;
+    case AssetKind::Ase:
+        decode.ok = loadAsepriteFile(path, decode.ase, assetJobSystem());
+        break;
+    }
+}
+
+Value requestAsset(AsyncAsset asset) {
+    if (!st.renderer) return Value::number(-1);
+    // A new batch starts once everything requested so far has finished, so
+    // asset_progress() measures the current loading screen only.
+    if (st.asyncFinished == st.asyncRequested) {
+        st.asyncRequested = 0;
+        st.asyncFinished = 0;
+    }
+    auto decode = std::make_shared<AssetDecode>();
+    asset.decode = decode;
+    AssetKind kind = asset.kind;
+    std::string path = asset.path;
+    std::string metricsPath = asset.metricsPath;
+    int handle = st.asyncAssets.insert(std::move(asset));
+    st.asyncUploadQueue.push_back(handle);
+    st.asyncRequested++;
+    assetJobSystem().submit(decode->counter, [decode, kind, path, metricsPath]() {
+        runDecode(kind, path, metricsPath, *decode);
+    });
+    return Value::number(handle);
+}
+
+int uploadAsset(AsyncAsset& asset) {
+    AssetDecode& decode = *asset.decode;
+    if (!decode.ok) return -1;
+    switch (asset.kind) {
+    case AssetKind::Sprite:
+        return st.renderer->uploadSprite(asset.path, decode.image);
+    case AssetKind::SpriteSheet:
+        return st.renderer->uploadSpriteSheet(asset.path, asset.frameW, asset.frameH, decode.image);
+    case AssetKind::Font:
+        return st.renderer->uploadFont(asset.metricsPath, decode.font);
+    case AssetKind::Ase:
+        return registerAseAsset(asset.path, std::move(decode.ase));
+    }
+    return -1;
+}
+
+AsyncAsset* getAsset(const Value& v) {
+    if (!v.isNumber()) return nullptr;
+    return st.asyncAssets.get((int)v.numberVal);
+}
+} // namespace
+
+void pumpAssetUploads() {
+    if (st.asyncUploadQueue.empty() || !st.renderer) return;
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    bool uploaded = false;
+    size_t keep = 0;
+    for (size_t i = 0; i < st.asyncUploadQueue.size(); ++i) {
+        int handle = st.asyncUploadQueue[i];
+        AsyncAsset* asset = st.asyncAssets.get(handle);
+        if (!asset) continue;
+        double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        bool overBudget = uploaded && elapsedMs >= st.asyncUploadBudgetMs;
+        if (overBudget || !asset->decode->counter.done()) {
+            st.asyncUploadQueue[keep++] = handle;
+            continue;
+        }
+        asset->resultId = uploadAsset(*asset);
+        asset->status = asset->resultId >= 0 ? AssetStatus::Ready : AssetStatus::Failed;
+        if (asset->status == AssetStatus::Failed) logError("Failed to load asset: " + asset->path);
+        asset->decode.reset();
+        st.asyncFinished++;
+        uploaded = true;
+    }
+    st.asyncUploadQueue.resize(keep);
+}
+
+Value apiLoadSpriteAsync(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(-1);
+    AsyncAsset asset;
+    asset.kind = AssetKind::Sprite;
+    asset.path = resolvePath(args[0].toString()).string();
+    return requestAsset(std::move(asset));
+}
+
+Value apiLoadSpriteSheetAsync(const std::vector<Value>& args) {
+    if (args.size() < 3) return Value::number(-1);
+    AsyncAsset asset;
+    asset.kind = AssetKind::SpriteSheet;
+    asset.path = resolvePath(args[0].toString()).string();
+    asset.frameW = (int)args[1].numberVal;
+    asset.frameH = (int)args[2].numberVal;
+    if (asset.frameW <= 0 || asset.frameH <= 0) return Value::number(-1);
+    return requestAsset(std::move(asset));
+}
+
+Value apiLoadFontAsync(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::number(-1);
+    AsyncAsset asset;
+    asset.kind = AssetKind::Font;
+    asset.path = resolvePath(args[0].toString()).string();
+    asset.metricsPath = resolvePath(args[1].toString()).string();
+    return requestAsset(std::move(asset));
+}
+
+Value apiAseLoadAsync(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(-1);
+    AsyncAsset asset;
+    asset.kind = AssetKind::Ase;
+    asset.path = resolvePath(args[0].toString()).string();
+    return requestAsset(std::move(asset));
+}
+
+Value apiAssetReady(const std::vector<Value>& args) {
+    if (args.empty()) return Value::boolean(false);
+    AsyncAsset* asset = getAsset(args[0]);
+    return Value::boolean(asset && asset->status == AssetStatus::Ready);
+}
+
+Value apiAssetStatus(const std::vector<Value>& args) {
+    if (args.empty()) return Value::nilVal();
+    AsyncAsset* asset = getAsset(args[0]);
+    if (!asset) return Value::nilVal();
+    switch (asset->status) {
+    case AssetStatus::Pending: return Value::string("pending");
+    case AssetStatus::Ready: return Value::string("ready");
+    case AssetStatus::Failed: return Value::string("failed");
+    }
+    return Value::nilVal();
+}
+
+Value apiAssetId(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(-1);
+    AsyncAsset* asset = getAsset(args[0]);
+    return Value::number(asset ? asset->resultId : -1);
+}
+
+Value apiAssetProgress(const std::vector<Value>& args) {
+    if (!args.empty() && args[0].isArray() && args[0].arrayPtr) {
+        const auto& handles = *args[0].arrayPtr;
+        if (handles.empty()) return Value::number(1.0);
+        size_t done = 0;
+        for (const Value& h : handles) {
+            AsyncAsset* asset = getAsset(h);
+            if (!asset || asset->status != AssetStatus::Pending) done++;
+        }
+        return Value::number((double)done / (double)handles.size());
+    }
+    if (st.asyncRequested == 0) return Value::number(1.0);
+    return Value::number((double)st.asyncFinished / (double)st.asyncRequested);
+}
+
+Value apiAssetSetBudget(const std::vector<Value>& args) {
+    if (args.empty() || !args[0].isNumber()) return Value::nilVal();
+    st.asyncUploadBudgetMs = std::max(0.0, args[0].numberVal);
+    return Value::nilVal();
+}
+} // namespace yuki
@@ -0,0 +1,19 @@
+#pragma once
+#include "../../script/value.hpp"
+#include <vector>
+
+namespace yuki {
+Value apiLoadSpriteAsync(const std::vector<Value>& args);
+Value apiLoadSpriteSheetAsync(const std::vector<Value>& args);
+Value apiLoadFontAsync(const std::vector<Value>& args);
+Value apiAseLoadAsync(const std::vector<Value>& args);
+Value apiAssetReady(const std::vector<Value>& args);
+Value apiAssetStatus(const std::vector<Value>& args);
+Value apiAssetId(const std::vector<Value>& args);
+Value apiAssetProgress(const std::vector<Value>& args);
+Value apiAssetSetBudget(const std::vector<Value>& args);
+
+// Uploads finished decodes on the main thread, oldest request first, until
+// the per-frame budget is spent. At least one upload happens per call.
+void pumpAssetUploads();
+} // namespace yuki
@@ -4,6 +4,7 @@
 namespace yuki {
 void registerAnimBuiltins(std::unordered_map<std::string, NativeFn>& builtins) {
     builtins["anim_create"] = apiAnimCreate;
+    builtins["anim_destroy"] = apiAnimDestroy;
     builtins["anim_play"] = apiAnimPlay;
     builtins["anim_stop"] = apiAnimStop;
     builtins["anim_reset"] = apiAnimReset;
@@ -13,10 +14,23 @@ void registerAnimBuiltins(std::unordered_map<std::string, NativeFn>& builtins) {
     builtins["anim_set_rotation"] = apiAnimSetRotation;
     builtins["anim_set_flip"] = apiAnimSetFlip;
     builtins["anim_set_alpha"] = apiAnimSetAlpha;
+    builtins["anim_set_durations"] = apiAnimSetDurations;
+    builtins["anim_set_direction"] = apiAnimSetDirection;
     builtins["anim_draw"] = apiAnimDraw;
     builtins["anim_get_position"] = apiAnimGetPosition;
     builtins["anim_get_scale"] = apiAnimGetScale;
     builtins["anim_get_rotation"] = apiAnimGetRotation;
     builtins["anim_get_alpha"] = apiAnimGetAlpha;
+    builtins["anim_get_frame"] = apiAnimGetFrame;
+    builtins["animator_create"] = apiAnimatorCreate;
+    builtins["animator_destroy"] = apiAnimatorDestroy;
+    builtins["animator_anim"] = apiAnimatorAnim;
+    builtins["animator_add_state"] = apiAnimatorAddState;
+    builtins["animator_add_clip"] = apiAnimatorAddClip;
+    builtins["animator_add_transition"] = apiAnimatorAddTransition;
+    builtins["animator_set_param"] = apiAnimatorSetParam;
+    builtins["animator_get_param"] = apiAnimatorGetParam;
+    builtins["animator_state"] = apiAnimatorState;
+    builtins["animator_play"] = apiAnimatorPlay;
 }
 } // namespace yuki
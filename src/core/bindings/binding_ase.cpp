@@ -3,10 +3,15 @@
 #include "../aseprite_loader.hpp"
 #include "../renderer2d.hpp"
 #include "anim_api.hpp"
+#include "ase_api.hpp"
 #include "value_utils.hpp"
+#include "../job_system.hpp"
+#include "../file_watcher.hpp"
 #include "../log.hpp"
 #include <filesystem>
 #include <algorithm>
+#include <cstring>
+#include <memory>
 
 namespace yuki {
 namespace {
@@ -19,62 +24,207 @@ std::filesystem::path resolvePath(const std::string& rel) {
     return p;
 }
 
-void buildTags(const AseData& data, BindingsState::AseAsset& asset) {
+struct DirtyRect {
+    int frame = 0;
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+};
+
+// Filled by a worker; only read on the main thread once `counter` is done.
+struct AseReload {
+    int assetId = -1;
+    std::string path;
+    std::filesystem::file_time_type writeTime;
+    std::shared_ptr<const AseData> previous;
+    std::shared_ptr<AseData> data = std::make_shared<AseData>();
+    std::vector<DirtyRect> dirty;
+    bool ok = false;
+    bool fullUpload = false;
+    JobSystem::Counter counter;
+};
+
+std::vector<std::shared_ptr<AseReload>> pendingReloads;
+
+// Bounding box of the pixels that differ between two w*h RGBA frames.
+bool frameDirtyRect(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b, int w, int h, DirtyRect& out) {
+    size_t rowBytes = (size_t)w * 4;
+    int y0 = 0;
+    while (y0 < h && std::memcmp(a.data() + y0 * rowBytes, b.data() + y0 * rowBytes, rowBytes) == 0) ++y0;
+    if (y0 == h) return false;
+    int y1 = h - 1;
+    while (y1 > y0 && std::memcmp(a.data() + y1 * rowBytes, b.data() + y1 * rowBytes, rowBytes) == 0) --y1;
+    int x0 = w;
+    int x1 = -1;
+    for (int y = y0; y <= y1; ++y) {
+        const unsigned char* ra = a.data() + y * rowBytes;
+        const unsigned char* rb = b.data() + y * rowBytes;
+        for (int x = 0; x < x0; ++x) {
+            if (std::memcmp(ra + x * 4, rb + x * 4, 4) != 0) {
+                x0 = x;
+                break;
+            }
+        }
+        for (int x = w - 1; x > x1; --x) {
+            if (std::memcmp(ra + x * 4, rb + x * 4, 4) != 0) {
+                x1 = x;
+                break;
+            }
+        }
+    }
+    out.x = x0;
+    out.y = y0;
+    out.w = x1 - x0 + 1;
+    out.h = y1 - y0 + 1;
+    return true;
+}
+
+void decodeAndDiff(AseReload& reload) {
+    AseData& data = *reload.data;
+    if (!loadAsepriteFile(reload.path, data, assetJobSystem())) return;
+    if (data.width <= 0 || data.height <= 0 || data.frames.empty()) return;
+    reload.ok = true;
+    const AseData* prev = reload.previous.get();
+    if (!prev || prev->width != data.width || prev->height != data.height || prev->frames.size() != data.frames.size()) {
+        reload.fullUpload = true;
+        return;
+    }
+    for (size_t i = 0; i < data.frames.size(); ++i) {
+        DirtyRect rect;
+        rect.frame = (int)i;
+        if (frameDirtyRect(prev->frames[i], data.frames[i], data.width, data.height, rect)) reload.dirty.push_back(rect);
+    }
+}
+}
+
+void buildAseTags(const AseData& data, BindingsState::AseAsset& asset) {
     asset.tagFrames.clear();
     asset.tagFps.clear();
+    asset.tagFrameEnd.clear();
+    asset.tagDirection.clear();
     for (const auto& tag : data.tags) {
+        // Frames stay in timeline order; direction is applied at playback so
+        // ping-pong tags do not duplicate frames.
         std::vector<int> frames;
+        std::vector<double> frameEnd;
+        double total = 0.0;
         for (int fi = tag.from; fi <= tag.to && fi < (int)data.frames.size(); ++fi) {
+            int ms = fi < (int)data.durationsMs.size() && data.durationsMs[fi] > 0 ? data.durationsMs[fi] : 100;
             frames.push_back(fi);
-        }
-        if (tag.direction == 1) {
-            std::reverse(frames.begin(), frames.end());
-        } else if (tag.direction == 2) {
-            if (!frames.empty()) {
-                for (int i = (int)frames.size() - 2; i >= 1; --i) {
-                    frames.push_back(frames[i]);
-                }
-            }
+            total += ms / 1000.0;
+            frameEnd.push_back(total);
         }
         if (frames.empty()) continue;
-        double avgMs = 0.0;
-        int count = 0;
-        for (int f : frames) {
-            if (f >= 0 && f < (int)data.durationsMs.size() && data.durationsMs[f] > 0) {
-                avgMs += data.durationsMs[f];
-                count++;
+        AnimDirection dir = AnimDirection::Forward;
+        if (tag.direction == 1) dir = AnimDirection::Reverse;
+        else if (tag.direction == 2 || tag.direction == 3) dir = AnimDirection::PingPong;
+        if (tag.direction == 3) {
+            // Ping-pong reverse: play the reversed list forward and back.
+            std::reverse(frames.begin(), frames.end());
+            double t = 0.0;
+            std::vector<double> reversed;
+            for (size_t i = frames.size(); i-- > 0;) {
+                double start = i > 0 ? frameEnd[i - 1] : 0.0;
+                t += frameEnd[i] - start;
+                reversed.push_back(t);
             }
-        }
-        double fps = 10.0;
-        if (count > 0) {
-            avgMs /= (double)count;
-            fps = avgMs > 0.0 ? 1000.0 / avgMs : 10.0;
+            frameEnd = std::move(reversed);
         }
         asset.tagFrames[tag.name] = frames;
-        asset.tagFps[tag.name] = fps;
+        asset.tagFps[tag.name] = (double)frames.size() / total;
+        asset.tagFrameEnd[tag.name] = std::move(frameEnd);
+        asset.tagDirection[tag.name] = dir;
     }
 }
+
+void queueAseReloads(const std::vector<std::string>& changed) {
+    for (auto& kv : st.aseAssets) {
+        auto& asset = kv.second;
+        if (asset.path.empty()) continue;
+        if (std::find(changed.begin(), changed.end(), asset.path) == changed.end()) continue;
+        std::error_code ec;
+        auto cur = std::filesystem::last_write_time(asset.path, ec);
+        if (ec || cur <= asset.lastWriteTime) continue;
+        bool inFlight = std::any_of(pendingReloads.begin(), pendingReloads.end(), [&](const auto& r) {
+            return r->assetId == asset.id && r->writeTime == cur;
+        });
+        if (inFlight) continue;
+        auto reload = std::make_shared<AseReload>();
+        reload->assetId = asset.id;
+        reload->path = asset.path;
+        reload->writeTime = cur;
+        reload->previous = asset.decoded;
+        pendingReloads.push_back(reload);
+        assetJobSystem().submit(reload->counter, [reload]() { decodeAndDiff(*reload); });
+    }
 }
 
-Value apiAseLoad(const std::vector<Value>& args) {
-    if (args.empty() || !st.renderer) return Value::number(-1);
-    auto p = resolvePath(args[0].toString());
-    AseData data;
-    if (!loadAsepriteFile(p.string(), data)) return Value::number(-1);
+void applyAseReloads() {
+    if (pendingReloads.empty()) return;
+    size_t keep = 0;
+    for (size_t i = 0; i < pendingReloads.size(); ++i) {
+        std::shared_ptr<AseReload> reload = pendingReloads[i];
+        if (!reload->counter.done()) {
+            pendingReloads[keep++] = reload;
+            continue;
+        }
+        auto it = st.aseAssets.find(reload->assetId);
+        if (it == st.aseAssets.end() || it->second.path != reload->path || !st.renderer) continue;
+        auto& asset = it->second;
+        // A failed decode (e.g. the file is still being written) keeps the old
+        // timestamp so the next poll tries again.
+        if (!reload->ok || reload->writeTime <= asset.lastWriteTime) continue;
+        const AseData& data = *reload->data;
+        // Rects were diffed against `previous`; if another reload landed in
+        // between they no longer describe what is on the GPU.
+        if (reload->previous != asset.decoded) reload->fullUpload = true;
+        if (reload->fullUpload) {
+            if (!st.renderer->updateSpriteSheetFromFrames(asset.sheetId, data.width, data.height, data.frames)) continue;
+        } else {
+            for (const DirtyRect& r : reload->dirty) {
+                const auto& frame = data.frames[(size_t)r.frame];
+                const unsigned char* origin = frame.data() + ((size_t)r.y * data.width + r.x) * 4;
+                st.renderer->updateSpriteSheetFrameRect(asset.sheetId, r.frame, r.x, r.y, r.w, r.h, origin);
+            }
+        }
+        asset.frameW = data.width;
+        asset.frameH = data.height;
+        asset.lastWriteTime = reload->writeTime;
+        buildAseTags(data, asset);
+        asset.decoded = reload->data;
+        logInfo("ase_reload: " + asset.path + " frames=" + std::to_string(reload->fullUpload ? data.frames.size() : reload->dirty.size()) +
+                (reload->fullUpload ? " (full)" : " (dirty)") + " tags=" + std::to_string(asset.tagFrames.size()));
+    }
+    pendingReloads.resize(keep);
+}
+
+int registerAseAsset(const std::string& path, AseData&& data) {
+    if (!st.renderer) return -1;
     int sheetId = st.renderer->createSpriteSheetFromFrames(data.width, data.height, data.frames);
-    if (sheetId < 0) return Value::number(-1);
+    if (sheetId < 0) return -1;
     BindingsState::AseAsset asset;
     asset.id = st.aseCounter++;
     asset.sheetId = sheetId;
     asset.frameW = data.width;
     asset.frameH = data.height;
-    asset.path = p.string();
+    asset.path = FileWatcher::normalize(path);
     std::error_code ec;
-    asset.lastWriteTime = std::filesystem::last_write_time(p, ec);
-    buildTags(data, asset);
+    asset.lastWriteTime = std::filesystem::last_write_time(asset.path, ec);
+    buildAseTags(data, asset);
+    asset.decoded = std::make_shared<const AseData>(std::move(data));
+    fileWatcher().watch(asset.path);
     st.aseAssets[asset.id] = asset;
-    logInfo("ase_load: " + p.string() + " tags=" + std::to_string(asset.tagFrames.size()));
-    return Value::number(asset.id);
+    logInfo("ase_load: " + path + " tags=" + std::to_string(asset.tagFrames.size()));
+    return asset.id;
+}
+
+Value apiAseLoad(const std::vector<Value>& args) {
+    if (args.empty() || !st.renderer) return Value::number(-1);
+    auto p = resolvePath(args[0].toString());
+    AseData data;
+    if (!loadAsepriteFile(p.string(), data, jobSystem())) return Value::number(-1);
+    return Value::number(registerAseAsset(p.string(), std::move(data)));
 }
 
 Value apiAseAnim(const std::vector<Value>& args) {
@@ -96,7 +246,13 @@ Value apiAseAnim(const std::vector<Value>& args) {
     animArgs.push_back(Value::array(frameVals));
     animArgs.push_back(Value::number(fps));
     animArgs.push_back(Value::boolean(loop));
-    return apiAnimCreate(animArgs);
+    Value animId = apiAnimCreate(animArgs);
+    if (Animation* anim = st.animations.get((int)animId.numberVal)) {
+        anim->direction = asset.tagDirection.at(tag);
+        if (fpsOverride <= 0.0) anim->frameEnd = asset.tagFrameEnd.at(tag);
+        restartAnimation(*anim);
+    }
+    return animId;
 }
 
 Value apiAseTags(const std::vector<Value>& args) {
@@ -0,0 +1,16 @@
+#include "register_bindings.hpp"
+#include "asset_api.hpp"
+
+namespace yuki {
+void registerAssetBuiltins(std::unordered_map<std::string, NativeFn>& builtins) {
+    builtins["load_sprite_async"] = apiLoadSpriteAsync;
+    builtins["load_sprite_sheet_async"] = apiLoadSpriteSheetAsync;
+    builtins["load_font_async"] = apiLoadFontAsync;
+    builtins["ase_load_async"] = apiAseLoadAsync;
+    builtins["asset_ready"] = apiAssetReady;
+    builtins["asset_status"] = apiAssetStatus;
+    builtins["asset_id"] = apiAssetId;
+    builtins["asset_progress"] = apiAssetProgress;
+    builtins["asset_set_budget"] = apiAssetSetBudget;
+}
+} // namespace yuki
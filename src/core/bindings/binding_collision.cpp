@@ -9,6 +9,8 @@ void registerCollisionBuiltins(std::unordered_map<std::string, NativeFn>& builti
     builtins["collider_get_position"] = apiColliderGetPos;
     builtins["collider_get_size"] = apiColliderGetSize;
     builtins["collider_move"] = apiColliderMove;
+    builtins["frame_collider_get_position"] = apiFrameColliderGetPos;
+    builtins["frame_collider_move"] = apiFrameColliderMove;
     builtins["rect_overlaps"] = apiRectOverlaps;
     builtins["point_in_rect"] = apiPointInRect;
     builtins["create_area_rect"] = apiCreateAreaRect;
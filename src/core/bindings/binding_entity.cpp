@@ -0,0 +1,23 @@
+#include "register_bindings.hpp"
+#include "entity_api.hpp"
+
+namespace yuki {
+void registerEntityBuiltins(std::unordered_map<std::string, NativeFn>& builtins) {
+    builtins["world_create"] = apiWorldCreate;
+    builtins["world_destroy"] = apiWorldDestroy;
+    builtins["world_count"] = apiWorldCount;
+    builtins["world_fixed"] = apiWorldFixed;
+    builtins["world_draw"] = apiWorldDraw;
+    builtins["entity_create"] = apiEntityCreate;
+    builtins["entity_destroy"] = apiEntityDestroy;
+    builtins["entity_alive"] = apiEntityAlive;
+    builtins["entity_set_position"] = apiEntitySetPosition;
+    builtins["entity_get_position"] = apiEntityGetPosition;
+    builtins["entity_set_velocity"] = apiEntitySetVelocity;
+    builtins["entity_set_collider"] = apiEntitySetCollider;
+    builtins["entity_set_anim"] = apiEntitySetAnim;
+    builtins["entity_set_native_draw"] = apiEntitySetNativeDraw;
+    builtins["entity_pull"] = apiEntityPull;
+    builtins["entity_push"] = apiEntityPush;
+}
+} // namespace yuki
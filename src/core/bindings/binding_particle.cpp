@@ -0,0 +1,15 @@
+#include "register_bindings.hpp"
+#include "particle_api.hpp"
+
+namespace yuki {
+void registerParticleBuiltins(std::unordered_map<std::string, NativeFn>& builtins) {
+    builtins["particles_create"] = apiParticlesCreate;
+    builtins["particles_destroy"] = apiParticlesDestroy;
+    builtins["particles_emit"] = apiParticlesEmit;
+    builtins["particles_update"] = apiParticlesUpdate;
+    builtins["particles_draw"] = apiParticlesDraw;
+    builtins["particles_count"] = apiParticlesCount;
+    builtins["particles_clear"] = apiParticlesClear;
+    builtins["particles_set_auto_update"] = apiParticlesSetAutoUpdate;
+}
+} // namespace yuki
@@ -30,5 +30,6 @@ void registerRenderBuiltins(std::unordered_map<std::string, NativeFn>& builtins)
     builtins["camera_set_bounds"] = apiCameraSetBounds;
     builtins["camera_clear_bounds"] = apiCameraClearBounds;
     builtins["camera_shake"] = apiCameraShake;
+    builtins["render_stats"] = apiRenderStats;
 }
 } // namespace yuki
@@ -0,0 +1,15 @@
+#include "register_bindings.hpp"
+#include "scheduler_api.hpp"
+
+namespace yuki {
+void registerSchedulerBuiltins(std::unordered_map<std::string, NativeFn>& builtins) {
+    builtins["scheduler_create"] = apiSchedulerCreate;
+    builtins["scheduler_destroy"] = apiSchedulerDestroy;
+    builtins["scheduler_add"] = apiSchedulerAdd;
+    builtins["scheduler_tick"] = apiSchedulerTick;
+    builtins["scheduler_set_fixed_dt"] = apiSchedulerSetFixedDt;
+    builtins["scheduler_set_max_steps"] = apiSchedulerSetMaxSteps;
+    builtins["scheduler_alpha"] = apiSchedulerAlpha;
+    builtins["scheduler_fixed_steps"] = apiSchedulerFixedSteps;
+}
+} // namespace yuki
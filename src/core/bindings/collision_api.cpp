@@ -2,7 +2,8 @@
 #include "state.hpp"
 #include "value_utils.hpp"
 #include "../renderer2d.hpp"
-#include <set>
+#include "../../script/frame_arena.hpp"
+#include <algorithm>
 
 namespace yuki {
 namespace {
@@ -64,6 +65,11 @@ Value apiColliderGetPos(const std::vector<Value>& args) {
     m["y"] = Value::number(st.colliders[id].y);
     return Value::map(m);
 }
+Value apiFrameColliderGetPos(const std::vector<Value>& args) {
+    int id = args.empty() ? -1 : (int)args[0].numberVal;
+    if (id < 0 || id >= (int)st.colliders.size()) return frameMap({});
+    return frameMap({{"x", Value::number(st.colliders[id].x)}, {"y", Value::number(st.colliders[id].y)}});
+}
 Value apiColliderGetSize(const std::vector<Value>& args) {
     if (args.empty()) return Value::map({});
     int id = (int)args[0].numberVal;
@@ -73,16 +79,11 @@ Value apiColliderGetSize(const std::vector<Value>& args) {
     m["h"] = Value::number(st.colliders[id].h);
     return Value::map(m);
 }
-Value apiColliderMove(const std::vector<Value>& args) {
-    if (args.size() < 3) return Value::array({});
-    int id = (int)args[0].numberVal;
-    if (id < 0 || id >= (int)st.colliders.size()) return Value::array({});
-    float dx = (float)args[1].numberVal;
-    float dy = (float)args[2].numberVal;
+void moveCollider(int id, float dx, float dy, std::vector<int>* hits) {
+    if (id < 0 || id >= (int)st.colliders.size()) return;
     Collider& c = st.colliders[id];
     float nx = c.x + dx;
     float ny = c.y + dy;
-    std::set<int> hits;
     for (size_t i = 0; i < st.colliders.size(); ++i) {
         if ((int)i == id) continue;
         const Collider& o = st.colliders[i];
@@ -91,7 +92,7 @@ Value apiColliderMove(const std::vector<Value>& args) {
             if (dx > 0.0f) nx = std::min(nx, o.x - c.w);
             else if (dx < 0.0f) nx = std::max(nx, o.x + o.w);
         }
-        hits.insert((int)i);
+        if (hits) hits->push_back((int)i);
     }
     c.x = nx;
     for (size_t i = 0; i < st.colliders.size(); ++i) {
@@ -102,14 +103,25 @@ Value apiColliderMove(const std::vector<Value>& args) {
             if (dy > 0.0f) ny = std::min(ny, o.y - c.h);
             else if (dy < 0.0f) ny = std::max(ny, o.y + o.h);
         }
-        hits.insert((int)i);
+        if (hits) hits->push_back((int)i);
     }
     c.y = ny;
+    if (hits) {
+        std::sort(hits->begin(), hits->end());
+        hits->erase(std::unique(hits->begin(), hits->end()), hits->end());
+    }
+}
+
+Value apiColliderMove(const std::vector<Value>& args) {
+    if (args.size() < 3) return Value::array({});
+    int id = (int)args[0].numberVal;
+    if (id < 0 || id >= (int)st.colliders.size()) return Value::array({});
+    std::vector<int> hits;
+    moveCollider(id, (float)args[1].numberVal, (float)args[2].numberVal, &hits);
 
     std::vector<Value> arr;
     arr.reserve(hits.size());
     for (int hid : hits) {
-        if (hid < 0 || hid >= (int)st.colliders.size()) continue;
         std::unordered_map<std::string, Value> m;
         m["id"] = Value::number(hid);
         m["tag"] = Value::string(st.colliders[hid].tag);
@@ -117,6 +129,20 @@ Value apiColliderMove(const std::vector<Value>& args) {
     }
     return Value::array(arr);
 }
+Value apiFrameColliderMove(const std::vector<Value>& args) {
+    Value arr = frameArray();
+    if (args.size() < 3) return arr;
+    int id = (int)args[0].numberVal;
+    if (id < 0 || id >= (int)st.colliders.size()) return arr;
+    static std::vector<int> hits; // reused; bindings run on the main thread
+    hits.clear();
+    moveCollider(id, (float)args[1].numberVal, (float)args[2].numberVal, &hits);
+    arr.arrayPtr->reserve(hits.size());
+    for (int hid : hits) {
+        arr.arrayPtr->push_back(frameMap({{"id", Value::number(hid)}, {"tag", Value::string(st.colliders[hid].tag)}}));
+    }
+    return arr;
+}
 
 Value apiRectOverlaps(const std::vector<Value>& args) {
     if (args.size() < 8) return Value::boolean(false);
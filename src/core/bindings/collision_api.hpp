@@ -9,6 +9,9 @@ Value apiColliderSetSize(const std::vector<Value>& args);
 Value apiColliderGetPos(const std::vector<Value>& args);
 Value apiColliderGetSize(const std::vector<Value>& args);
 Value apiColliderMove(const std::vector<Value>& args);
+// frame_* variants: same results in frame-scoped containers (frame_arena.hpp).
+Value apiFrameColliderGetPos(const std::vector<Value>& args);
+Value apiFrameColliderMove(const std::vector<Value>& args);
 
 Value apiRectOverlaps(const std::vector<Value>& args);
 Value apiPointInRect(const std::vector<Value>& args);
@@ -20,4 +23,6 @@ Value apiAreaOverlapsTag(const std::vector<Value>& args);
 Value apiAreaEnteredTag(const std::vector<Value>& args);
 Value apiAreaExitedTag(const std::vector<Value>& args);
 Value apiDebugArea(const std::vector<Value>& args);
+
+void moveCollider(int id, float dx, float dy, std::vector<int>* hits = nullptr);
 } // namespace yuki
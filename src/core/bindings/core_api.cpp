@@ -2,9 +2,8 @@
 #include "state.hpp"
 #include "../window.hpp"
 #include "../log.hpp"
-#include "../../script/yuki_script_loader.hpp"
-#include "../../script/token.hpp"
-#include "../../script/parser.hpp"
+#include "../file_watcher.hpp"
+#include "../../script/ast_cache.hpp"
 #include "../../script/ast.hpp"
 #include "../../script/interpreter.hpp"
 #include <GLFW/glfw3.h>
@@ -59,20 +58,10 @@ Value importInternal(const std::vector<Value>& args, bool injectGlobals) {
         return cached->second;
     }
     logInfo("Importing " + p.string());
-    ScriptLoader loader(canon.string());
-    std::string content = loader.load();
-    Tokenizer tokenizer(content);
-    std::vector<Token> tokens = tokenizer.scanTokens();
-    if (tokenizer.hadError()) {
-        for (const auto& err : tokenizer.getErrors()) {
-            logError(err);
-        }
-        return Value::nilVal();
-    }
-    Parser parser(tokens);
-    std::vector<std::unique_ptr<Stmt>> statements = parser.parse();
-    if (parser.hadError()) {
-        for (const auto& err : parser.getErrors()) {
+    ScriptModule script;
+    std::vector<std::string> parseErrors;
+    if (!parseScriptFile(canon.string(), script, parseErrors)) {
+        for (const auto& err : parseErrors) {
             logError(err);
         }
         return Value::nilVal();
@@ -83,7 +72,7 @@ Value importInternal(const std::vector<Value>& args, bool injectGlobals) {
     st.interpreter->env = moduleEnv;
     moduleEnv->define("__module_dir", Value::string(canon.parent_path().string()));
     st.moduleDirStack.push_back(canon.parent_path());
-    st.interpreter->exec(statements);
+    st.interpreter->exec(script.statements);
     if (st.interpreter->hasRuntimeErrors()) {
         st.moduleDirStack.pop_back();
         st.interpreter->env = previousEnv;
@@ -92,12 +81,16 @@ Value importInternal(const std::vector<Value>& args, bool injectGlobals) {
         }
         return Value::nilVal();
     }
-    st.interpreter->retainModule(std::move(statements));
+    st.interpreter->retainModule(std::move(script));
+    st.interpreter->recordModuleFunctions(moduleEnv);
     st.loadedModules.insert(key);
+    fileWatcher().watch(key);
     Value exportsVal = Value::nilVal();
     auto exports = moduleEnv->get("exports");
     if (exports.has_value()) exportsVal = exports.value();
     st.moduleExports[key] = exportsVal;
+    st.moduleEnvs[key] = moduleEnv;
+    if (!alias && injectGlobals) st.injectedModules.insert(key);
     st.moduleDirStack.pop_back();
     st.interpreter->env = previousEnv;
     if (alias) {
@@ -177,4 +170,35 @@ Value apiAssert(const std::vector<Value>& args) {
     }
     return Value::nilVal();
 }
+
+bool reloadModule(const std::string& path, std::vector<std::string>& errors) {
+    if (!st.interpreter) return false;
+    auto envIt = st.moduleEnvs.find(path);
+    if (envIt == st.moduleEnvs.end()) {
+        errors.push_back("Not a loaded module: " + path);
+        return false;
+    }
+    ScriptModule script;
+    if (!parseScriptFile(path, script, errors)) return false;
+    std::shared_ptr<Environment> moduleEnv = envIt->second;
+    st.moduleDirStack.push_back(std::filesystem::path(path).parent_path());
+    bool ok = st.interpreter->reloadInto(std::move(script), moduleEnv);
+    st.moduleDirStack.pop_back();
+    if (!ok) {
+        for (const auto& err : st.interpreter->getRuntimeErrors()) errors.push_back(err);
+        st.interpreter->clearRuntimeErrors();
+        return false;
+    }
+    // The exports map was merged in place, so aliases already see new keys;
+    // globals injected by import() only need the names that are new.
+    auto exports = moduleEnv->values.find("exports");
+    Value exportsVal = exports != moduleEnv->values.end() ? exports->second : Value::nilVal();
+    st.moduleExports[path] = exportsVal;
+    if (st.injectedModules.count(path) && exportsVal.isMap() && exportsVal.mapPtr) {
+        for (const auto& kv : *exportsVal.mapPtr) {
+            if (!st.interpreter->globals->values.count(kv.first)) st.interpreter->globals->define(kv.first, kv.second);
+        }
+    }
+    return true;
+}
 } // namespace yuki
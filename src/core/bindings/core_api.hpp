@@ -1,5 +1,6 @@
 #pragma once
 #include "../../script/value.hpp"
+#include <string>
 #include <vector>
 
 namespace yuki {
@@ -11,4 +12,8 @@ Value apiRandom(const std::vector<Value>& args);
 Value apiGetScreenSize(const std::vector<Value>& args);
 Value apiError(const std::vector<Value>& args);
 Value apiAssert(const std::vector<Value>& args);
+
+// Re-parses and re-executes one loaded module in place (see
+// Interpreter::reloadInto). Errors are appended to `errors`.
+bool reloadModule(const std::string& path, std::vector<std::string>& errors);
 } // namespace yuki
@@ -0,0 +1,227 @@
+#include "entity_api.hpp"
+#include "state.hpp"
+#include "value_utils.hpp"
+#include "anim_api.hpp"
+#include "collision_api.hpp"
+#include <cmath>
+
+namespace yuki {
+namespace {
+BindingsState& st = bindingsState();
+
+EntityStore* getWorld(const Value& v) {
+    if (!v.isNumber()) return nullptr;
+    auto it = st.entityWorlds.find((int)v.numberVal);
+    if (it == st.entityWorlds.end()) return nullptr;
+    return &it->second;
+}
+
+// Resolves (world, entity) args to a dense index, or -1.
+int resolve(const std::vector<Value>& args, EntityStore*& world) {
+    if (args.size() < 2) return -1;
+    world = getWorld(args[0]);
+    if (!world || !args[1].isNumber()) return -1;
+    return world->indexOf((int)args[1].numberVal);
+}
+
+void syncToCollider(EntityStore& w, int i) {
+    if (!(w.flags[i] & EntityStore::HasCollider)) return;
+    int cid = w.colliderId[i];
+    if (cid < 0 || cid >= (int)st.colliders.size()) return;
+    st.colliders[cid].x = w.x[i] - w.colW[i] * 0.5f + w.colOX[i];
+    st.colliders[cid].y = w.y[i] - w.colH[i] * 0.5f + w.colOY[i];
+}
+
+double fieldNumber(const Value& m, const char* key, double def) {
+    auto it = m.mapPtr->find(key);
+    if (it == m.mapPtr->end() || !it->second.isNumber()) return def;
+    return it->second.numberVal;
+}
+} // namespace
+
+Value apiWorldCreate(const std::vector<Value>& args) {
+    (void)args;
+    int id = st.entityWorldCounter++;
+    st.entityWorlds[id] = EntityStore{};
+    return Value::number(id);
+}
+Value apiWorldDestroy(const std::vector<Value>& args) {
+    if (args.empty() || !args[0].isNumber()) return Value::boolean(false);
+    return Value::boolean(st.entityWorlds.erase((int)args[0].numberVal) > 0);
+}
+Value apiWorldCount(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(0);
+    auto* w = getWorld(args[0]);
+    return Value::number(w ? (double)w->size() : 0.0);
+}
+Value apiWorldFixed(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::nilVal();
+    auto* w = getWorld(args[0]);
+    if (!w) return Value::nilVal();
+    float dt = (float)args[1].numberVal;
+    size_t n = w->size();
+    for (size_t i = 0; i < n; ++i) {
+        w->prevX[i] = w->x[i];
+        w->prevY[i] = w->y[i];
+        float dx = w->vx[i] * dt;
+        float dy = w->vy[i] * dt;
+        int cid = w->colliderId[i];
+        if ((w->flags[i] & EntityStore::HasCollider) && cid >= 0 && cid < (int)st.colliders.size()) {
+            moveCollider(cid, dx, dy);
+            const Collider& c = st.colliders[cid];
+            w->x[i] = c.x - w->colOX[i] + w->colW[i] * 0.5f;
+            w->y[i] = c.y - w->colOY[i] + w->colH[i] * 0.5f;
+        } else {
+            w->x[i] += dx;
+            w->y[i] += dy;
+        }
+    }
+    return Value::nilVal();
+}
+Value apiWorldDraw(const std::vector<Value>& args) {
+    if (args.empty()) return Value::nilVal();
+    auto* w = getWorld(args[0]);
+    if (!w) return Value::nilVal();
+    bool pixelSnap = args.size() > 1 ? valueToBool(args[1]) : false;
+    float alpha = args.size() > 2 && args[2].isNumber() ? (float)args[2].numberVal : 1.0f;
+    size_t n = w->size();
+    for (size_t i = 0; i < n; ++i) {
+        float rx = w->prevX[i] + (w->x[i] - w->prevX[i]) * alpha;
+        float ry = w->prevY[i] + (w->y[i] - w->prevY[i]) * alpha;
+        if (pixelSnap) {
+            rx = std::floor(rx + 0.5f);
+            ry = std::floor(ry + 0.5f);
+        }
+        w->renderX[i] = rx;
+        w->renderY[i] = ry;
+    }
+    // Spawn order, not dense order: a destroy must not restack the others.
+    for (int id : w->spawnOrder()) {
+        int i = w->indexOf(id);
+        if (!(w->flags[i] & EntityStore::HasAnim)) continue;
+        Animation* animPtr = st.animations.get(w->animId[i]);
+        if (!animPtr) continue;
+        Animation& anim = *animPtr;
+        anim.transform.x = w->renderX[i] + w->animOX[i];
+        anim.transform.y = w->renderY[i] + w->animOY[i];
+        if (w->flags[i] & EntityStore::NativeDraw) {
+            anim.playing = true;
+            drawAnimation(anim);
+        }
+    }
+    return Value::nilVal();
+}
+Value apiEntityCreate(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(-1);
+    auto* w = getWorld(args[0]);
+    if (!w) return Value::number(-1);
+    float x = args.size() > 1 && args[1].isNumber() ? (float)args[1].numberVal : 0.0f;
+    float y = args.size() > 2 && args[2].isNumber() ? (float)args[2].numberVal : 0.0f;
+    return Value::number(w->create(x, y));
+}
+Value apiEntityDestroy(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::boolean(false);
+    auto* w = getWorld(args[0]);
+    if (!w || !args[1].isNumber()) return Value::boolean(false);
+    return Value::boolean(w->destroy((int)args[1].numberVal));
+}
+Value apiEntityAlive(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    return Value::boolean(resolve(args, w) >= 0);
+}
+Value apiEntitySetPosition(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    int i = resolve(args, w);
+    if (i < 0 || args.size() < 4) return Value::nilVal();
+    w->x[i] = (float)args[2].numberVal;
+    w->y[i] = (float)args[3].numberVal;
+    w->prevX[i] = w->x[i];
+    w->prevY[i] = w->y[i];
+    syncToCollider(*w, i);
+    return Value::nilVal();
+}
+Value apiEntityGetPosition(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    int i = resolve(args, w);
+    if (i < 0) return Value::map({});
+    std::unordered_map<std::string, Value> m;
+    m["x"] = Value::number(w->x[i]);
+    m["y"] = Value::number(w->y[i]);
+    return Value::map(m);
+}
+Value apiEntitySetVelocity(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    int i = resolve(args, w);
+    if (i < 0 || args.size() < 4) return Value::nilVal();
+    w->vx[i] = (float)args[2].numberVal;
+    w->vy[i] = (float)args[3].numberVal;
+    return Value::nilVal();
+}
+Value apiEntitySetCollider(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    int i = resolve(args, w);
+    if (i < 0 || args.size() < 3) return Value::nilVal();
+    int cid = args[2].isNumber() ? (int)args[2].numberVal : -1;
+    if (cid < 0) {
+        w->colliderId[i] = -1;
+        w->flags[i] &= (uint8_t)~EntityStore::HasCollider;
+        return Value::nilVal();
+    }
+    w->colliderId[i] = cid;
+    w->colW[i] = args.size() > 3 ? (float)args[3].numberVal : 0.0f;
+    w->colH[i] = args.size() > 4 ? (float)args[4].numberVal : 0.0f;
+    w->colOX[i] = args.size() > 5 ? (float)args[5].numberVal : 0.0f;
+    w->colOY[i] = args.size() > 6 ? (float)args[6].numberVal : 0.0f;
+    w->flags[i] |= EntityStore::HasCollider;
+    return Value::nilVal();
+}
+Value apiEntitySetAnim(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    int i = resolve(args, w);
+    if (i < 0 || args.size() < 3) return Value::nilVal();
+    int aid = args[2].isNumber() ? (int)args[2].numberVal : -1;
+    if (aid < 0) {
+        w->animId[i] = -1;
+        w->flags[i] &= (uint8_t)~EntityStore::HasAnim;
+        return Value::nilVal();
+    }
+    w->animId[i] = aid;
+    if (args.size() > 3 && args[3].isNumber()) w->animOX[i] = (float)args[3].numberVal;
+    if (args.size() > 4 && args[4].isNumber()) w->animOY[i] = (float)args[4].numberVal;
+    w->flags[i] |= EntityStore::HasAnim;
+    return Value::nilVal();
+}
+Value apiEntitySetNativeDraw(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    int i = resolve(args, w);
+    if (i < 0 || args.size() < 3) return Value::nilVal();
+    if (valueToBool(args[2])) w->flags[i] |= EntityStore::NativeDraw;
+    else w->flags[i] &= (uint8_t)~EntityStore::NativeDraw;
+    return Value::nilVal();
+}
+Value apiEntityPull(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    int i = resolve(args, w);
+    if (i < 0 || args.size() < 3 || !args[2].isMap() || !args[2].mapPtr) return Value::boolean(false);
+    auto& m = *args[2].mapPtr;
+    m["x"] = Value::number(w->x[i]);
+    m["y"] = Value::number(w->y[i]);
+    m["vx"] = Value::number(w->vx[i]);
+    m["vy"] = Value::number(w->vy[i]);
+    m["render_x"] = Value::number(w->renderX[i]);
+    m["render_y"] = Value::number(w->renderY[i]);
+    return Value::boolean(true);
+}
+Value apiEntityPush(const std::vector<Value>& args) {
+    EntityStore* w = nullptr;
+    int i = resolve(args, w);
+    if (i < 0 || args.size() < 3 || !args[2].isMap() || !args[2].mapPtr) return Value::boolean(false);
+    const Value& m = args[2];
+    w->x[i] = (float)fieldNumber(m, "x", w->x[i]);
+    w->y[i] = (float)fieldNumber(m, "y", w->y[i]);
+    w->vx[i] = (float)fieldNumber(m, "vx", w->vx[i]);
+    w->vy[i] = (float)fieldNumber(m, "vy", w->vy[i]);
+    syncToCollider(*w, i);
+    return Value::boolean(true);
+}
+} // namespace yuki
@@ -0,0 +1,22 @@
+#pragma once
+#include "../../script/value.hpp"
+#include <vector>
+
+namespace yuki {
+Value apiWorldCreate(const std::vector<Value>& args);
+Value apiWorldDestroy(const std::vector<Value>& args);
+Value apiWorldCount(const std::vector<Value>& args);
+Value apiWorldFixed(const std::vector<Value>& args);
+Value apiWorldDraw(const std::vector<Value>& args);
+Value apiEntityCreate(const std::vector<Value>& args);
+Value apiEntityDestroy(const std::vector<Value>& args);
+Value apiEntityAlive(const std::vector<Value>& args);
+Value apiEntitySetPosition(const std::vector<Value>& args);
+Value apiEntityGetPosition(const std::vector<Value>& args);
+Value apiEntitySetVelocity(const std::vector<Value>& args);
+Value apiEntitySetCollider(const std::vector<Value>& args);
+Value apiEntitySetAnim(const std::vector<Value>& args);
+Value apiEntitySetNativeDraw(const std::vector<Value>& args);
+Value apiEntityPull(const std::vector<Value>& args);
+Value apiEntityPush(const std::vector<Value>& args);
+} // namespace yuki
@@ -0,0 +1,82 @@
+#include "particle_api.hpp"
+#include "state.hpp"
+#include "value_utils.hpp"
+#include "../renderer2d.hpp"
+
+namespace yuki {
+namespace {
+BindingsState& st = bindingsState();
+
+ParticleSystem* getSystem(const Value& v) {
+    if (!v.isNumber()) return nullptr;
+    return st.particleSystems.get((int)v.numberVal);
+}
+
+float optNumber(const Value& opts, const char* key, float def) {
+    if (!opts.isMap() || !opts.mapPtr) return def;
+    auto it = opts.mapPtr->find(key);
+    if (it == opts.mapPtr->end() || !it->second.isNumber()) return def;
+    return (float)it->second.numberVal;
+}
+} // namespace
+
+Value apiParticlesCreate(const std::vector<Value>& args) {
+    size_t maxParticles = 4096;
+    if (!args.empty() && args[0].isNumber() && args[0].numberVal > 0) maxParticles = (size_t)args[0].numberVal;
+    return Value::number(st.particleSystems.insert(ParticleSystem(maxParticles)));
+}
+Value apiParticlesDestroy(const std::vector<Value>& args) {
+    if (args.empty() || !args[0].isNumber()) return Value::boolean(false);
+    return Value::boolean(st.particleSystems.erase((int)args[0].numberVal));
+}
+Value apiParticlesEmit(const std::vector<Value>& args) {
+    if (args.size() < 3) return Value::number(0);
+    auto* sys = getSystem(args[0]);
+    if (!sys) return Value::number(0);
+    int count = (args.size() > 3 && args[3].isNumber()) ? (int)args[3].numberVal : 1;
+    Value opts = args.size() > 4 ? args[4] : Value::nilVal();
+    ParticleEmitParams p;
+    p.speed = optNumber(opts, "speed", p.speed);
+    p.jitter = optNumber(opts, "jitter", p.jitter);
+    p.life = optNumber(opts, "life", p.life);
+    p.size = optNumber(opts, "size", p.size);
+    p.r = optNumber(opts, "r", p.r);
+    p.g = optNumber(opts, "g", p.g);
+    p.b = optNumber(opts, "b", p.b);
+    p.gravity = optNumber(opts, "gravity", p.gravity);
+    p.drag = optNumber(opts, "drag", p.drag);
+    p.sheetId = (int)optNumber(opts, "sheet_id", -1.0f);
+    p.frame = (int)optNumber(opts, "frame", 0.0f);
+    return Value::number(sys->emit((float)args[1].numberVal, (float)args[2].numberVal, count, p));
+}
+Value apiParticlesUpdate(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::nilVal();
+    auto* sys = getSystem(args[0]);
+    if (sys) sys->update((float)args[1].numberVal);
+    return Value::nilVal();
+}
+Value apiParticlesDraw(const std::vector<Value>& args) {
+    if (args.empty() || !st.renderer) return Value::nilVal();
+    auto* sys = getSystem(args[0]);
+    bool pixelSnap = args.size() > 1 ? valueToBool(args[1], true) : true;
+    if (sys) sys->draw(*st.renderer, pixelSnap);
+    return Value::nilVal();
+}
+Value apiParticlesCount(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(0);
+    auto* sys = getSystem(args[0]);
+    return Value::number(sys ? (double)sys->size() : 0.0);
+}
+Value apiParticlesClear(const std::vector<Value>& args) {
+    if (args.empty()) return Value::nilVal();
+    auto* sys = getSystem(args[0]);
+    if (sys) sys->clear();
+    return Value::nilVal();
+}
+Value apiParticlesSetAutoUpdate(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::nilVal();
+    auto* sys = getSystem(args[0]);
+    if (sys) sys->setAutoUpdate(valueToBool(args[1]));
+    return Value::nilVal();
+}
+} // namespace yuki
@@ -0,0 +1,14 @@
+#pragma once
+#include "../../script/value.hpp"
+#include <vector>
+
+namespace yuki {
+Value apiParticlesCreate(const std::vector<Value>& args);
+Value apiParticlesDestroy(const std::vector<Value>& args);
+Value apiParticlesEmit(const std::vector<Value>& args);
+Value apiParticlesUpdate(const std::vector<Value>& args);
+Value apiParticlesDraw(const std::vector<Value>& args);
+Value apiParticlesCount(const std::vector<Value>& args);
+Value apiParticlesClear(const std::vector<Value>& args);
+Value apiParticlesSetAutoUpdate(const std::vector<Value>& args);
+} // namespace yuki
@@ -12,4 +12,8 @@ void registerTweenBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
 void registerMathBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
 void registerAseBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
 void registerUiBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
+void registerParticleBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
+void registerEntityBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
+void registerSchedulerBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
+void registerAssetBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
 } // namespace yuki
@@ -266,4 +266,28 @@ Value apiCameraShake(const std::vector<Value>& args) {
     st.renderer->cameraShake(intensity, duration, freq);
     return Value::nilVal();
 }
+
+Value apiRenderStats(const std::vector<Value>& args) {
+    (void)args;
+    if (!st.renderer) return Value::map({});
+    const RenderStats& rs = st.renderer->getStats();
+    std::unordered_map<std::string, Value> m;
+    m["flushes"] = Value::number(rs.flushes);
+    m["rects"] = Value::number(rs.commands[(int)RenderCmdType::Rect]);
+    m["sprites"] = Value::number(rs.commands[(int)RenderCmdType::Sprite]);
+    m["sprite_frames"] = Value::number(rs.commands[(int)RenderCmdType::SpriteFrame]);
+    m["texts"] = Value::number(rs.commands[(int)RenderCmdType::Text]);
+    m["particle_draws"] = Value::number(rs.commands[(int)RenderCmdType::Particles]);
+    m["particles"] = Value::number(rs.particleQuads);
+    m["debug"] = Value::number(rs.debugCommands);
+    m["batches"] = Value::number(rs.batches);
+    m["vertices"] = Value::number(rs.vertices);
+    m["texture_binds"] = Value::number(rs.textureBinds);
+    m["texture_breaks"] = Value::number(rs.textureBreaks);
+    m["mode_breaks"] = Value::number(rs.modeBreaks);
+    m["vertex_bytes"] = Value::number((double)rs.vertexBytes);
+    m["texture_bytes"] = Value::number((double)rs.textureBytes);
+    m["gpu_ms"] = rs.gpuMs >= 0.0 ? Value::number(rs.gpuMs) : Value::nilVal();
+    return Value::map(m);
+}
 } // namespace yuki
@@ -29,4 +29,5 @@ Value apiCameraSetPixelSnap(const std::vector<Value>& args);
 Value apiCameraSetBounds(const std::vector<Value>& args);
 Value apiCameraClearBounds(const std::vector<Value>& args);
 Value apiCameraShake(const std::vector<Value>& args);
+Value apiRenderStats(const std::vector<Value>& args);
 } // namespace yuki
@@ -0,0 +1,70 @@
+#include "scheduler_api.hpp"
+#include "state.hpp"
+
+namespace yuki {
+namespace {
+BindingsState& st = bindingsState();
+
+FrameScheduler* getScheduler(const Value& v) {
+    if (!v.isNumber()) return nullptr;
+    auto it = st.schedulers.find((int)v.numberVal);
+    if (it == st.schedulers.end()) return nullptr;
+    return &it->second;
+}
+} // namespace
+
+Value apiSchedulerCreate(const std::vector<Value>& args) {
+    int id = st.schedulerCounter++;
+    FrameScheduler& s = st.schedulers[id];
+    if (args.size() > 0 && args[0].isNumber()) s.setFixedDt(args[0].numberVal);
+    if (args.size() > 1 && args[1].isNumber()) s.setMaxFixedSteps((int)args[1].numberVal);
+    return Value::number(id);
+}
+Value apiSchedulerDestroy(const std::vector<Value>& args) {
+    if (args.empty() || !args[0].isNumber()) return Value::boolean(false);
+    return Value::boolean(st.schedulers.erase((int)args[0].numberVal) > 0);
+}
+Value apiSchedulerAdd(const std::vector<Value>& args) {
+    if (args.size() < 3) return Value::boolean(false);
+    auto* s = getScheduler(args[0]);
+    if (!s) return Value::boolean(false);
+    SchedulePhase phase;
+    if (!FrameScheduler::parsePhase(args[1].toString(), phase)) {
+        if (st.interpreter) st.interpreter->runtimeError("unknown phase: " + args[1].toString());
+        return Value::boolean(false);
+    }
+    if (!args[2].isFunction()) return Value::boolean(false);
+    s->add(phase, args[2]);
+    return Value::boolean(true);
+}
+Value apiSchedulerTick(const std::vector<Value>& args) {
+    if (args.size() < 2 || !st.interpreter) return Value::nilVal();
+    auto* s = getScheduler(args[0]);
+    if (!s) return Value::nilVal();
+    Value ctx = args.size() > 2 ? args[2] : Value::nilVal();
+    s->tick(*st.interpreter, args[1].numberVal, ctx);
+    return Value::nilVal();
+}
+Value apiSchedulerSetFixedDt(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::nilVal();
+    auto* s = getScheduler(args[0]);
+    if (s && args[1].isNumber()) s->setFixedDt(args[1].numberVal);
+    return Value::nilVal();
+}
+Value apiSchedulerSetMaxSteps(const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::nilVal();
+    auto* s = getScheduler(args[0]);
+    if (s && args[1].isNumber()) s->setMaxFixedSteps((int)args[1].numberVal);
+    return Value::nilVal();
+}
+Value apiSchedulerAlpha(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(0);
+    auto* s = getScheduler(args[0]);
+    return Value::number(s ? s->alpha() : 0.0);
+}
+Value apiSchedulerFixedSteps(const std::vector<Value>& args) {
+    if (args.empty()) return Value::number(0);
+    auto* s = getScheduler(args[0]);
+    return Value::number(s ? s->lastFixedSteps() : 0);
+}
+} // namespace yuki
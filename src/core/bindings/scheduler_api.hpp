@@ -0,0 +1,14 @@
+#pragma once
+#include "../../script/value.hpp"
+#include <vector>
+
+namespace yuki {
+Value apiSchedulerCreate(const std::vector<Value>& args);
+Value apiSchedulerDestroy(const std::vector<Value>& args);
+Value apiSchedulerAdd(const std::vector<Value>& args);
+Value apiSchedulerTick(const std::vector<Value>& args);
+Value apiSchedulerSetFixedDt(const std::vector<Value>& args);
+Value apiSchedulerSetMaxSteps(const std::vector<Value>& args);
+Value apiSchedulerAlpha(const std::vector<Value>& args);
+Value apiSchedulerFixedSteps(const std::vector<Value>& args);
+} // namespace yuki
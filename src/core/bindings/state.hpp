@@ -5,10 +5,17 @@
 #include <unordered_set>
 #include <filesystem>
 #include <limits>
+#include <memory>
 #include "../renderer2d.hpp"
+#include "../particles.hpp"
+#include "../entity_store.hpp"
+#include "../slot_map.hpp"
+#include "../easing.hpp"
+#include "../aseprite_loader.hpp"
 #include "../window.hpp"
 #include "../../script/value.hpp"
 #include "../../script/interpreter.hpp"
+#include "../../runtime/frame_scheduler.hpp"
 
 namespace yuki {
 struct Area {
@@ -29,21 +36,62 @@ struct SpriteState {
     bool overrideScaleX = false;
     bool overrideScaleY = false;
     bool overrideAlpha = false;
+    bool used = false;
 };
 
+enum class AnimDirection { Forward, Reverse, PingPong };
+
 struct Animation {
     int id = -1;
     int sheetId = -1;
     std::vector<int> frames;
+    // Prefix sums of per-frame durations in seconds (frameEnd[i] = end of
+    // frame i). Empty means every frame lasts 1/fps.
+    std::vector<double> frameEnd;
+    AnimDirection direction = AnimDirection::Forward;
     double fps = 0.0;
     bool loop = false;
-    double accumulator = 0.0;
+    double accumulator = 0.0; // playback time within the current cycle
     int currentIndex = 0;
     bool playing = false;
     SpriteTransform transform;
     float alpha = 1.0f;
 };
 
+// Data-driven animation state machine. Each state is a clip (usually an
+// Aseprite tag); transitions fire on numeric parameters and/or exit time.
+struct AnimatorCondition {
+    enum class Op { Greater, Less, GreaterEqual, LessEqual, Equal, NotEqual };
+    int param = -1;
+    Op op = Op::Greater;
+    double value = 0.0;
+};
+struct AnimatorTransition {
+    int from = -1; // -1 = any state
+    int to = -1;
+    std::vector<AnimatorCondition> conditions;
+    double exitTime = -1.0; // normalized clip time, < 0 = none
+};
+struct AnimatorState {
+    std::string name;
+    int sheetId = -1;
+    std::vector<int> frames;
+    std::vector<double> frameEnd;
+    AnimDirection direction = AnimDirection::Forward;
+    double fps = 0.0;
+    bool loop = true;
+};
+struct Animator {
+    int id = -1;
+    int animId = -1;
+    std::vector<AnimatorState> states;
+    std::vector<AnimatorTransition> transitions;
+    std::vector<std::string> paramNames;
+    std::vector<double> params;
+    int current = -1;
+    double stateTime = 0.0;
+};
+
 struct Collider {
     float x = 0.0f;
     float y = 0.0f;
@@ -55,6 +103,7 @@ struct Collider {
 
 enum class TweenTargetType { None, Sprite, Animation };
 enum class TweenType { Value, Property };
+enum class TweenProperty { None, X, Y, Rotation, ScaleX, ScaleY, Alpha };
 struct TweenTarget {
     TweenTargetType type = TweenTargetType::None;
     int id = -1;
@@ -69,11 +118,14 @@ struct Tween {
     bool active = false;
     bool paused = false;
     bool canceled = false;
-    std::string easing = "linear";
+    Easing easing = Easing::Linear;
+    CubicBezier bezier;
     double current = 0.0;
     TweenTarget target;
-    std::string property;
+    TweenProperty property = TweenProperty::None;
     Value onComplete = Value::nilVal();
+    int sequenceOwner = -1;
+    int parallelOwner = -1;
 };
 struct Sequence {
     int id = -1;
@@ -89,6 +141,21 @@ struct ParallelGroup {
     bool finished = false;
 };
 
+enum class AssetKind { Sprite, SpriteSheet, Font, Ase };
+enum class AssetStatus { Pending, Ready, Failed };
+struct AssetDecode; // worker-side payload, see asset_api.cpp
+
+struct AsyncAsset {
+    AssetKind kind = AssetKind::Sprite;
+    AssetStatus status = AssetStatus::Pending;
+    std::string path;
+    std::string metricsPath;
+    int frameW = 0;
+    int frameH = 0;
+    int resultId = -1;
+    std::shared_ptr<AssetDecode> decode; // dropped once uploaded
+};
+
 struct BindingsState {
     Window* window = nullptr;
     Renderer2D* renderer = nullptr;
@@ -97,25 +164,30 @@ struct BindingsState {
     std::vector<std::filesystem::path> importPaths;
     std::unordered_set<std::string> loadedModules;
     std::unordered_map<std::string, Value> moduleExports;
+    std::unordered_map<std::string, std::shared_ptr<Environment>> moduleEnvs; // for hot reload
+    std::unordered_set<std::string> injectedModules; // exports copied into globals by import()
     std::vector<std::filesystem::path> moduleDirStack;
 
     std::vector<Area> areas;
     std::unordered_map<std::string, bool> areaState;
 
-    std::unordered_map<int, SpriteState> spriteStates;
-    std::unordered_map<int, Animation> animations;
-    int animationCounter = 1;
+    std::vector<SpriteState> spriteStates; // indexed by sprite id
+    SlotMap<Animation> animations;
+    SlotMap<Animator> animators;
 
     std::vector<Collider> colliders;
 
-    std::unordered_map<int, Tween> tweens;
-    std::unordered_map<int, Sequence> sequences;
-    std::unordered_map<int, ParallelGroup> parallels;
-    std::unordered_map<int, int> tweenSequenceOwner;
-    std::unordered_map<int, int> tweenParallelOwner;
-    int tweenCounter = 1;
-    int sequenceCounter = 1;
-    int parallelCounter = 1;
+    SlotMap<ParticleSystem> particleSystems;
+
+    std::unordered_map<int, EntityStore> entityWorlds;
+    int entityWorldCounter = 1;
+
+    std::unordered_map<int, FrameScheduler> schedulers;
+    int schedulerCounter = 1;
+
+    SlotMap<Tween> tweens;
+    SlotMap<Sequence> sequences;
+    SlotMap<ParallelGroup> parallels;
 
     struct AseAsset {
         int id = -1;
@@ -126,9 +198,19 @@ struct BindingsState {
         std::filesystem::file_time_type lastWriteTime;
         std::unordered_map<std::string, std::vector<int>> tagFrames;
         std::unordered_map<std::string, double> tagFps;
+        std::unordered_map<std::string, std::vector<double>> tagFrameEnd;
+        std::unordered_map<std::string, AnimDirection> tagDirection;
+        // Last decode uploaded to the sheet; hot reload diffs against it.
+        std::shared_ptr<const AseData> decoded;
     };
     std::unordered_map<int, AseAsset> aseAssets;
     int aseCounter = 1;
+
+    SlotMap<AsyncAsset> asyncAssets;
+    std::vector<int> asyncUploadQueue; // handles in request order
+    int asyncRequested = 0;
+    int asyncFinished = 0;
+    double asyncUploadBudgetMs = 4.0;
 };
 
 BindingsState& bindingsState();
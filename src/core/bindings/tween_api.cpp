@@ -1,5 +1,7 @@
 #include "tween_api.hpp"
 #include "state.hpp"
+#include "../easing.hpp"
+#include "../job_system.hpp"
 #include "../renderer2d.hpp"
 #include "../../script/interpreter.hpp"
 
@@ -7,68 +9,137 @@ namespace yuki {
 namespace {
 BindingsState& st = bindingsState();
 
+constexpr int kMaxSpriteStates = 1 << 16;
+constexpr size_t kEaseGrain = 4096;
+
+struct EaseSpec {
+    Easing easing = Easing::Linear;
+    CubicBezier bezier;
+};
+
+// Scratch for the per-frame evaluation pass; kept across frames so the pass
+// does not allocate once it has warmed up.
+struct TweenEvalScratch {
+    std::vector<uint32_t> running;
+    std::vector<uint32_t> order;
+    std::vector<double> u;
+    size_t counts[(size_t)Easing::Count] = {};
+    size_t offsets[(size_t)Easing::Count + 1] = {};
+};
+TweenEvalScratch scratch;
+
+// Completion callbacks queued by the native pass and dispatched afterwards on
+// the main thread. Both vectors keep their capacity between frames.
+std::vector<Value> pendingCallbacks;
+std::vector<Value> dispatchQueue;
+const std::vector<Value> callbackArgs;
+
 double clamp01(double v) {
     if (v < 0.0) return 0.0;
     if (v > 1.0) return 1.0;
     return v;
 }
-double applyEasing(double t, const std::string& easing) {
-    double u = clamp01(t);
-    if (easing == "ease_in") return u * u;
-    if (easing == "ease_out") return u * (2.0 - u);
-    if (easing == "ease_in_out") {
-        if (u < 0.5) return 2.0 * u * u;
-        double k = -2.0 * u + 2.0;
-        return 1.0 - (k * k) / 2.0;
+EaseSpec parseEase(const Value& v) {
+    EaseSpec spec;
+    if (v.isString()) {
+        parseEasing(v.stringVal, spec.easing);
+    } else if (v.isArray() && v.arrayPtr && v.arrayPtr->size() >= 4) {
+        const auto& arr = *v.arrayPtr;
+        spec.easing = Easing::Bezier;
+        spec.bezier.x1 = clamp01(arr[0].numberVal);
+        spec.bezier.y1 = arr[1].numberVal;
+        spec.bezier.x2 = clamp01(arr[2].numberVal);
+        spec.bezier.y2 = arr[3].numberVal;
     }
-    return u;
+    return spec;
+}
+EaseSpec easeOf(Easing e) {
+    EaseSpec spec;
+    spec.easing = e;
+    return spec;
+}
+TweenProperty parseProperty(const std::string& prop) {
+    if (prop == "x") return TweenProperty::X;
+    if (prop == "y") return TweenProperty::Y;
+    if (prop == "rotation") return TweenProperty::Rotation;
+    if (prop == "scale_x") return TweenProperty::ScaleX;
+    if (prop == "scale_y") return TweenProperty::ScaleY;
+    if (prop == "alpha") return TweenProperty::Alpha;
+    return TweenProperty::None;
+}
+
+SpriteState* findSpriteState(int id) {
+    if (id < 0 || id >= (int)st.spriteStates.size()) return nullptr;
+    SpriteState& s = st.spriteStates[(size_t)id];
+    return s.used ? &s : nullptr;
+}
+SpriteState* touchSpriteState(int id) {
+    if (id < 0 || id >= kMaxSpriteStates) return nullptr;
+    if (id >= (int)st.spriteStates.size()) st.spriteStates.resize((size_t)id + 1);
+    SpriteState& s = st.spriteStates[(size_t)id];
+    s.used = true;
+    return &s;
 }
 
-bool getPropertyValue(const TweenTarget& target, const std::string& prop, float& out) {
+bool getPropertyValue(const TweenTarget& target, TweenProperty prop, float& out) {
     if (target.type == TweenTargetType::Sprite) {
-        auto it = st.spriteStates.find(target.id);
-        if (it == st.spriteStates.end()) return false;
-        const auto& s = it->second;
-        if (prop == "x") { out = s.x; return true; }
-        if (prop == "y") { out = s.y; return true; }
-        if (prop == "rotation") { out = s.rotation; return true; }
-        if (prop == "scale_x") { out = s.scaleX; return true; }
-        if (prop == "scale_y") { out = s.scaleY; return true; }
-        if (prop == "alpha") { out = s.alpha; return true; }
+        const SpriteState* sp = findSpriteState(target.id);
+        if (!sp) return false;
+        const auto& s = *sp;
+        switch (prop) {
+        case TweenProperty::X: out = s.x; return true;
+        case TweenProperty::Y: out = s.y; return true;
+        case TweenProperty::Rotation: out = s.rotation; return true;
+        case TweenProperty::ScaleX: out = s.scaleX; return true;
+        case TweenProperty::ScaleY: out = s.scaleY; return true;
+        case TweenProperty::Alpha: out = s.alpha; return true;
+        case TweenProperty::None: return false;
+        }
     }
     if (target.type == TweenTargetType::Animation) {
-        auto it = st.animations.find(target.id);
-        if (it == st.animations.end()) return false;
-        const auto& a = it->second;
-        if (prop == "x") { out = a.transform.x; return true; }
-        if (prop == "y") { out = a.transform.y; return true; }
-        if (prop == "rotation") { out = a.transform.rotationDeg; return true; }
-        if (prop == "scale_x") { out = a.transform.scaleX; return true; }
-        if (prop == "scale_y") { out = a.transform.scaleY; return true; }
-        if (prop == "alpha") { out = a.alpha; return true; }
+        const Animation* ap = st.animations.get(target.id);
+        if (!ap) return false;
+        const auto& a = *ap;
+        switch (prop) {
+        case TweenProperty::X: out = a.transform.x; return true;
+        case TweenProperty::Y: out = a.transform.y; return true;
+        case TweenProperty::Rotation: out = a.transform.rotationDeg; return true;
+        case TweenProperty::ScaleX: out = a.transform.scaleX; return true;
+        case TweenProperty::ScaleY: out = a.transform.scaleY; return true;
+        case TweenProperty::Alpha: out = a.alpha; return true;
+        case TweenProperty::None: return false;
+        }
     }
     return false;
 }
-void setPropertyValue(const TweenTarget& target, const std::string& prop, float v) {
+void setPropertyValue(const TweenTarget& target, TweenProperty prop, float v) {
     if (target.type == TweenTargetType::Sprite) {
-        auto& s = st.spriteStates[target.id];
-        if (prop == "x") { s.x = v; s.overrideX = true; }
-        else if (prop == "y") { s.y = v; s.overrideY = true; }
-        else if (prop == "rotation") { s.rotation = v; s.overrideRot = true; }
-        else if (prop == "scale_x") { s.scaleX = v; s.overrideScaleX = true; }
-        else if (prop == "scale_y") { s.scaleY = v; s.overrideScaleY = true; }
-        else if (prop == "alpha") { s.alpha = v; s.overrideAlpha = true; }
+        SpriteState* sp = touchSpriteState(target.id);
+        if (!sp) return;
+        auto& s = *sp;
+        switch (prop) {
+        case TweenProperty::X: s.x = v; s.overrideX = true; break;
+        case TweenProperty::Y: s.y = v; s.overrideY = true; break;
+        case TweenProperty::Rotation: s.rotation = v; s.overrideRot = true; break;
+        case TweenProperty::ScaleX: s.scaleX = v; s.overrideScaleX = true; break;
+        case TweenProperty::ScaleY: s.scaleY = v; s.overrideScaleY = true; break;
+        case TweenProperty::Alpha: s.alpha = v; s.overrideAlpha = true; break;
+        case TweenProperty::None: break;
+        }
     }
     if (target.type == TweenTargetType::Animation) {
-        auto it = st.animations.find(target.id);
-        if (it == st.animations.end()) return;
-        auto& a = it->second;
-        if (prop == "x") a.transform.x = v;
-        else if (prop == "y") a.transform.y = v;
-        else if (prop == "rotation") a.transform.rotationDeg = v;
-        else if (prop == "scale_x") a.transform.scaleX = v;
-        else if (prop == "scale_y") a.transform.scaleY = v;
-        else if (prop == "alpha") a.alpha = v;
+        Animation* ap = st.animations.get(target.id);
+        if (!ap) return;
+        auto& a = *ap;
+        switch (prop) {
+        case TweenProperty::X: a.transform.x = v; break;
+        case TweenProperty::Y: a.transform.y = v; break;
+        case TweenProperty::Rotation: a.transform.rotationDeg = v; break;
+        case TweenProperty::ScaleX: a.transform.scaleX = v; break;
+        case TweenProperty::ScaleY: a.transform.scaleY = v; break;
+        case TweenProperty::Alpha: a.alpha = v; break;
+        case TweenProperty::None: break;
+        }
     }
 }
 TweenTarget parseTarget(const Value& obj) {
@@ -80,7 +151,7 @@ TweenTarget parseTarget(const Value& obj) {
         if (it != obj.mapPtr->end() && it->second.isNumber()) id = (int)it->second.numberVal;
     }
     if (id >= 0) {
-        if (st.animations.find(id) != st.animations.end()) {
+        if (st.animations.contains(id)) {
             tgt.type = TweenTargetType::Animation;
             tgt.id = id;
         } else {
@@ -90,9 +161,10 @@ TweenTarget parseTarget(const Value& obj) {
     }
     return tgt;
 }
-int nextTweenId() { return st.tweenCounter++; }
-int nextSequenceId() { return st.sequenceCounter++; }
-int nextParallelId() { return st.parallelCounter++; }
+Tween* getTween(const Value& v) {
+    if (!v.isNumber()) return nullptr;
+    return st.tweens.get((int)v.numberVal);
+}
 void resetTween(Tween& t, bool pause, bool refreshProperty) {
     if (refreshProperty && t.type == TweenType::Property) {
         float cur = (float)t.from;
@@ -108,61 +180,110 @@ void finishTween(Tween& t) {
     t.active = false;
     t.paused = false;
 }
-void invokeTweenCallback(Tween& t) {
-    if (!st.interpreter) return;
-    if (t.onComplete.isFunction()) {
-        std::vector<Value> args;
-        st.interpreter->callFunction(t.onComplete, args);
-    }
+int insertTween(Tween t) {
+    int id = st.tweens.insert(std::move(t));
+    if (Tween* stored = st.tweens.get(id)) stored->id = id;
+    return id;
 }
-int createValueTween(double from, double to, double duration, const std::string& easing) {
-    int id = nextTweenId();
+int createValueTween(double from, double to, double duration, const EaseSpec& ease) {
     Tween t;
-    t.id = id;
     t.type = TweenType::Value;
     t.from = from;
     t.to = to;
     t.duration = duration;
-    t.easing = easing;
+    t.easing = ease.easing;
+    t.bezier = ease.bezier;
     resetTween(t, false, false);
-    st.tweens[id] = t;
-    return id;
+    return insertTween(std::move(t));
 }
-int createPropertyTween(const TweenTarget& target, const std::string& prop, double to, double duration, const std::string& easing) {
-    int id = nextTweenId();
+int createPropertyTween(const TweenTarget& target, TweenProperty prop, double to, double duration, const EaseSpec& ease) {
     Tween t;
-    t.id = id;
     t.type = TweenType::Property;
     t.from = 0.0;
     t.to = to;
     t.duration = duration;
-    t.easing = easing;
+    t.easing = ease.easing;
+    t.bezier = ease.bezier;
     t.target = target;
     t.property = prop;
     float cur = 0.0f;
     if (getPropertyValue(target, prop, cur)) t.from = cur;
     resetTween(t, false, false);
-    st.tweens[id] = t;
-    return id;
+    return insertTween(std::move(t));
 }
-void updateTween(Tween& t, double dt) {
-    if (t.canceled || t.paused || !t.active) return;
-    t.elapsed += dt;
-    double raw = t.elapsed / t.duration;
-    double u = applyEasing(raw, t.easing);
-    t.current = t.from + (t.to - t.from) * u;
-    if (t.type == TweenType::Property) {
-        setPropertyValue(t.target, t.property, (float)t.current);
+
+// Advances every running tween (standalone or owned by a group) in one pass:
+// progress is gathered into a contiguous array grouped by easing, each group is
+// eased by a single tight loop, then values are written back. Nothing here
+// calls into the interpreter; completions are only queued.
+void evaluateTweens(double dt) {
+    auto& s = scratch;
+    s.running.clear();
+    for (auto& c : s.counts) c = 0;
+    size_t n = st.tweens.size();
+    Tween* tweens = st.tweens.data();
+    for (size_t i = 0; i < n; ++i) {
+        Tween& t = tweens[i];
+        if (!t.active || t.paused || t.canceled) continue;
+        t.elapsed += dt;
+        s.running.push_back((uint32_t)i);
+        s.counts[(size_t)t.easing]++;
+    }
+    size_t running = s.running.size();
+    if (running == 0) return;
+    s.offsets[0] = 0;
+    for (size_t k = 0; k < (size_t)Easing::Count; ++k) s.offsets[k + 1] = s.offsets[k] + s.counts[k];
+    s.order.resize(running);
+    s.u.resize(running);
+    size_t cursor[(size_t)Easing::Count];
+    for (size_t k = 0; k < (size_t)Easing::Count; ++k) cursor[k] = s.offsets[k];
+    for (uint32_t idx : s.running) {
+        const Tween& t = tweens[idx];
+        size_t pos = cursor[(size_t)t.easing]++;
+        s.order[pos] = idx;
+        s.u[pos] = t.duration > 0.0 ? clamp01(t.elapsed / t.duration) : 1.0;
+    }
+    for (size_t k = 0; k < (size_t)Easing::Count; ++k) {
+        size_t begin = s.offsets[k];
+        size_t count = s.counts[k];
+        if (count == 0) continue;
+        if ((Easing)k == Easing::Bezier) {
+            for (size_t p = begin; p < begin + count; ++p) s.u[p] = tweens[s.order[p]].bezier.eval(s.u[p]);
+        } else {
+            double* u = s.u.data() + begin;
+            Easing e = (Easing)k;
+            jobSystem().parallelFor(count, kEaseGrain, [u, e](size_t b, size_t end) { applyEasingBatch(e, u + b, end - b); });
+        }
     }
-    if (t.elapsed >= t.duration) {
-        t.current = t.to;
-        if (t.type == TweenType::Property) {
-            setPropertyValue(t.target, t.property, (float)t.current);
+    for (size_t p = 0; p < running; ++p) {
+        Tween& t = tweens[s.order[p]];
+        bool done = t.elapsed >= t.duration;
+        t.current = done ? t.to : t.from + (t.to - t.from) * s.u[p];
+        if (t.type == TweenType::Property) setPropertyValue(t.target, t.property, (float)t.current);
+        if (done) {
+            finishTween(t);
+            if (t.onComplete.isFunction()) pendingCallbacks.push_back(t.onComplete);
         }
-        finishTween(t);
-        invokeTweenCallback(t);
     }
 }
+int createSequence(Sequence s) {
+    int id = st.sequences.insert(std::move(s));
+    Sequence* stored = st.sequences.get(id);
+    if (stored) {
+        stored->id = id;
+        for (size_t k = 0; k < stored->tweens.size(); ++k) {
+            Tween* t = st.tweens.get(stored->tweens[k]);
+            if (!t) continue;
+            t->sequenceOwner = id;
+            // Later steps wait for their turn; they re-read their start value then.
+            if (k > 0) t->paused = true;
+        }
+    }
+    return id;
+}
+void eraseGroupTweens(const std::vector<int>& tweens) {
+    for (int tid : tweens) st.tweens.erase(tid);
+}
 } // namespace
 
 // Public API wrappers
@@ -171,124 +292,99 @@ Value apiTweenValue(const std::vector<Value>& args) {
     double from = args[0].numberVal;
     double to = args[1].numberVal;
     double dur = args[2].numberVal;
-    std::string easing = "linear";
-    if (args.size() >= 4 && args[3].isString()) easing = args[3].stringVal;
-    int id = createValueTween(from, to, dur, easing);
+    EaseSpec ease = args.size() >= 4 ? parseEase(args[3]) : EaseSpec{};
+    int id = createValueTween(from, to, dur, ease);
     return Value::number(id);
 }
 Value apiTweenValueGet(const std::vector<Value>& args) {
     if (args.empty()) return Value::number(0);
-    int id = (int)args[0].numberVal;
-    auto it = st.tweens.find(id);
-    if (it == st.tweens.end()) return Value::number(0);
-    return Value::number(it->second.current);
+    Tween* t = getTween(args[0]);
+    if (!t) return Value::number(0);
+    return Value::number(t->current);
 }
 Value apiTweenProperty(const std::vector<Value>& args) {
     if (args.size() < 4) return Value::number(-1);
     TweenTarget tgt = parseTarget(args[0]);
-    std::string prop = args[1].toString();
+    TweenProperty prop = parseProperty(args[1].toString());
     double to = args[2].numberVal;
     double duration = args[3].numberVal;
-    std::string easing = "linear";
-    if (args.size() >= 5 && args[4].isString()) easing = args[4].stringVal;
-    int id = createPropertyTween(tgt, prop, to, duration, easing);
+    EaseSpec ease = args.size() >= 5 ? parseEase(args[4]) : EaseSpec{};
+    int id = createPropertyTween(tgt, prop, to, duration, ease);
     return Value::number(id);
 }
 Value apiTweenSequenceStart(const std::vector<Value>&) {
-    int id = nextSequenceId();
-    Sequence seq;
-    seq.id = id;
-    st.sequences[id] = seq;
-    return Value::number(id);
+    return Value::number(createSequence(Sequence{}));
 }
 Value apiTweenSequenceAdd(const std::vector<Value>& args) {
     if (args.size() < 2) return Value::nilVal();
     int seqId = (int)args[0].numberVal;
-    int tweenId = (int)args[1].numberVal;
-    auto it = st.sequences.find(seqId);
-    auto tw = st.tweens.find(tweenId);
-    if (it == st.sequences.end() || tw == st.tweens.end()) return Value::nilVal();
-    it->second.tweens.push_back(tweenId);
-    st.tweenSequenceOwner[tweenId] = seqId;
-    resetTween(tw->second, true, true);
+    Sequence* seq = st.sequences.get(seqId);
+    Tween* tw = getTween(args[1]);
+    if (!seq || !tw) return Value::nilVal();
+    seq->tweens.push_back(tw->id);
+    tw->sequenceOwner = seqId;
+    resetTween(*tw, true, true);
     return Value::nilVal();
 }
 Value apiTweenSequencePlay(const std::vector<Value>& args) {
     if (args.empty()) return Value::nilVal();
-    int seqId = (int)args[0].numberVal;
-    auto it = st.sequences.find(seqId);
-    if (it == st.sequences.end()) return Value::nilVal();
-    it->second.playing = true;
-    it->second.currentIndex = 0;
-    if (!it->second.tweens.empty()) {
-        int tid = it->second.tweens[0];
-        auto tw = st.tweens.find(tid);
-        if (tw != st.tweens.end()) resetTween(tw->second, false, true);
+    Sequence* seq = st.sequences.get((int)args[0].numberVal);
+    if (!seq) return Value::nilVal();
+    seq->playing = true;
+    seq->currentIndex = 0;
+    if (!seq->tweens.empty()) {
+        if (Tween* tw = st.tweens.get(seq->tweens[0])) resetTween(*tw, false, true);
     }
     return Value::nilVal();
 }
 Value apiTweenParallelStart(const std::vector<Value>&) {
-    int id = nextParallelId();
-    ParallelGroup grp;
-    grp.id = id;
-    st.parallels[id] = grp;
+    int id = st.parallels.insert(ParallelGroup{});
+    if (ParallelGroup* grp = st.parallels.get(id)) grp->id = id;
     return Value::number(id);
 }
 Value apiTweenParallelAdd(const std::vector<Value>& args) {
     if (args.size() < 2) return Value::nilVal();
     int pid = (int)args[0].numberVal;
-    int tid = (int)args[1].numberVal;
-    auto it = st.parallels.find(pid);
-    auto tw = st.tweens.find(tid);
-    if (it == st.parallels.end() || tw == st.tweens.end()) return Value::nilVal();
-    it->second.tweens.push_back(tid);
-    st.tweenParallelOwner[tid] = pid;
-    resetTween(tw->second, true, true);
+    ParallelGroup* grp = st.parallels.get(pid);
+    Tween* tw = getTween(args[1]);
+    if (!grp || !tw) return Value::nilVal();
+    grp->tweens.push_back(tw->id);
+    tw->parallelOwner = pid;
+    resetTween(*tw, true, true);
     return Value::nilVal();
 }
 Value apiTweenParallelPlay(const std::vector<Value>& args) {
     if (args.empty()) return Value::nilVal();
-    int pid = (int)args[0].numberVal;
-    auto it = st.parallels.find(pid);
-    if (it == st.parallels.end()) return Value::nilVal();
-    it->second.playing = true;
-    for (int tid : it->second.tweens) {
-        auto tw = st.tweens.find(tid);
-        if (tw != st.tweens.end()) resetTween(tw->second, false, true);
+    ParallelGroup* grp = st.parallels.get((int)args[0].numberVal);
+    if (!grp) return Value::nilVal();
+    grp->playing = true;
+    for (int tid : grp->tweens) {
+        if (Tween* tw = st.tweens.get(tid)) resetTween(*tw, false, true);
     }
     return Value::nilVal();
 }
 Value apiTweenPause(const std::vector<Value>& args) {
     if (args.empty()) return Value::nilVal();
-    int id = (int)args[0].numberVal;
-    auto it = st.tweens.find(id);
-    if (it != st.tweens.end()) it->second.paused = true;
+    if (Tween* t = getTween(args[0])) t->paused = true;
     return Value::nilVal();
 }
 Value apiTweenResume(const std::vector<Value>& args) {
     if (args.empty()) return Value::nilVal();
-    int id = (int)args[0].numberVal;
-    auto it = st.tweens.find(id);
-    if (it != st.tweens.end()) it->second.paused = false;
+    if (Tween* t = getTween(args[0])) t->paused = false;
     return Value::nilVal();
 }
 Value apiTweenCancel(const std::vector<Value>& args) {
     if (args.empty()) return Value::nilVal();
-    int id = (int)args[0].numberVal;
-    auto it = st.tweens.find(id);
-    if (it != st.tweens.end()) {
-        it->second.canceled = true;
-        finishTween(it->second);
+    if (Tween* t = getTween(args[0])) {
+        t->canceled = true;
+        finishTween(*t);
     }
     return Value::nilVal();
 }
 Value apiTweenOnComplete(const std::vector<Value>& args) {
     if (args.size() < 2) return Value::nilVal();
-    int id = (int)args[0].numberVal;
-    auto it = st.tweens.find(id);
-    if (it != st.tweens.end() && args[1].isFunction()) {
-        it->second.onComplete = args[1];
-    }
+    Tween* t = getTween(args[0]);
+    if (t && args[1].isFunction()) t->onComplete = args[1];
     return Value::nilVal();
 }
 
@@ -301,25 +397,20 @@ Value apiShake(const std::vector<Value>& args) {
     int freq = (int)args[3].numberVal;
     float baseX = 0.0f;
     float baseY = 0.0f;
-    getPropertyValue(tgt, "x", baseX);
-    getPropertyValue(tgt, "y", baseY);
-    int seqId = nextSequenceId();
+    getPropertyValue(tgt, TweenProperty::X, baseX);
+    getPropertyValue(tgt, TweenProperty::Y, baseY);
     Sequence s;
-    s.id = seqId;
     double step = duration / (double)freq;
     for (int i = 0; i < freq; ++i) {
         double ox = ((i % 2 == 0) ? intensity : -intensity);
         double oy = ((i % 2 == 0) ? -intensity : intensity);
-        int tx = createPropertyTween(tgt, "x", baseX + ox, step * 0.5, "linear");
-        int ty = createPropertyTween(tgt, "y", baseY + oy, step * 0.5, "linear");
+        int tx = createPropertyTween(tgt, TweenProperty::X, baseX + ox, step * 0.5, easeOf(Easing::Linear));
+        int ty = createPropertyTween(tgt, TweenProperty::Y, baseY + oy, step * 0.5, easeOf(Easing::Linear));
         s.tweens.push_back(tx);
         s.tweens.push_back(ty);
-        st.tweenSequenceOwner[tx] = seqId;
-        st.tweenSequenceOwner[ty] = seqId;
     }
     s.playing = true;
-    st.sequences[seqId] = s;
-    return Value::number(seqId);
+    return Value::number(createSequence(std::move(s)));
 }
 Value apiSquash(const std::vector<Value>& args) {
     if (args.size() < 3) return Value::number(-1);
@@ -328,21 +419,17 @@ Value apiSquash(const std::vector<Value>& args) {
     double duration = args[2].numberVal;
     float baseX = 1.0f;
     float baseY = 1.0f;
-    getPropertyValue(tgt, "scale_x", baseX);
-    getPropertyValue(tgt, "scale_y", baseY);
-    int seqId = nextSequenceId();
+    getPropertyValue(tgt, TweenProperty::ScaleX, baseX);
+    getPropertyValue(tgt, TweenProperty::ScaleY, baseY);
     Sequence s;
-    s.id = seqId;
     double half = duration * 0.5;
-    int downX = createPropertyTween(tgt, "scale_x", baseX + amount, half, "ease_out");
-    int downY = createPropertyTween(tgt, "scale_y", baseY - amount, half, "ease_out");
-    int upX = createPropertyTween(tgt, "scale_x", baseX, half, "ease_in");
-    int upY = createPropertyTween(tgt, "scale_y", baseY, half, "ease_in");
+    int downX = createPropertyTween(tgt, TweenProperty::ScaleX, baseX + amount, half, easeOf(Easing::QuadOut));
+    int downY = createPropertyTween(tgt, TweenProperty::ScaleY, baseY - amount, half, easeOf(Easing::QuadOut));
+    int upX = createPropertyTween(tgt, TweenProperty::ScaleX, baseX, half, easeOf(Easing::QuadIn));
+    int upY = createPropertyTween(tgt, TweenProperty::ScaleY, baseY, half, easeOf(Easing::QuadIn));
     s.tweens = {downX, downY, upX, upY};
-    for (int tid : s.tweens) st.tweenSequenceOwner[tid] = seqId;
     s.playing = true;
-    st.sequences[seqId] = s;
-    return Value::number(seqId);
+    return Value::number(createSequence(std::move(s)));
 }
 Value apiBounce(const std::vector<Value>& args) {
     if (args.size() < 3) return Value::number(-1);
@@ -350,18 +437,14 @@ Value apiBounce(const std::vector<Value>& args) {
     double height = args[1].numberVal;
     double duration = args[2].numberVal;
     float baseY = 0.0f;
-    getPropertyValue(tgt, "y", baseY);
-    int seqId = nextSequenceId();
+    getPropertyValue(tgt, TweenProperty::Y, baseY);
     Sequence s;
-    s.id = seqId;
     double half = duration * 0.5;
-    int up = createPropertyTween(tgt, "y", baseY - height, half, "ease_out");
-    int down = createPropertyTween(tgt, "y", baseY, half, "ease_in");
+    int up = createPropertyTween(tgt, TweenProperty::Y, baseY - height, half, easeOf(Easing::QuadOut));
+    int down = createPropertyTween(tgt, TweenProperty::Y, baseY, half, easeOf(Easing::QuadIn));
     s.tweens = {up, down};
-    for (int tid : s.tweens) st.tweenSequenceOwner[tid] = seqId;
     s.playing = true;
-    st.sequences[seqId] = s;
-    return Value::number(seqId);
+    return Value::number(createSequence(std::move(s)));
 }
 Value apiFlash(const std::vector<Value>& args) {
     if (args.size() < 3) return Value::number(-1);
@@ -369,70 +452,70 @@ Value apiFlash(const std::vector<Value>& args) {
     int times = (int)args[1].numberVal;
     double duration = args[2].numberVal;
     float baseA = 1.0f;
-    getPropertyValue(tgt, "alpha", baseA);
-    int seqId = nextSequenceId();
+    getPropertyValue(tgt, TweenProperty::Alpha, baseA);
     Sequence s;
-    s.id = seqId;
     double step = duration / (times * 2);
     for (int i = 0; i < times; ++i) {
-        int off = createPropertyTween(tgt, "alpha", 0.0, step, "linear");
-        int on = createPropertyTween(tgt, "alpha", baseA, step, "linear");
+        int off = createPropertyTween(tgt, TweenProperty::Alpha, 0.0, step, easeOf(Easing::Linear));
+        int on = createPropertyTween(tgt, TweenProperty::Alpha, baseA, step, easeOf(Easing::Linear));
         s.tweens.push_back(off);
         s.tweens.push_back(on);
-        st.tweenSequenceOwner[off] = seqId;
-        st.tweenSequenceOwner[on] = seqId;
     }
     s.playing = true;
-    st.sequences[seqId] = s;
-    return Value::number(seqId);
+    return Value::number(createSequence(std::move(s)));
 }
 
 // Update hooks
 void updateTweens(double dt) {
-    for (auto it = st.tweens.begin(); it != st.tweens.end();) {
-        Tween& t = it->second;
-        if (t.canceled) {
-            it = st.tweens.erase(it);
+    evaluateTweens(dt);
+    // Standalone tweens are freed once finished; group-owned ones go with
+    // their group.
+    for (size_t i = 0; i < st.tweens.size();) {
+        const Tween& t = st.tweens.at(i);
+        bool owned = t.sequenceOwner > 0 || t.parallelOwner > 0;
+        if (!owned && (t.canceled || (!t.active && !t.paused))) {
+            st.tweens.erase(st.tweens.handleAt(i));
             continue;
         }
-        updateTween(t, dt);
-        if (!t.active && !t.paused) it = st.tweens.erase(it);
-        else ++it;
+        ++i;
     }
-    for (auto& kv : st.sequences) {
-        Sequence& s = kv.second;
-        if (!s.playing || s.finished) continue;
-        if (s.currentIndex >= (int)s.tweens.size()) {
-            s.finished = true;
+    for (size_t i = 0; i < st.sequences.size();) {
+        Sequence& s = st.sequences.at(i);
+        if (s.finished) {
+            std::vector<int> owned = std::move(s.tweens);
+            st.sequences.erase(st.sequences.handleAt(i));
+            eraseGroupTweens(owned);
             continue;
         }
-        int tid = s.tweens[s.currentIndex];
-        auto tw = st.tweens.find(tid);
-        if (tw == st.tweens.end()) {
-            s.currentIndex++;
+        ++i;
+        if (!s.playing) continue;
+        if (s.currentIndex >= (int)s.tweens.size()) {
+            s.finished = true;
             continue;
         }
-        if (tw->second.elapsed == 0.0) resetTween(tw->second, false, true);
-        updateTween(tw->second, dt);
-        if (!tw->second.active) {
-            s.currentIndex++;
-            if (s.currentIndex < (int)s.tweens.size()) {
-                int nextId = s.tweens[s.currentIndex];
-                auto ntw = st.tweens.find(nextId);
-                if (ntw != st.tweens.end()) resetTween(ntw->second, false, true);
-            }
+        const Tween* tw = st.tweens.get(s.tweens[s.currentIndex]);
+        if (tw && tw->active) continue;
+        s.currentIndex++;
+        if (s.currentIndex < (int)s.tweens.size()) {
+            if (Tween* next = st.tweens.get(s.tweens[s.currentIndex])) resetTween(*next, false, true);
+        } else {
+            s.finished = true;
         }
     }
-    for (auto& kv : st.parallels) {
-        ParallelGroup& p = kv.second;
-        if (!p.playing || p.finished) continue;
+    for (size_t i = 0; i < st.parallels.size();) {
+        ParallelGroup& p = st.parallels.at(i);
+        if (p.finished) {
+            std::vector<int> owned = std::move(p.tweens);
+            st.parallels.erase(st.parallels.handleAt(i));
+            eraseGroupTweens(owned);
+            continue;
+        }
+        ++i;
+        if (!p.playing) continue;
         bool allDone = true;
         for (int tid : p.tweens) {
-            auto tw = st.tweens.find(tid);
-            if (tw == st.tweens.end()) continue;
-            if (tw->second.elapsed == 0.0) resetTween(tw->second, false, true);
-            updateTween(tw->second, dt);
-            if (tw->second.active) allDone = false;
+            const Tween* tw = st.tweens.get(tid);
+            if (tw && tw->active) allDone = false;
         }
         if (allDone) p.finished = true;
     }
@@ -445,6 +528,16 @@ void cleanupFinishedTweens() {
 void updateTweensTick(double dt) {
     updateTweens(dt);
 }
+void dispatchTweenCallbacks() {
+    if (pendingCallbacks.empty()) return;
+    // Swap first: callbacks may start tweens that finish (and queue) next frame.
+    dispatchQueue.swap(pendingCallbacks);
+    for (const Value& cb : dispatchQueue) {
+        if (!st.interpreter) break;
+        st.interpreter->callFunction(cb, callbackArgs);
+    }
+    dispatchQueue.clear();
+}
 void cleanupTweens() {
     cleanupFinishedTweens();
 }
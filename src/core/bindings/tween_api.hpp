@@ -16,7 +16,10 @@ Value apiTweenPause(const std::vector<Value>& args);
 Value apiTweenResume(const std::vector<Value>& args);
 Value apiTweenCancel(const std::vector<Value>& args);
 Value apiTweenOnComplete(const std::vector<Value>& args);
+// Native only; safe to run as a job. Completion callbacks are queued and run
+// by dispatchTweenCallbacks() on the main thread.
 void updateTweensTick(double dt);
+void dispatchTweenCallbacks();
 void cleanupTweens();
 
 // Animation helpers built on tweens
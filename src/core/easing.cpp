@@ -0,0 +1,179 @@
+#include "easing.hpp"
+#include <cmath>
+
+namespace yuki {
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kBackC1 = 1.70158;
+constexpr double kBackC2 = kBackC1 * 1.525;
+constexpr double kBackC3 = kBackC1 + 1.0;
+constexpr double kElasticC4 = (2.0 * kPi) / 3.0;
+constexpr double kElasticC5 = (2.0 * kPi) / 4.5;
+
+struct NamedEasing {
+    const char* name;
+    Easing easing;
+};
+constexpr NamedEasing kEasingNames[] = {
+    {"linear", Easing::Linear},
+    {"ease_in", Easing::QuadIn}, {"ease_out", Easing::QuadOut}, {"ease_in_out", Easing::QuadInOut},
+    {"quad_in", Easing::QuadIn}, {"quad_out", Easing::QuadOut}, {"quad_in_out", Easing::QuadInOut},
+    {"cubic_in", Easing::CubicIn}, {"cubic_out", Easing::CubicOut}, {"cubic_in_out", Easing::CubicInOut},
+    {"expo_in", Easing::ExpoIn}, {"expo_out", Easing::ExpoOut}, {"expo_in_out", Easing::ExpoInOut},
+    {"back_in", Easing::BackIn}, {"back_out", Easing::BackOut}, {"back_in_out", Easing::BackInOut},
+    {"elastic_in", Easing::ElasticIn}, {"elastic_out", Easing::ElasticOut}, {"elastic_in_out", Easing::ElasticInOut},
+    {"bounce_in", Easing::BounceIn}, {"bounce_out", Easing::BounceOut}, {"bounce_in_out", Easing::BounceInOut},
+    {"bezier", Easing::Bezier},
+};
+
+inline double quadIn(double u) { return u * u; }
+inline double quadOut(double u) { return u * (2.0 - u); }
+inline double quadInOut(double u) {
+    if (u < 0.5) return 2.0 * u * u;
+    double k = -2.0 * u + 2.0;
+    return 1.0 - (k * k) / 2.0;
+}
+inline double cubicIn(double u) { return u * u * u; }
+inline double cubicOut(double u) {
+    double k = 1.0 - u;
+    return 1.0 - k * k * k;
+}
+inline double cubicInOut(double u) {
+    if (u < 0.5) return 4.0 * u * u * u;
+    double k = -2.0 * u + 2.0;
+    return 1.0 - (k * k * k) / 2.0;
+}
+inline double expoIn(double u) { return u <= 0.0 ? 0.0 : std::exp2(10.0 * u - 10.0); }
+inline double expoOut(double u) { return u >= 1.0 ? 1.0 : 1.0 - std::exp2(-10.0 * u); }
+inline double expoInOut(double u) {
+    if (u <= 0.0) return 0.0;
+    if (u >= 1.0) return 1.0;
+    if (u < 0.5) return std::exp2(20.0 * u - 10.0) / 2.0;
+    return (2.0 - std::exp2(-20.0 * u + 10.0)) / 2.0;
+}
+inline double backIn(double u) { return kBackC3 * u * u * u - kBackC1 * u * u; }
+inline double backOut(double u) {
+    double k = u - 1.0;
+    return 1.0 + kBackC3 * k * k * k + kBackC1 * k * k;
+}
+inline double backInOut(double u) {
+    if (u < 0.5) {
+        double k = 2.0 * u;
+        return (k * k * ((kBackC2 + 1.0) * k - kBackC2)) / 2.0;
+    }
+    double k = 2.0 * u - 2.0;
+    return (k * k * ((kBackC2 + 1.0) * k + kBackC2) + 2.0) / 2.0;
+}
+inline double elasticIn(double u) {
+    if (u <= 0.0) return 0.0;
+    if (u >= 1.0) return 1.0;
+    return -std::exp2(10.0 * u - 10.0) * std::sin((u * 10.0 - 10.75) * kElasticC4);
+}
+inline double elasticOut(double u) {
+    if (u <= 0.0) return 0.0;
+    if (u >= 1.0) return 1.0;
+    return std::exp2(-10.0 * u) * std::sin((u * 10.0 - 0.75) * kElasticC4) + 1.0;
+}
+inline double elasticInOut(double u) {
+    if (u <= 0.0) return 0.0;
+    if (u >= 1.0) return 1.0;
+    double s = std::sin((20.0 * u - 11.125) * kElasticC5);
+    if (u < 0.5) return -(std::exp2(20.0 * u - 10.0) * s) / 2.0;
+    return (std::exp2(-20.0 * u + 10.0) * s) / 2.0 + 1.0;
+}
+inline double bounceOut(double u) {
+    const double n1 = 7.5625;
+    const double d1 = 2.75;
+    if (u < 1.0 / d1) return n1 * u * u;
+    if (u < 2.0 / d1) { u -= 1.5 / d1; return n1 * u * u + 0.75; }
+    if (u < 2.5 / d1) { u -= 2.25 / d1; return n1 * u * u + 0.9375; }
+    u -= 2.625 / d1;
+    return n1 * u * u + 0.984375;
+}
+inline double bounceIn(double u) { return 1.0 - bounceOut(1.0 - u); }
+inline double bounceInOut(double u) {
+    if (u < 0.5) return (1.0 - bounceOut(1.0 - 2.0 * u)) / 2.0;
+    return (1.0 + bounceOut(2.0 * u - 1.0)) / 2.0;
+}
+
+template <typename F>
+inline void easeAll(double* u, size_t n, F f) {
+    for (size_t i = 0; i < n; ++i) u[i] = f(u[i]);
+}
+} // namespace
+
+double CubicBezier::eval(double u) const {
+    if (u <= 0.0) return 0.0;
+    if (u >= 1.0) return 1.0;
+    // Polynomial coefficients of x(s) and y(s).
+    double cx = 3.0 * x1, bx = 3.0 * (x2 - x1) - cx, ax = 1.0 - cx - bx;
+    double cy = 3.0 * y1, by = 3.0 * (y2 - y1) - cy, ay = 1.0 - cy - by;
+    auto sampleX = [&](double s) { return ((ax * s + bx) * s + cx) * s; };
+    // Newton first; fall back to bisection when the slope is too flat.
+    double s = u;
+    for (int i = 0; i < 8; ++i) {
+        double x = sampleX(s) - u;
+        if (std::fabs(x) < 1e-7) return ((ay * s + by) * s + cy) * s;
+        double dx = (3.0 * ax * s + 2.0 * bx) * s + cx;
+        if (std::fabs(dx) < 1e-6) break;
+        s -= x / dx;
+    }
+    double lo = 0.0, hi = 1.0;
+    s = u;
+    for (int i = 0; i < 32; ++i) {
+        double x = sampleX(s);
+        if (std::fabs(x - u) < 1e-7) break;
+        if (x < u) lo = s;
+        else hi = s;
+        s = (lo + hi) * 0.5;
+    }
+    return ((ay * s + by) * s + cy) * s;
+}
+
+bool parseEasing(const std::string& name, Easing& out) {
+    for (const auto& e : kEasingNames) {
+        if (name == e.name) {
+            out = e.easing;
+            return true;
+        }
+    }
+    out = Easing::Linear;
+    return false;
+}
+
+const char* easingName(Easing e) {
+    for (const auto& n : kEasingNames) {
+        if (n.easing == e) return n.name;
+    }
+    return "linear";
+}
+
+double applyEasing(Easing e, double u) {
+    applyEasingBatch(e, &u, 1);
+    return u;
+}
+
+void applyEasingBatch(Easing e, double* u, size_t n) {
+    switch (e) {
+    case Easing::Linear: case Easing::Bezier: case Easing::Count: return;
+    case Easing::QuadIn: easeAll(u, n, quadIn); return;
+    case Easing::QuadOut: easeAll(u, n, quadOut); return;
+    case Easing::QuadInOut: easeAll(u, n, quadInOut); return;
+    case Easing::CubicIn: easeAll(u, n, cubicIn); return;
+    case Easing::CubicOut: easeAll(u, n, cubicOut); return;
+    case Easing::CubicInOut: easeAll(u, n, cubicInOut); return;
+    case Easing::ExpoIn: easeAll(u, n, expoIn); return;
+    case Easing::ExpoOut: easeAll(u, n, expoOut); return;
+    case Easing::ExpoInOut: easeAll(u, n, expoInOut); return;
+    case Easing::BackIn: easeAll(u, n, backIn); return;
+    case Easing::BackOut: easeAll(u, n, backOut); return;
+    case Easing::BackInOut: easeAll(u, n, backInOut); return;
+    case Easing::ElasticIn: easeAll(u, n, elasticIn); return;
+    case Easing::ElasticOut: easeAll(u, n, elasticOut); return;
+    case Easing::ElasticInOut: easeAll(u, n, elasticInOut); return;
+    case Easing::BounceIn: easeAll(u, n, bounceIn); return;
+    case Easing::BounceOut: easeAll(u, n, bounceOut); return;
+    case Easing::BounceInOut: easeAll(u, n, bounceInOut); return;
+    }
+}
+} // namespace yuki
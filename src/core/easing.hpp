@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace yuki {
+
+// Easing curves are resolved once when a tween is created. Names follow
+// `<family>_<in|out|in_out>`; "ease_in"/"ease_out"/"ease_in_out" are the
+// original quadratic curves and stay as aliases.
+enum class Easing {
+    Linear,
+    QuadIn, QuadOut, QuadInOut,
+    CubicIn, CubicOut, CubicInOut,
+    ExpoIn, ExpoOut, ExpoInOut,
+    BackIn, BackOut, BackInOut,
+    ElasticIn, ElasticOut, ElasticInOut,
+    BounceIn, BounceOut, BounceInOut,
+    Bezier,
+    Count
+};
+
+// CSS-style cubic-bezier(x1, y1, x2, y2) with fixed end points (0,0) and (1,1).
+struct CubicBezier {
+    double x1 = 0.0, y1 = 0.0, x2 = 1.0, y2 = 1.0;
+    double eval(double u) const;
+};
+
+// Unknown names fall back to Linear and return false.
+bool parseEasing(const std::string& name, Easing& out);
+const char* easingName(Easing e);
+
+double applyEasing(Easing e, double u);
+// Eases `u[0..n)` in place. All entries share the curve so each case is a
+// tight loop the compiler can inline and vectorize. Bezier is not handled here.
+void applyEasingBatch(Easing e, double* u, size_t n);
+} // namespace yuki
@@ -3,7 +3,14 @@
 #include "bindings/register_bindings.hpp"
 #include "bindings/anim_api.hpp"
 #include "bindings/tween_api.hpp"
+#include "bindings/ase_api.hpp"
+#include "bindings/asset_api.hpp"
+#include "bindings/core_api.hpp"
 #include "aseprite_loader.hpp"
+#include "../script/frame_arena.hpp"
+#include "job_system.hpp"
+#include "frame_profiler.hpp"
+#include "alloc_tracker.hpp"
 #include "log.hpp"
 #include <filesystem>
 #include <functional>
@@ -13,63 +20,11 @@
 namespace yuki {
 namespace {
 BindingsState& st = bindingsState();
-
-void hotReloadAse(double dt) {
-    static double accum = 0.0;
-    accum += dt;
-    if (accum < 0.25) return;
-    accum = 0.0;
-    for (auto& kv : st.aseAssets) {
-        auto& asset = kv.second;
-        if (asset.path.empty()) continue;
-        std::error_code ec;
-        auto cur = std::filesystem::last_write_time(asset.path, ec);
-        if (ec || cur <= asset.lastWriteTime) continue;
-        AseData data;
-        if (!loadAsepriteFile(asset.path, data)) continue;
-        if (data.width <= 0 || data.height <= 0 || data.frames.empty()) continue;
-        if (!st.renderer->updateSpriteSheetFromFrames(asset.sheetId, data.width, data.height, data.frames)) continue;
-        asset.frameW = data.width;
-        asset.frameH = data.height;
-        asset.lastWriteTime = cur;
-        asset.tagFrames.clear();
-        asset.tagFps.clear();
-        for (const auto& tag : data.tags) {
-            std::vector<int> frames;
-            for (int fi = tag.from; fi <= tag.to && fi < (int)data.frames.size(); ++fi) {
-                frames.push_back(fi);
-            }
-            if (tag.direction == 1) std::reverse(frames.begin(), frames.end());
-            else if (tag.direction == 2) {
-                if (!frames.empty()) {
-                    for (int i = (int)frames.size() - 2; i >= 1; --i) frames.push_back(frames[i]);
-                }
-            }
-            if (frames.empty()) continue;
-            double avgMs = 0.0;
-            int count = 0;
-            for (int f : frames) {
-                if (f >= 0 && f < (int)data.durationsMs.size() && data.durationsMs[f] > 0) {
-                    avgMs += data.durationsMs[f];
-                    count++;
-                }
-            }
-            double fps = 10.0;
-            if (count > 0) {
-                avgMs /= (double)count;
-                fps = avgMs > 0.0 ? 1000.0 / avgMs : 10.0;
-            }
-            asset.tagFrames[tag.name] = frames;
-            asset.tagFps[tag.name] = fps;
-        }
-        logInfo("ase_reload: " + asset.path + " tags=" + std::to_string(asset.tagFrames.size()));
-    }
-}
-
 } // namespace
 
 void EngineBindings::init(Window* window, Renderer2D* renderer, Interpreter* interpreter) {
     resetBindingsState();
+    frameArena().clear();
     st.window = window;
     st.renderer = renderer;
     st.interpreter = interpreter;
@@ -101,12 +56,44 @@ std::vector<std::string> EngineBindings::getLoadedModulePaths() {
     return out;
 }
 
+void EngineBindings::handleFileChanges(const std::vector<std::string>& paths) {
+    if (!paths.empty()) queueAseReloads(paths);
+}
+
+bool EngineBindings::reloadModule(const std::string& path, std::vector<std::string>& errors) {
+    return yuki::reloadModule(path, errors);
+}
+
 void EngineBindings::update(double dt) {
-    hotReloadAse(dt);
+    // Native subsystems that only touch their own state run as jobs while the
+    // main thread handles GL/camera work. Tween completion callbacks call back
+    // into the interpreter, so they are queued and dispatched after the join.
+    // Finished Aseprite reloads are swapped in first so the whole frame sees
+    // one version of each sheet; async loads then upload within their budget.
+    ProfileZone zone("engine update");
+    AllocScope tag(AllocTag::Engine);
+    {
+        ProfileZone assets("asset uploads");
+        AllocScope assetTag(AllocTag::Assets);
+        applyAseReloads();
+        pumpAssetUploads();
+    }
+    JobSystem& jobs = jobSystem();
+    JobSystem::Counter counter;
+    jobs.submit(counter, [dt]() { updateAnimationsTick(dt); });
+    jobs.submit(counter, [dt]() { updateTweensTick(dt); });
+    for (auto& sys : st.particleSystems) {
+        ParticleSystem* ps = &sys;
+        if (ps->isAutoUpdate()) jobs.submit(counter, [ps, dt]() { ps->update((float)dt); });
+    }
     if (st.renderer) st.renderer->cameraUpdate(dt);
-    updateTweensTick(dt);
+    {
+        ProfileZone wait("job wait");
+        jobs.wait(counter);
+    }
+    ProfileZone callbacks("tween callbacks");
+    dispatchTweenCallbacks();
     cleanupTweens();
-    updateAnimationsTick(dt);
 }
 
 void EngineBindings::registerBuiltins(std::unordered_map<std::string, NativeFn>& builtins) {
@@ -119,5 +106,9 @@ void EngineBindings::registerBuiltins(std::unordered_map<std::string, NativeFn>&
     registerMathBuiltins(builtins);
     registerAseBuiltins(builtins);
     registerUiBuiltins(builtins);
+    registerParticleBuiltins(builtins);
+    registerEntityBuiltins(builtins);
+    registerSchedulerBuiltins(builtins);
+    registerAssetBuiltins(builtins);
 }
 } // namespace yuki
@@ -16,6 +16,10 @@ public:
     static void setAssetBase(const std::string& base);
     static std::string resolveAssetPath(const std::string& rel);
     static std::vector<std::string> getLoadedModulePaths();
+    // Routes file watcher changes (normalized paths) to asset hot reload.
+    static void handleFileChanges(const std::vector<std::string>& paths);
+    // Hot-reloads one loaded module in place; false if it is not a module or failed.
+    static bool reloadModule(const std::string& path, std::vector<std::string>& errors);
     static void registerBuiltins(std::unordered_map<std::string, NativeFn>& builtins);
 };
 } // namespace yuki
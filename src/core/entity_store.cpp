@@ -0,0 +1,111 @@
+#include "entity_store.hpp"
+#include <algorithm>
+
+namespace yuki {
+
+int EntityStore::create(float px, float py) {
+    int id = nextId++;
+    if (id >= (int)sparse.size()) sparse.resize((size_t)id + 1, -1);
+    sparse[id] = (int)ids.size();
+    ids.push_back(id);
+    order.push_back(id);
+    x.push_back(px);
+    y.push_back(py);
+    prevX.push_back(px);
+    prevY.push_back(py);
+    vx.push_back(0.0f);
+    vy.push_back(0.0f);
+    renderX.push_back(px);
+    renderY.push_back(py);
+    colliderId.push_back(-1);
+    colW.push_back(0.0f);
+    colH.push_back(0.0f);
+    colOX.push_back(0.0f);
+    colOY.push_back(0.0f);
+    animId.push_back(-1);
+    animOX.push_back(0.0f);
+    animOY.push_back(0.0f);
+    flags.push_back(NativeDraw);
+    return id;
+}
+
+bool EntityStore::destroy(int id) {
+    int idx = indexOf(id);
+    if (idx < 0) return false;
+    size_t last = ids.size() - 1;
+    if ((size_t)idx != last) {
+        ids[idx] = ids[last];
+        x[idx] = x[last];
+        y[idx] = y[last];
+        prevX[idx] = prevX[last];
+        prevY[idx] = prevY[last];
+        vx[idx] = vx[last];
+        vy[idx] = vy[last];
+        renderX[idx] = renderX[last];
+        renderY[idx] = renderY[last];
+        colliderId[idx] = colliderId[last];
+        colW[idx] = colW[last];
+        colH[idx] = colH[last];
+        colOX[idx] = colOX[last];
+        colOY[idx] = colOY[last];
+        animId[idx] = animId[last];
+        animOX[idx] = animOX[last];
+        animOY[idx] = animOY[last];
+        flags[idx] = flags[last];
+        sparse[ids[idx]] = idx;
+    }
+    ids.pop_back();
+    x.pop_back();
+    y.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    vx.pop_back();
+    vy.pop_back();
+    renderX.pop_back();
+    renderY.pop_back();
+    colliderId.pop_back();
+    colW.pop_back();
+    colH.pop_back();
+    colOX.pop_back();
+    colOY.pop_back();
+    animId.pop_back();
+    animOX.pop_back();
+    animOY.pop_back();
+    flags.pop_back();
+    sparse[id] = -1;
+    ++destroyedSinceCompact;
+    return true;
+}
+
+const std::vector<int>& EntityStore::spawnOrder() {
+    if (destroyedSinceCompact > 0) {
+        order.erase(std::remove_if(order.begin(), order.end(), [this](int id) { return sparse[id] < 0; }), order.end());
+        destroyedSinceCompact = 0;
+    }
+    return order;
+}
+
+void EntityStore::clear() {
+    for (int id : ids) sparse[id] = -1;
+    ids.clear();
+    order.clear();
+    destroyedSinceCompact = 0;
+    x.clear();
+    y.clear();
+    prevX.clear();
+    prevY.clear();
+    vx.clear();
+    vy.clear();
+    renderX.clear();
+    renderY.clear();
+    colliderId.clear();
+    colW.clear();
+    colH.clear();
+    colOX.clear();
+    colOY.clear();
+    animId.clear();
+    animOX.clear();
+    animOY.clear();
+    flags.clear();
+}
+} // namespace yuki
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace yuki {
+
+// Sparse-set entity storage. `sparse` maps an entity id to its slot in the dense
+// component columns; destroying an entity swap-removes it so every column stays
+// packed and systems can walk [0, size()) without holes. Dense order is
+// therefore not spawn order: anything order-sensitive (drawing) walks
+// spawnOrder() instead.
+class EntityStore {
+public:
+    enum Flags : uint8_t {
+        HasCollider = 1 << 0,
+        HasAnim = 1 << 1,
+        NativeDraw = 1 << 2,
+    };
+
+    int create(float x, float y);
+    bool destroy(int id);
+    bool contains(int id) const { return indexOf(id) >= 0; }
+    int indexOf(int id) const {
+        if (id <= 0 || id >= (int)sparse.size()) return -1;
+        return sparse[id];
+    }
+    size_t size() const { return ids.size(); }
+    void clear();
+    // Live ids oldest first (ids only grow). Destroyed ids are dropped lazily
+    // on the next call, so destroy() stays O(1).
+    const std::vector<int>& spawnOrder();
+
+    std::vector<int> ids;
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;
+    std::vector<float> vx, vy;
+    std::vector<float> renderX, renderY;
+    std::vector<int> colliderId;
+    std::vector<float> colW, colH, colOX, colOY;
+    std::vector<int> animId;
+    std::vector<float> animOX, animOY;
+    std::vector<uint8_t> flags;
+
+private:
+    std::vector<int> sparse;
+    std::vector<int> order;
+    size_t destroyedSinceCompact = 0;
+    int nextId = 1;
+};
+} // namespace yuki
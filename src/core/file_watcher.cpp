@@ -0,0 +1,133 @@
+#include "file_watcher.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <chrono>
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace yuki {
+namespace {
+constexpr auto kPollInterval = std::chrono::milliseconds(250);
+} // namespace
+
+FileWatcher::FileWatcher() {
+#if defined(__linux__)
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) logError("file watcher: inotify unavailable, falling back to polling");
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    pollWake.notify_all();
+    if (poller.joinable()) poller.join();
+#if defined(__linux__)
+    if (inotifyFd >= 0) close(inotifyFd);
+#endif
+}
+
+std::string FileWatcher::normalize(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path abs = std::filesystem::absolute(path, ec);
+    if (ec) abs = path;
+    std::filesystem::path canon = std::filesystem::weakly_canonical(abs, ec);
+    if (ec) canon = abs.lexically_normal();
+    return canon.string();
+}
+
+void FileWatcher::watch(const std::string& path) {
+    std::string file = normalize(path);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!files.insert(file).second) return;
+    }
+#if defined(__linux__)
+    if (inotifyFd >= 0) {
+        std::string dir = std::filesystem::path(file).parent_path().string();
+        if (watchedDirs.count(dir)) return;
+        int wd = inotify_add_watch(inotifyFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd >= 0) {
+            watchedDirs.insert(dir);
+            dirByWatch[wd] = dir;
+            return;
+        }
+        logError("file watcher: cannot watch " + dir + ", polling " + file);
+    }
+#endif
+    startPolling(file);
+}
+
+void FileWatcher::readInotify() {
+#if defined(__linux__)
+    alignas(inotify_event) char buf[4096];
+    for (;;) {
+        ssize_t n = read(inotifyFd, buf, sizeof(buf));
+        if (n <= 0) break;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (char* p = buf; p < buf + n;) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + ev->len;
+            if (ev->mask & IN_Q_OVERFLOW) {
+                // Events were dropped; report everything rather than miss a save.
+                pending.insert(pending.end(), files.begin(), files.end());
+                continue;
+            }
+            auto it = dirByWatch.find(ev->wd);
+            if (it == dirByWatch.end() || ev->len == 0) continue;
+            std::string file = (std::filesystem::path(it->second) / ev->name).string();
+            if (files.count(file)) pending.push_back(file);
+        }
+    }
+#endif
+}
+
+void FileWatcher::startPolling(const std::string& file) {
+    std::error_code ec;
+    auto t = std::filesystem::last_write_time(file, ec);
+    std::lock_guard<std::mutex> lock(mutex);
+    polled[file] = ec ? std::filesystem::file_time_type::min() : t;
+    if (!poller.joinable()) poller = std::thread([this]() { pollLoop(); });
+}
+
+void FileWatcher::pollLoop() {
+    std::vector<std::pair<std::string, std::filesystem::file_time_type>> snapshot;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        snapshot.assign(polled.begin(), polled.end());
+        lock.unlock();
+        std::vector<std::pair<std::string, std::filesystem::file_time_type>> changed;
+        for (const auto& entry : snapshot) {
+            std::error_code ec;
+            auto t = std::filesystem::last_write_time(entry.first, ec);
+            if (!ec && t > entry.second) changed.emplace_back(entry.first, t);
+        }
+        lock.lock();
+        for (const auto& c : changed) {
+            polled[c.first] = c.second;
+            pending.push_back(c.first);
+        }
+        pollWake.wait_for(lock, kPollInterval, [this]() { return stopping; });
+    }
+}
+
+void FileWatcher::drain(std::vector<std::string>& out) {
+    if (inotifyFd >= 0) readInotify();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pending.empty()) return;
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+    out.insert(out.end(), pending.begin(), pending.end());
+    pending.clear();
+}
+
+FileWatcher& fileWatcher() {
+    static FileWatcher watcher;
+    return watcher;
+}
+} // namespace yuki
@@ -0,0 +1,55 @@
+#pragma once
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace yuki {
+
+// Change notifications for individual files, shared by script and asset hot
+// reload. On Linux the parent directories are watched with inotify (so editors
+// that save by renaming still trigger); anything inotify cannot watch falls
+// back to a background thread that checks modification times every 250 ms.
+// Changes are queued and handed out by drain(), once per frame. watch() and
+// drain() belong to the main thread.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Adding the same file again is a no-op.
+    void watch(const std::string& path);
+    // Moves the files changed since the last call into `out`, each once.
+    void drain(std::vector<std::string>& out);
+    bool usingInotify() const { return inotifyFd >= 0; }
+
+    // Absolute, symlink-resolved form used for every path the watcher reports.
+    static std::string normalize(const std::string& path);
+
+private:
+    void readInotify();
+    void startPolling(const std::string& path);
+    void pollLoop();
+
+    std::mutex mutex;
+    std::unordered_set<std::string> files;
+    std::vector<std::string> pending;
+
+    int inotifyFd = -1;
+    std::unordered_map<int, std::string> dirByWatch;
+    std::unordered_set<std::string> watchedDirs;
+
+    std::unordered_map<std::string, std::filesystem::file_time_type> polled;
+    std::thread poller;
+    std::condition_variable pollWake;
+    bool stopping = false;
+};
+
+FileWatcher& fileWatcher();
+} // namespace yuki
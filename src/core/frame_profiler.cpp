@@ -0,0 +1,164 @@
+#include "frame_profiler.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace yuki {
+
+FrameProfiler::FrameProfiler() : frames(kFrameCount) {}
+
+int64_t FrameProfiler::nowNs() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+}
+
+void FrameProfiler::beginFrame() {
+    inFrame = false;
+    if (!enabled) return;
+    if (!hasEpoch) {
+        epoch = Clock::now();
+        hasEpoch = true;
+    }
+    Frame& f = frames[head];
+    f.index = frameIndex;
+    f.startNs = nowNs();
+    f.durationNs = 0;
+    f.zoneCount = 0;
+    f.droppedZones = 0;
+    frameStartNs = f.startNs;
+    depth = 0;
+    owner = std::this_thread::get_id();
+    inFrame = true;
+}
+
+void FrameProfiler::endFrame() {
+    if (!inFrame) return;
+    inFrame = false;
+    frames[head].durationNs = nowNs() - frameStartNs;
+    head = (head + 1) % kFrameCount;
+    recorded = std::min(recorded + 1, kFrameCount);
+    ++frameIndex;
+}
+
+const FrameProfiler::Frame& FrameProfiler::frame(size_t age) const {
+    return frames[(head + kFrameCount - 1 - age) % kFrameCount];
+}
+
+int FrameProfiler::enter(const char* name) {
+    if (!inFrame || std::this_thread::get_id() != owner) return -1;
+    Frame& f = frames[head];
+    if (f.zoneCount >= kMaxZones) {
+        ++f.droppedZones;
+        return -1;
+    }
+    Zone& z = f.zones[f.zoneCount];
+    z.name = name;
+    z.depth = depth++;
+    z.startNs = nowNs() - frameStartNs;
+    z.durationNs = 0;
+    return (int)f.zoneCount++;
+}
+
+void FrameProfiler::leave(int zone) {
+    // Zones must not straddle frames; a stale index is simply dropped.
+    Frame& f = frames[head];
+    if (!inFrame || zone < 0 || (uint32_t)zone >= f.zoneCount) return;
+    Zone& z = f.zones[zone];
+    z.durationNs = nowNs() - frameStartNs - z.startNs;
+    if (depth > 0) --depth;
+}
+
+std::vector<FrameProfiler::ZoneStats> FrameProfiler::zoneStats() const {
+    std::vector<ZoneStats> stats;
+    if (recorded == 0) return stats;
+    auto sameZone = [](const ZoneStats& s, const Zone& z) {
+        return s.depth == z.depth && (s.name == z.name || std::strcmp(s.name, z.name) == 0);
+    };
+    // Rows come from the latest frame so the table follows the current code
+    // path; zones that only appear in older frames are not listed.
+    const Frame& latest = frame(0);
+    for (uint32_t i = 0; i < latest.zoneCount; ++i) {
+        const Zone& z = latest.zones[i];
+        auto it = std::find_if(stats.begin(), stats.end(), [&](const ZoneStats& s) { return sameZone(s, z); });
+        if (it == stats.end()) {
+            ZoneStats s;
+            s.name = z.name;
+            s.depth = z.depth;
+            stats.push_back(s);
+        }
+    }
+    std::vector<double> frameMs(stats.size());
+    for (size_t age = 0; age < recorded; ++age) {
+        const Frame& f = frame(age);
+        std::fill(frameMs.begin(), frameMs.end(), 0.0);
+        for (uint32_t i = 0; i < f.zoneCount; ++i) {
+            const Zone& z = f.zones[i];
+            for (size_t s = 0; s < stats.size(); ++s) {
+                if (sameZone(stats[s], z)) {
+                    frameMs[s] += (double)z.durationNs / 1e6;
+                    break;
+                }
+            }
+        }
+        for (size_t s = 0; s < stats.size(); ++s) {
+            if (age == 0) stats[s].lastMs = frameMs[s];
+            stats[s].avgMs += frameMs[s];
+            stats[s].maxMs = std::max(stats[s].maxMs, frameMs[s]);
+        }
+    }
+    for (auto& s : stats) s.avgMs /= (double)recorded;
+    return stats;
+}
+
+double FrameProfiler::averageFrameMs() const {
+    if (recorded == 0) return 0.0;
+    double total = 0.0;
+    for (size_t age = 0; age < recorded; ++age) total += (double)frame(age).durationNs / 1e6;
+    return total / (double)recorded;
+}
+
+double FrameProfiler::maxFrameMs() const {
+    double peak = 0.0;
+    for (size_t age = 0; age < recorded; ++age) peak = std::max(peak, (double)frame(age).durationNs / 1e6);
+    return peak;
+}
+
+bool FrameProfiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    auto event = [&](const char* name, int64_t startNs, int64_t durationNs, bool& first) {
+        out << (first ? "\n" : ",\n") << "{\"name\":\"";
+        for (const char* c = name; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+        out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << (double)startNs / 1000.0
+            << ",\"dur\":" << (double)durationNs / 1000.0 << '}';
+        first = false;
+    };
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (size_t age = recorded; age-- > 0;) {
+        const Frame& f = frame(age);
+        std::string name = "frame " + std::to_string(f.index);
+        event(name.c_str(), f.startNs, f.durationNs, first);
+        for (uint32_t i = 0; i < f.zoneCount; ++i) {
+            const Zone& z = f.zones[i];
+            event(z.name, f.startNs + z.startNs, z.durationNs, first);
+        }
+    }
+    out << "\n]}\n";
+    return (bool)out;
+}
+
+FrameProfiler& frameProfiler() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+ProfileZone::ProfileZone(const char* name) : zone(frameProfiler().enter(name)) {}
+
+ProfileZone::~ProfileZone() {
+    if (zone >= 0) frameProfiler().leave(zone);
+}
+
+} // namespace yuki
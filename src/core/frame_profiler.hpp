@@ -0,0 +1,101 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace yuki {
+
+// Per-frame CPU timings. The runner brackets every iteration of its loop with
+// beginFrame()/endFrame(); ProfileZone markers placed anywhere in core or
+// runtime code record nested zones into the current frame. The last
+// kFrameCount frames are kept in a ring buffer for the ImGui overlay and can
+// be exported in the Chrome trace format (chrome://tracing, Perfetto).
+// Only the thread that began the frame records; zones opened on job workers
+// or outside a frame are ignored, so markers are safe to leave everywhere.
+class FrameProfiler {
+public:
+    static constexpr size_t kFrameCount = 240;
+    static constexpr size_t kMaxZones = 64; // per frame, extra zones are dropped
+
+    struct Zone {
+        const char* name = nullptr; // must outlive the profiler (string literal)
+        uint32_t depth = 0;
+        int64_t startNs = 0; // relative to the frame start
+        int64_t durationNs = 0;
+    };
+    struct Frame {
+        uint64_t index = 0;
+        int64_t startNs = 0; // relative to the first recorded frame
+        int64_t durationNs = 0;
+        uint32_t zoneCount = 0;
+        uint32_t droppedZones = 0;
+        Zone zones[kMaxZones]; // in the order they were opened
+    };
+    struct ZoneStats {
+        const char* name = nullptr;
+        uint32_t depth = 0;
+        double lastMs = 0.0; // summed over all entries of the zone in a frame
+        double avgMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    FrameProfiler();
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    // A disabled profiler keeps its recorded frames (the overlay uses this to
+    // pause on a spike) and records nothing new.
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    void beginFrame();
+    void endFrame();
+
+    // Completed frames; age 0 is the most recent one.
+    size_t frameCount() const { return recorded; }
+    const Frame& frame(size_t age) const;
+
+    // Zones of the most recent frame, with averages and peaks over the ring.
+    std::vector<ZoneStats> zoneStats() const;
+    double averageFrameMs() const;
+    double maxFrameMs() const;
+    bool writeChromeTrace(const std::string& path) const;
+
+private:
+    friend class ProfileZone;
+    using Clock = std::chrono::steady_clock;
+
+    int enter(const char* name);
+    void leave(int zone);
+    int64_t nowNs() const;
+
+    std::vector<Frame> frames; // ring of kFrameCount
+    size_t head = 0;           // slot of the frame being recorded
+    size_t recorded = 0;
+    uint64_t frameIndex = 0;
+    bool enabled = true;
+    bool inFrame = false;
+    uint32_t depth = 0;
+    std::thread::id owner;
+    Clock::time_point epoch;
+    bool hasEpoch = false;
+    int64_t frameStartNs = 0;
+};
+
+FrameProfiler& frameProfiler();
+
+// RAII zone marker: `ProfileZone zone("engine update");`
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name);
+    ~ProfileZone();
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+private:
+    int zone = -1;
+};
+
+} // namespace yuki
@@ -0,0 +1,140 @@
+#include "job_system.hpp"
+#include "alloc_tracker.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace yuki {
+namespace {
+thread_local const JobSystem* tlsOwner = nullptr;
+thread_local size_t tlsQueueIndex = 0;
+constexpr int kMaxAssetWorkers = 2;
+constexpr int kMaxWorkers = 15;
+} // namespace
+
+int JobSystem::defaultWorkerCount() {
+    if (const char* env = std::getenv("YUKI_JOBS")) {
+        int threadsWanted = std::atoi(env);
+        if (threadsWanted >= 1) return std::min(threadsWanted - 1, kMaxWorkers);
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    if (hw <= 1) return 0;
+    return std::min((int)hw - 1, kMaxWorkers);
+}
+
+JobSystem::JobSystem(int workers) {
+    if (workers < 0) workers = 0;
+    queues.reserve((size_t)workers + 1);
+    for (int i = 0; i <= workers; ++i) queues.push_back(std::make_unique<Queue>());
+    threads.reserve((size_t)workers);
+    for (int i = 1; i <= workers; ++i) {
+        threads.emplace_back([this, i]() { workerLoop((size_t)i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+void JobSystem::submit(Counter& counter, Job job) {
+    if (threads.empty()) {
+        job();
+        return;
+    }
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    Queue& q = *queues[localQueue()];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(Task{std::move(job), &counter});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+bool JobSystem::runOne(size_t self) {
+    Task task;
+    bool found = false;
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (size_t k = 1; !found && k < queues.size(); ++k) {
+        Queue& victim = *queues[(self + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found) return false;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued--;
+    }
+    task.job();
+    task.counter->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::wait(Counter& counter) {
+    while (!counter.done()) {
+        if (!runOne(localQueue())) std::this_thread::yield();
+    }
+}
+
+size_t JobSystem::localQueue() const {
+    // Workers of another pool use this one like any outside thread.
+    return tlsOwner == this ? tlsQueueIndex : 0;
+}
+
+void JobSystem::workerLoop(size_t index) {
+    tlsOwner = this;
+    tlsQueueIndex = index;
+    AllocScope tag(AllocTag::Jobs);
+    for (;;) {
+        if (runOne(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || queued > 0; });
+        if (stopping) return;
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    if (threads.empty() || count <= grain) {
+        fn(0, count);
+        return;
+    }
+    Counter counter;
+    for (size_t begin = grain; begin < count; begin += grain) {
+        size_t end = std::min(count, begin + grain);
+        submit(counter, [&fn, begin, end]() { fn(begin, end); });
+    }
+    fn(0, std::min(count, grain));
+    wait(counter);
+}
+
+JobSystem& jobSystem() {
+    static JobSystem system(JobSystem::defaultWorkerCount());
+    return system;
+}
+
+JobSystem& assetJobSystem() {
+    static JobSystem system(std::clamp(JobSystem::defaultWorkerCount(), 1, kMaxAssetWorkers));
+    return system;
+}
+} // namespace yuki
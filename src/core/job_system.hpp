@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yuki {
+
+// Small work-stealing pool. Every worker owns a deque: it pops its own jobs
+// LIFO and steals from the others FIFO. Threads that are not workers (the main
+// thread) push into a shared queue and help drain jobs while they wait.
+// With zero workers every job runs inline on submit, which keeps the engine
+// usable on single-core machines and makes results easy to compare.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    struct Counter {
+        std::atomic<int> pending{0};
+        bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    explicit JobSystem(int workers);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int workerCount() const { return (int)threads.size(); }
+    void submit(Counter& counter, Job job);
+    void wait(Counter& counter);
+    // Splits [0, count) into chunks of at least `grain` items and blocks until
+    // all of them ran. Chunk boundaries do not depend on the worker count.
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    static int defaultWorkerCount();
+
+private:
+    struct Task {
+        Job job;
+        Counter* counter = nullptr;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    size_t localQueue() const;
+    bool runOne(size_t self);
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues; // [0] is shared by non-worker threads
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    int queued = 0;
+    bool stopping = false;
+};
+
+JobSystem& jobSystem();
+// Separate pool for long-running work such as asset decodes. Nothing on the
+// main thread ever waits on it, so a decode can never be picked up while the
+// engine tick helps drain jobSystem(). Always has at least one worker.
+JobSystem& assetJobSystem();
+} // namespace yuki
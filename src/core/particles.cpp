@@ -0,0 +1,177 @@
+#include "particles.hpp"
+#include "renderer2d.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace yuki {
+namespace {
+constexpr float kTwoPi = 6.28318f;
+
+// Integrates [begin, end) in place: ages particles, fades alpha, applies gravity,
+// drag (clamped to [0, 1]) and velocity. Dead particles are integrated too and
+// culled afterwards, which keeps the loop branch-free.
+void integrateScalar(size_t begin, size_t end, float dt,
+                     float* __restrict px, float* __restrict py,
+                     float* __restrict vx, float* __restrict vy,
+                     float* __restrict age, const float* __restrict life,
+                     float* __restrict alpha,
+                     const float* __restrict gravity, const float* __restrict drag) {
+    for (size_t i = begin; i < end; ++i) {
+        float a = age[i] + dt;
+        age[i] = a;
+        alpha[i] = 1.0f - a / life[i];
+        float d = std::min(1.0f, std::max(0.0f, 1.0f - drag[i] * dt));
+        float nvx = vx[i] * d;
+        float nvy = (vy[i] + gravity[i] * dt) * d;
+        vx[i] = nvx;
+        vy[i] = nvy;
+        px[i] += nvx * dt;
+        py[i] += nvy * dt;
+    }
+}
+
+#if defined(__SSE2__)
+size_t integrateSse2(size_t n, float dt,
+                     float* px, float* py, float* vx, float* vy,
+                     float* age, const float* life, float* alpha,
+                     const float* gravity, const float* drag) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 a = _mm_add_ps(_mm_loadu_ps(age + i), vdt);
+        _mm_storeu_ps(age + i, a);
+        _mm_storeu_ps(alpha + i, _mm_sub_ps(one, _mm_div_ps(a, _mm_loadu_ps(life + i))));
+        __m128 d = _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(drag + i), vdt));
+        d = _mm_min_ps(one, _mm_max_ps(zero, d));
+        __m128 nvx = _mm_mul_ps(_mm_loadu_ps(vx + i), d);
+        __m128 nvy = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(_mm_loadu_ps(gravity + i), vdt));
+        nvy = _mm_mul_ps(nvy, d);
+        _mm_storeu_ps(vx + i, nvx);
+        _mm_storeu_ps(vy + i, nvy);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(nvx, vdt)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(nvy, vdt)));
+    }
+    return i;
+}
+#endif
+} // namespace
+
+ParticleSystem::ParticleSystem(size_t maxParticles)
+    : maxParticles(maxParticles > 0 ? maxParticles : 1), rng(std::random_device{}()) {}
+
+void ParticleSystem::reserve(size_t n) {
+    if (n <= posX.size()) return;
+    size_t cap = std::max<size_t>(64, posX.size() * 2);
+    while (cap < n) cap *= 2;
+    cap = std::min(cap, maxParticles);
+    for (auto* col : {&posX, &posY, &velX, &velY, &age, &life, &size_, &colR, &colG, &colB, &colA, &gravity, &drag}) {
+        col->resize(cap);
+    }
+    sheetId.resize(cap);
+    frame.resize(cap);
+}
+
+int ParticleSystem::emit(float x, float y, int n, const ParticleEmitParams& p) {
+    if (n <= 0) return 0;
+    size_t room = maxParticles - count;
+    size_t add = std::min((size_t)n, room);
+    if (add == 0) return 0;
+    reserve(count + add);
+    std::uniform_real_distribution<float> angleDist(0.0f, kTwoPi);
+    std::uniform_real_distribution<float> jitterDist(0.0f, 1.0f);
+    float life0 = p.life > 0.0f ? p.life : 1e-4f;
+    for (size_t k = 0; k < add; ++k) {
+        size_t i = count + k;
+        float ang = angleDist(rng);
+        float jx = p.jitter > 0.0f ? jitterDist(rng) * p.jitter - p.jitter * 0.5f : 0.0f;
+        float jy = p.jitter > 0.0f ? jitterDist(rng) * p.jitter - p.jitter * 0.5f : 0.0f;
+        posX[i] = x;
+        posY[i] = y;
+        velX[i] = std::cos(ang) * p.speed + jx;
+        velY[i] = std::sin(ang) * p.speed + jy;
+        age[i] = 0.0f;
+        life[i] = life0;
+        size_[i] = p.size;
+        colR[i] = p.r;
+        colG[i] = p.g;
+        colB[i] = p.b;
+        colA[i] = 1.0f;
+        gravity[i] = p.gravity;
+        drag[i] = p.drag;
+        sheetId[i] = p.sheetId;
+        frame[i] = p.frame;
+    }
+    count += add;
+    return (int)add;
+}
+
+void ParticleSystem::update(float dt) {
+    if (count == 0) return;
+    size_t start = 0;
+#if defined(__SSE2__)
+    start = integrateSse2(count, dt, posX.data(), posY.data(), velX.data(), velY.data(),
+                          age.data(), life.data(), colA.data(), gravity.data(), drag.data());
+#endif
+    integrateScalar(start, count, dt, posX.data(), posY.data(), velX.data(), velY.data(),
+                    age.data(), life.data(), colA.data(), gravity.data(), drag.data());
+    removeDead();
+}
+
+void ParticleSystem::removeDead() {
+    size_t i = 0;
+    while (i < count) {
+        if (age[i] < life[i]) {
+            ++i;
+            continue;
+        }
+        size_t last = --count;
+        if (i == last) break;
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        age[i] = age[last];
+        life[i] = life[last];
+        size_[i] = size_[last];
+        colR[i] = colR[last];
+        colG[i] = colG[last];
+        colB[i] = colB[last];
+        colA[i] = colA[last];
+        gravity[i] = gravity[last];
+        drag[i] = drag[last];
+        sheetId[i] = sheetId[last];
+        frame[i] = frame[last];
+    }
+}
+
+void ParticleSystem::draw(Renderer2D& renderer, bool pixelSnap) const {
+    size_t i = 0;
+    while (i < count) {
+        size_t runEnd = i + 1;
+        while (runEnd < count && sheetId[runEnd] == sheetId[i]) ++runEnd;
+        ParticleQuad* out = renderer.drawParticles(sheetId[i], runEnd - i);
+        for (size_t k = i; k < runEnd; ++k, ++out) {
+            float x = posX[k];
+            float y = posY[k];
+            if (pixelSnap) {
+                x = std::floor(x + 0.5f);
+                y = std::floor(y + 0.5f);
+            }
+            out->x = x;
+            out->y = y;
+            out->size = size_[k];
+            out->r = colR[k];
+            out->g = colG[k];
+            out->b = colB[k];
+            out->a = colA[k];
+            out->frame = frame[k];
+        }
+        i = runEnd;
+    }
+}
+} // namespace yuki
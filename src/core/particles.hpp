@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace yuki {
+class Renderer2D;
+
+struct ParticleEmitParams {
+    float speed = 40.0f;
+    float jitter = 0.0f;
+    float life = 0.5f;
+    float size = 2.0f;
+    float r = 0.7f;
+    float g = 0.85f;
+    float b = 1.0f;
+    float gravity = 0.0f;
+    float drag = 0.0f;
+    int sheetId = -1;
+    int frame = 0;
+};
+
+// Structure-of-arrays particle pool. Live particles occupy [0, count) in every
+// column; dead ones are swap-removed so the update kernel runs over dense data.
+class ParticleSystem {
+public:
+    explicit ParticleSystem(size_t maxParticles = 4096);
+
+    int emit(float x, float y, int count, const ParticleEmitParams& params);
+    void update(float dt);
+    void draw(Renderer2D& renderer, bool pixelSnap) const;
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    size_t capacity() const { return maxParticles; }
+    void setAutoUpdate(bool on) { autoUpdate = on; }
+    bool isAutoUpdate() const { return autoUpdate; }
+
+private:
+    void reserve(size_t n);
+    void removeDead();
+
+    size_t count = 0;
+    size_t maxParticles = 0;
+    bool autoUpdate = false;
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> age, life;
+    std::vector<float> size_;
+    std::vector<float> colR, colG, colB, colA;
+    std::vector<float> gravity, drag;
+    std::vector<int> sheetId, frame;
+    std::mt19937 rng;
+};
+} // namespace yuki
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace yuki {
+
+// Vertex layout shared by Renderer2D and every backend.
+struct RenderVertex {
+    float pos[2];
+    float uv[2];
+    float color[4];
+    float useTex;
+};
+
+enum class TextureFilter { Linear, Nearest };
+enum class PrimitiveMode { Triangles, Lines };
+
+// Everything Renderer2D needs from the graphics API. Renderer2D does all
+// command processing and batching on the CPU and talks to the GPU only
+// through this interface, so the whole draw path can run without a window.
+// Texture handles are backend-defined; 0 is never a valid texture.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    // Pipeline objects (shader, vertex buffer). Called lazily by the first
+    // flush; shutdown() releases them (textures are destroyed by the owner).
+    virtual bool init() = 0;
+    virtual void shutdown() = 0;
+
+    // RGBA8 textures.
+    virtual unsigned int createTexture(int w, int h, const unsigned char* pixels, TextureFilter filter) = 0;
+    // Replaces the whole image; the size may change.
+    virtual void setTextureImage(unsigned int tex, int w, int h, const unsigned char* pixels) = 0;
+    // Writes a w*h region at x,y; rows of `pixels` are rowLength pixels apart.
+    virtual void updateTexture(unsigned int tex, int x, int y, int w, int h, int rowLength, const unsigned char* pixels) = 0;
+    virtual void destroyTexture(unsigned int tex) = 0;
+
+    // One flush: viewport, blending and vertex layout, then any number of
+    // bind/draw calls until endPass().
+    virtual void beginPass(int x, int y, int w, int h) = 0;
+    virtual void setTransform(const float* mvp) = 0; // column-major 4x4
+    virtual void bindTexture(unsigned int tex) = 0;
+    virtual void draw(PrimitiveMode mode, const RenderVertex* vertices, size_t count) = 0;
+    virtual void endPass() = 0;
+
+    // GPU timer queries (GL_TIME_ELAPSED). beginTimer() returns 0 when timing
+    // is unavailable; readTimer() never blocks and releases the query once it
+    // has returned its result.
+    virtual bool hasTimer() const { return false; }
+    virtual unsigned int beginTimer() { return 0; }
+    virtual void endTimer() {}
+    virtual bool readTimer(unsigned int query, uint64_t& ns) {
+        (void)query;
+        (void)ns;
+        return false;
+    }
+};
+
+std::unique_ptr<RenderBackend> createGlBackend();
+
+// Backend for headless runs: accepts every call, keeps no pixels and records
+// what would have reached the GPU.
+class NullRenderBackend : public RenderBackend {
+public:
+    struct Counters {
+        uint64_t passes = 0;
+        uint64_t draws = 0;
+        uint64_t vertices = 0;
+        uint64_t binds = 0;
+        uint64_t texturesCreated = 0;
+        uint64_t textureUpdates = 0;
+        uint64_t textureBytes = 0;
+        uint64_t vertexBytes = 0;
+    };
+
+    bool init() override { return true; }
+    void shutdown() override {}
+    unsigned int createTexture(int w, int h, const unsigned char* pixels, TextureFilter filter) override;
+    void setTextureImage(unsigned int tex, int w, int h, const unsigned char* pixels) override;
+    void updateTexture(unsigned int tex, int x, int y, int w, int h, int rowLength, const unsigned char* pixels) override;
+    void destroyTexture(unsigned int tex) override;
+    void beginPass(int x, int y, int w, int h) override;
+    void setTransform(const float* mvp) override;
+    void bindTexture(unsigned int tex) override;
+    void draw(PrimitiveMode mode, const RenderVertex* vertices, size_t count) override;
+    void endPass() override;
+
+    const Counters& counters() const { return recorded; }
+    int liveTextures() const { return live; }
+
+private:
+    Counters recorded;
+    unsigned int nextTexture = 1;
+    int live = 0;
+};
+
+} // namespace yuki
@@ -0,0 +1,227 @@
+#define GL_GLEXT_PROTOTYPES
+#include "render_backend.hpp"
+#include "log.hpp"
+#include <GLFW/glfw3.h>
+#include <string>
+#include <vector>
+
+namespace yuki {
+namespace {
+unsigned int compileShader(unsigned int type, const char* src) {
+    unsigned int shader = glCreateShader(type);
+    glShaderSource(shader, 1, &src, nullptr);
+    glCompileShader(shader);
+    int success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char info[512];
+        glGetShaderInfoLog(shader, 512, nullptr, info);
+        logError(std::string("Shader compile failed: ") + info);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+unsigned int linkProgram(unsigned int vs, unsigned int fs) {
+    unsigned int prog = glCreateProgram();
+    glAttachShader(prog, vs);
+    glAttachShader(prog, fs);
+    glBindAttribLocation(prog, 0, "a_pos");
+    glBindAttribLocation(prog, 1, "a_uv");
+    glBindAttribLocation(prog, 2, "a_color");
+    glBindAttribLocation(prog, 3, "a_useTex");
+    glLinkProgram(prog);
+    int success = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &success);
+    if (!success) {
+        char info[512];
+        glGetProgramInfoLog(prog, 512, nullptr, info);
+        logError(std::string("Program link failed: ") + info);
+        glDeleteProgram(prog);
+        return 0;
+    }
+    return prog;
+}
+
+class GlRenderBackend : public RenderBackend {
+public:
+    ~GlRenderBackend() override { shutdown(); }
+
+    bool init() override {
+        const char* vsSrc =
+            "#version 120\n"
+            "attribute vec2 a_pos;\n"
+            "attribute vec2 a_uv;\n"
+            "attribute vec4 a_color;\n"
+            "attribute float a_useTex;\n"
+            "uniform mat4 u_mvp;\n"
+            "varying vec2 v_uv;\n"
+            "varying vec4 v_color;\n"
+            "varying float v_useTex;\n"
+            "void main() {\n"
+            " v_uv = a_uv;\n"
+            " v_color = a_color;\n"
+            " v_useTex = a_useTex;\n"
+            " gl_Position = u_mvp * vec4(a_pos, 0.0, 1.0);\n"
+            "}\n";
+        const char* fsSrc =
+            "#version 120\n"
+            "uniform sampler2D u_tex;\n"
+            "varying vec2 v_uv;\n"
+            "varying vec4 v_color;\n"
+            "varying float v_useTex;\n"
+            "void main() {\n"
+            " vec4 c = v_color;\n"
+            " if (v_useTex > 0.5) {\n"
+            "  c *= texture2D(u_tex, v_uv);\n"
+            " }\n"
+            " gl_FragColor = c;\n"
+            "}\n";
+        unsigned int vs = compileShader(GL_VERTEX_SHADER, vsSrc);
+        if (!vs) return false;
+        unsigned int fs = compileShader(GL_FRAGMENT_SHADER, fsSrc);
+        if (!fs) {
+            glDeleteShader(vs);
+            return false;
+        }
+        shaderProgram = linkProgram(vs, fs);
+        glDeleteShader(vs);
+        glDeleteShader(fs);
+        if (!shaderProgram) return false;
+        uniformMvp = glGetUniformLocation(shaderProgram, "u_mvp");
+        uniformTex = glGetUniformLocation(shaderProgram, "u_tex");
+        glGenBuffers(1, &vbo);
+        // GL_TIME_ELAPSED is core in 3.3; the default context may report a
+        // lower version but still expose the extension.
+        timerQueries = glfwExtensionSupported("GL_ARB_timer_query");
+        return uniformMvp >= 0 && uniformTex >= 0 && vbo != 0;
+    }
+
+    void shutdown() override {
+        // Includes queries still in flight; their results are no longer wanted.
+        if (!queries.empty()) {
+            glDeleteQueries((int)queries.size(), queries.data());
+            queries.clear();
+            freeQueries.clear();
+        }
+        timerQueries = false;
+        if (vbo != 0) {
+            glDeleteBuffers(1, &vbo);
+            vbo = 0;
+        }
+        if (shaderProgram != 0) {
+            glDeleteProgram(shaderProgram);
+            shaderProgram = 0;
+        }
+    }
+
+    unsigned int createTexture(int w, int h, const unsigned char* pixels, TextureFilter filter) override {
+        unsigned int texId = 0;
+        glGenTextures(1, &texId);
+        glBindTexture(GL_TEXTURE_2D, texId);
+        GLint mode = filter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mode);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mode);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        return texId;
+    }
+
+    void setTextureImage(unsigned int tex, int w, int h, const unsigned char* pixels) override {
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+
+    void updateTexture(unsigned int tex, int x, int y, int w, int h, int rowLength, const unsigned char* pixels) override {
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    void destroyTexture(unsigned int tex) override {
+        if (tex != 0) glDeleteTextures(1, &tex);
+    }
+
+    void beginPass(int x, int y, int w, int h) override {
+        glViewport(x, y, w, h);
+        glUseProgram(shaderProgram);
+        glActiveTexture(GL_TEXTURE0);
+        glUniform1i(uniformTex, 0);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        for (GLuint attrib = 0; attrib < 4; ++attrib) glEnableVertexAttribArray(attrib);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(RenderVertex), (void*)offsetof(RenderVertex, pos));
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(RenderVertex), (void*)offsetof(RenderVertex, uv));
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(RenderVertex), (void*)offsetof(RenderVertex, color));
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(RenderVertex), (void*)offsetof(RenderVertex, useTex));
+    }
+
+    void setTransform(const float* mvp) override {
+        glUniformMatrix4fv(uniformMvp, 1, GL_FALSE, mvp);
+    }
+
+    void bindTexture(unsigned int tex) override {
+        glBindTexture(GL_TEXTURE_2D, tex);
+    }
+
+    void draw(PrimitiveMode mode, const RenderVertex* vertices, size_t count) override {
+        glBufferData(GL_ARRAY_BUFFER, count * sizeof(RenderVertex), vertices, GL_DYNAMIC_DRAW);
+        glDrawArrays(mode == PrimitiveMode::Lines ? GL_LINES : GL_TRIANGLES, 0, (int)count);
+    }
+
+    void endPass() override {
+        for (GLuint attrib = 0; attrib < 4; ++attrib) glDisableVertexAttribArray(attrib);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glUseProgram(0);
+    }
+
+    bool hasTimer() const override { return timerQueries; }
+
+    unsigned int beginTimer() override {
+        if (!timerQueries) return 0;
+        unsigned int query = 0;
+        if (!freeQueries.empty()) {
+            query = freeQueries.back();
+            freeQueries.pop_back();
+        } else {
+            glGenQueries(1, &query);
+            queries.push_back(query);
+        }
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        return query;
+    }
+
+    void endTimer() override {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+
+    bool readTimer(unsigned int query, uint64_t& ns) override {
+        GLint available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return false;
+        GLuint64 result = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+        ns = (uint64_t)result;
+        freeQueries.push_back(query);
+        return true;
+    }
+
+private:
+    unsigned int shaderProgram = 0;
+    unsigned int vbo = 0;
+    int uniformMvp = -1;
+    int uniformTex = -1;
+    bool timerQueries = false;
+    std::vector<unsigned int> queries; // every query generated
+    std::vector<unsigned int> freeQueries;
+};
+} // namespace
+
+std::unique_ptr<RenderBackend> createGlBackend() {
+    return std::make_unique<GlRenderBackend>();
+}
+
+} // namespace yuki
@@ -0,0 +1,62 @@
+#include "render_backend.hpp"
+
+namespace yuki {
+
+unsigned int NullRenderBackend::createTexture(int w, int h, const unsigned char* pixels, TextureFilter filter) {
+    (void)pixels;
+    (void)filter;
+    recorded.texturesCreated++;
+    recorded.textureBytes += (uint64_t)w * (uint64_t)h * 4;
+    live++;
+    return nextTexture++;
+}
+
+void NullRenderBackend::setTextureImage(unsigned int tex, int w, int h, const unsigned char* pixels) {
+    (void)tex;
+    (void)pixels;
+    recorded.textureUpdates++;
+    recorded.textureBytes += (uint64_t)w * (uint64_t)h * 4;
+}
+
+void NullRenderBackend::updateTexture(unsigned int tex, int x, int y, int w, int h, int rowLength, const unsigned char* pixels) {
+    (void)tex;
+    (void)x;
+    (void)y;
+    (void)rowLength;
+    (void)pixels;
+    recorded.textureUpdates++;
+    recorded.textureBytes += (uint64_t)w * (uint64_t)h * 4;
+}
+
+void NullRenderBackend::destroyTexture(unsigned int tex) {
+    if (tex != 0) live--;
+}
+
+void NullRenderBackend::beginPass(int x, int y, int w, int h) {
+    (void)x;
+    (void)y;
+    (void)w;
+    (void)h;
+    recorded.passes++;
+}
+
+void NullRenderBackend::setTransform(const float* mvp) {
+    (void)mvp;
+}
+
+void NullRenderBackend::bindTexture(unsigned int tex) {
+    (void)tex;
+    recorded.binds++;
+}
+
+void NullRenderBackend::draw(PrimitiveMode mode, const RenderVertex* vertices, size_t count) {
+    (void)mode;
+    (void)vertices;
+    recorded.draws++;
+    recorded.vertices += count;
+    recorded.vertexBytes += count * sizeof(RenderVertex);
+}
+
+void NullRenderBackend::endPass() {}
+
+} // namespace yuki
@@ -1,8 +1,8 @@
-#define GL_GLEXT_PROTOTYPES
 #include "renderer2d.hpp"
-#include <GLFW/glfw3.h>
 #include <cmath>
 #include "log.hpp"
+#include "frame_profiler.hpp"
+#include "alloc_tracker.hpp"
 #include <vector>
 #include <cstring>
 #include <fstream>
@@ -84,43 +84,6 @@ namespace {
         return m;
     }
 
-    unsigned int compileShader(unsigned int type, const char* src) {
-        unsigned int shader = glCreateShader(type);
-        glShaderSource(shader, 1, &src, nullptr);
-        glCompileShader(shader);
-        int success = 0;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-        if (!success) {
-            char info[512];
-            glGetShaderInfoLog(shader, 512, nullptr, info);
-            logError(std::string("Shader compile failed: ") + info);
-            glDeleteShader(shader);
-            return 0;
-        }
-        return shader;
-    }
-
-    unsigned int linkProgram(unsigned int vs, unsigned int fs) {
-        unsigned int prog = glCreateProgram();
-        glAttachShader(prog, vs);
-        glAttachShader(prog, fs);
-        glBindAttribLocation(prog, 0, "a_pos");
-        glBindAttribLocation(prog, 1, "a_uv");
-        glBindAttribLocation(prog, 2, "a_color");
-        glBindAttribLocation(prog, 3, "a_useTex");
-        glLinkProgram(prog);
-        int success = 0;
-        glGetProgramiv(prog, GL_LINK_STATUS, &success);
-        if (!success) {
-            char info[512];
-            glGetProgramInfoLog(prog, 512, nullptr, info);
-            logError(std::string("Program link failed: ") + info);
-            glDeleteProgram(prog);
-            return 0;
-        }
-        return prog;
-    }
-
     struct SpriteVerts {
         float pos[4][2];
         float uv[4][2];
@@ -164,15 +127,8 @@ namespace {
         return out;
     }
 
-    struct Vertex {
-        float pos[2];
-        float uv[2];
-        float color[4];
-        float useTex;
-    };
-
-    void pushQuad(std::vector<Vertex>& verts, const SpriteVerts& spriteVerts, float r, float g, float b, float a, bool textured) {
-        Vertex v0{}, v1{}, v2{}, v3{};
+    void pushQuad(std::vector<RenderVertex>& verts, const SpriteVerts& spriteVerts, float r, float g, float b, float a, bool textured) {
+        RenderVertex v0{}, v1{}, v2{}, v3{};
         v0.pos[0] = spriteVerts.pos[0][0]; v0.pos[1] = spriteVerts.pos[0][1];
         v1.pos[0] = spriteVerts.pos[1][0]; v1.pos[1] = spriteVerts.pos[1][1];
         v2.pos[0] = spriteVerts.pos[2][0]; v2.pos[1] = spriteVerts.pos[2][1];
@@ -344,7 +300,9 @@ namespace {
     }
 }
 
-Renderer2D::Renderer2D() : spriteCounter(0), debugEnabled(true) {
+Renderer2D::Renderer2D() : Renderer2D(createGlBackend()) {}
+
+Renderer2D::Renderer2D(std::unique_ptr<RenderBackend> renderBackend) : backend(std::move(renderBackend)), spriteCounter(0), debugEnabled(true) {
     cameraX = virtualW * 0.5f;
     cameraY = virtualH * 0.5f;
     cameraTargetX = cameraX;
@@ -352,21 +310,9 @@ Renderer2D::Renderer2D() : spriteCounter(0), debugEnabled(true) {
 }
 
 Renderer2D::~Renderer2D() {
-    for (const auto& tex : textures) {
-        if (tex.handle != 0) {
-            glDeleteTextures(1, &tex.handle);
-        }
-    }
-    for (const auto& sheet : spriteSheets) {
-        if (sheet.texture != 0) {
-            glDeleteTextures(1, &sheet.texture);
-        }
-    }
-    for (const auto& f : fonts) {
-        if (f.texture != 0) {
-            glDeleteTextures(1, &f.texture);
-        }
-    }
+    for (const auto& tex : textures) backend->destroyTexture(tex.handle);
+    for (const auto& sheet : spriteSheets) backend->destroyTexture(sheet.texture);
+    for (const auto& f : fonts) backend->destroyTexture(f.texture);
     destroyGraphics();
 }
 
@@ -377,26 +323,37 @@ void Renderer2D::drawRect(float x, float y, float w, float h, float r, float g,
     buffer.push_back(cmd);
 }
 
+bool Renderer2D::decodeImage(const std::string& path, DecodedImage& out) {
+    int w, h, channels;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 4);
+    if (!data) return false;
+    out.w = w;
+    out.h = h;
+    out.pixels.assign(data, data + (size_t)w * (size_t)h * 4);
+    stbi_image_free(data);
+    return true;
+}
+
 int Renderer2D::loadSprite(const std::string& path) {
     std::string key = std::filesystem::path(path).lexically_normal().string();
     auto itCached = spriteCache.find(key);
     if (itCached != spriteCache.end()) return itCached->second;
-    int w, h, channels;
-    unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 4);
-    if (!data) {
+    DecodedImage image;
+    if (!decodeImage(path, image)) {
         logError("Failed to load sprite: " + path);
         return -1;
     }
+    return uploadSprite(path, image);
+}
 
-    unsigned int texId = 0;
-    glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
+int Renderer2D::uploadSprite(const std::string& path, const DecodedImage& image) {
+    std::string key = std::filesystem::path(path).lexically_normal().string();
+    auto itCached = spriteCache.find(key);
+    if (itCached != spriteCache.end()) return itCached->second;
+    unsigned int texId = backend->createTexture(image.w, image.h, image.pixels.data(), TextureFilter::Linear);
+    pending.textureBytes += (uint64_t)image.w * (uint64_t)image.h * 4;
 
-    textures.push_back({texId, w, h});
+    textures.push_back({texId, image.w, image.h});
     int id = (int)textures.size() - 1;
     spriteCache[key] = id;
     return id;
@@ -426,30 +383,33 @@ int Renderer2D::loadSpriteSheet(const std::string& path, int frameW, int frameH)
     std::string key = std::filesystem::path(path).lexically_normal().string() + "|" + std::to_string(frameW) + "x" + std::to_string(frameH);
     auto itCached = sheetCache.find(key);
     if (itCached != sheetCache.end()) return itCached->second;
-    int w, h, channels;
-    unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 4);
-    if (!data) {
+    DecodedImage image;
+    if (!decodeImage(path, image)) {
         logError("Failed to load sprite sheet: " + path);
         return -1;
     }
+    return uploadSpriteSheet(path, frameW, frameH, image);
+}
+
+int Renderer2D::uploadSpriteSheet(const std::string& path, int frameW, int frameH, const DecodedImage& image) {
+    if (frameW <= 0 || frameH <= 0) return -1;
+    std::string key = std::filesystem::path(path).lexically_normal().string() + "|" + std::to_string(frameW) + "x" + std::to_string(frameH);
+    auto itCached = sheetCache.find(key);
+    if (itCached != sheetCache.end()) return itCached->second;
+    int w = image.w;
+    int h = image.h;
     if (w < frameW || h < frameH) {
-        stbi_image_free(data);
         logError("Sprite sheet too small for frame size: " + path);
         return -1;
     }
 
-    unsigned int texId = 0;
-    glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
+    unsigned int texId = backend->createTexture(w, h, image.pixels.data(), TextureFilter::Nearest);
+    pending.textureBytes += (uint64_t)w * (uint64_t)h * 4;
 
     int cols = frameW > 0 ? w / frameW : 0;
     int rows = frameH > 0 ? h / frameH : 0;
     if (cols <= 0 || rows <= 0) {
-        glDeleteTextures(1, &texId);
+        backend->destroyTexture(texId);
         logError("Invalid frame layout for sheet: " + path);
         return -1;
     }
@@ -493,12 +453,8 @@ int Renderer2D::createSpriteSheetFromFrames(int frameW, int frameH, const std::v
             }
         }
     }
-    unsigned int texId = 0;
-    glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texW, texH, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    unsigned int texId = backend->createTexture(texW, texH, pixels.data(), TextureFilter::Nearest);
+    pending.textureBytes += (uint64_t)texW * (uint64_t)texH * 4;
     SpriteSheet sheet;
     sheet.texture = texId;
     sheet.texW = texW;
@@ -534,10 +490,8 @@ bool Renderer2D::updateSpriteSheetFromFrames(int sheetId, int frameW, int frameH
         }
     }
     auto& sheet = spriteSheets[sheetId];
-    glBindTexture(GL_TEXTURE_2D, sheet.texture);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texW, texH, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    backend->setTextureImage(sheet.texture, texW, texH, pixels.data());
+    pending.textureBytes += (uint64_t)texW * (uint64_t)texH * 4;
     sheet.texW = texW;
     sheet.texH = texH;
     sheet.frameW = frameW;
@@ -547,6 +501,18 @@ bool Renderer2D::updateSpriteSheetFromFrames(int sheetId, int frameW, int frameH
     return true;
 }
 
+bool Renderer2D::updateSpriteSheetFrameRect(int sheetId, int frame, int x, int y, int w, int h, const unsigned char* pixels) {
+    if (sheetId < 0 || sheetId >= (int)spriteSheets.size() || !pixels) return false;
+    const auto& sheet = spriteSheets[sheetId];
+    if (frame < 0 || frame >= sheet.cols * sheet.rows) return false;
+    if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > sheet.frameW || y + h > sheet.frameH) return false;
+    int fx = (frame % sheet.cols) * sheet.frameW;
+    int fy = (frame / sheet.cols) * sheet.frameH;
+    backend->updateTexture(sheet.texture, fx + x, fy + y, w, h, sheet.frameW, pixels);
+    pending.textureBytes += (uint64_t)w * (uint64_t)h * 4;
+    return true;
+}
+
 void Renderer2D::drawSpriteFrame(int sheetId, int frame, float x, float y, float rotationDeg, float scaleX, float scaleY, bool flipX, bool flipY, float originX, float originY, float alpha) {
     if (sheetId < 0 || sheetId >= (int)spriteSheets.size()) return;
     RenderCmd cmd{};
@@ -558,19 +524,30 @@ void Renderer2D::drawSpriteFrame(int sheetId, int frame, float x, float y, float
     buffer.push_back(cmd);
 }
 
-int Renderer2D::loadFont(const std::string& imagePath, const std::string& metricsPath) {
-    (void)imagePath;
-    std::string key = std::filesystem::path(metricsPath).lexically_normal().string();
-    auto itCached = fontCache.find(key);
-    if (itCached != fontCache.end()) return itCached->second;
+ParticleQuad* Renderer2D::drawParticles(int sheetId, size_t count) {
+    size_t first = particleQuads.size();
+    particleQuads.resize(first + count);
+    if (!buffer.empty() && buffer.back().type == RenderCmdType::Particles &&
+        buffer.back().particles.sheetId == sheetId &&
+        buffer.back().particles.first + buffer.back().particles.count == first) {
+        buffer.back().particles.count += count;
+    } else {
+        RenderCmd cmd{};
+        cmd.type = RenderCmdType::Particles;
+        cmd.particles.sheetId = sheetId;
+        cmd.particles.first = first;
+        cmd.particles.count = count;
+        buffer.push_back(cmd);
+    }
+    return particleQuads.data() + first;
+}
+
+bool Renderer2D::decodeFont(const std::string& metricsPath, DecodedFont& out) {
     std::vector<int> keys;
     std::unordered_map<int, std::vector<int>> rows;
     int glyphHeight = 0;
     int maxWidth = 0;
-    if (!parseBitmapJson(metricsPath, keys, rows, glyphHeight, maxWidth)) {
-        logError("Failed to parse font metrics: " + metricsPath);
-        return -1;
-    }
+    if (!parseBitmapJson(metricsPath, keys, rows, glyphHeight, maxWidth)) return false;
     int cellW = maxWidth + 1;
     int cellH = glyphHeight + 1;
     int cols = (int)std::ceil(std::sqrt((float)keys.size()));
@@ -578,9 +555,10 @@ int Renderer2D::loadFont(const std::string& imagePath, const std::string& metric
     int rowsCount = (int)std::ceil(keys.size() / (float)cols);
     int texW = cols * cellW;
     int texH = rowsCount * cellH;
-    std::vector<unsigned char> pixels(texW * texH * 4, 0);
+    std::vector<unsigned char>& pixels = out.pixels;
+    pixels.assign((size_t)texW * (size_t)texH * 4, 0);
 
-    Font font;
+    Font& font = out.font;
     font.texW = texW;
     font.texH = texH;
     font.glyphHeight = glyphHeight;
@@ -629,12 +607,29 @@ int Renderer2D::loadFont(const std::string& imagePath, const std::string& metric
         font.spaceAdvance = cellW / 2;
     }
 
-    unsigned int texId = 0;
-    glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texW, texH, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    return true;
+}
+
+int Renderer2D::loadFont(const std::string& imagePath, const std::string& metricsPath) {
+    (void)imagePath;
+    std::string key = std::filesystem::path(metricsPath).lexically_normal().string();
+    auto itCached = fontCache.find(key);
+    if (itCached != fontCache.end()) return itCached->second;
+    DecodedFont decoded;
+    if (!decodeFont(metricsPath, decoded)) {
+        logError("Failed to parse font metrics: " + metricsPath);
+        return -1;
+    }
+    return uploadFont(metricsPath, decoded);
+}
+
+int Renderer2D::uploadFont(const std::string& metricsPath, const DecodedFont& decoded) {
+    std::string key = std::filesystem::path(metricsPath).lexically_normal().string();
+    auto itCached = fontCache.find(key);
+    if (itCached != fontCache.end()) return itCached->second;
+    Font font = decoded.font;
+    unsigned int texId = backend->createTexture(font.texW, font.texH, decoded.pixels.data(), TextureFilter::Nearest);
+    pending.textureBytes += (uint64_t)font.texW * (uint64_t)font.texH * 4;
 
     font.texture = texId;
     fonts.push_back(font);
@@ -863,6 +858,8 @@ void Renderer2D::setDebugEnabled(bool enabled) {
 }
 
 void Renderer2D::flush(int screenWidth, int screenHeight, bool useCamera) {
+    ProfileZone zone("renderer flush");
+    AllocScope tag(AllocTag::Render);
     bool hasRender = !buffer.empty();
     bool hasDebug = debugEnabled && !debugBuffer.empty();
     if (!hasRender && !hasDebug) {
@@ -874,59 +871,64 @@ void Renderer2D::flush(int screenWidth, int screenHeight, bool useCamera) {
         graphicsReady = initGraphics();
         if (!graphicsReady) {
             buffer.clear();
+            particleQuads.clear();
             debugBuffer.clear();
             return;
         }
     }
 
+    pending.flushes++;
+    unsigned int query = gpuQueries.size() < kMaxGpuQueries ? backend->beginTimer() : 0;
+    if (query != 0) gpuQueries.push_back({query, statsFrame});
+
+    int vpX = 0;
+    int vpY = 0;
+    int vpW = screenWidth;
+    int vpH = screenHeight;
     if (pixelPerfectOutput && virtualW > 0 && virtualH > 0) {
         float sx = (float)screenWidth / (float)virtualW;
         float sy = (float)screenHeight / (float)virtualH;
         float s = std::min(sx, sy);
         int scale = (int)std::floor(s);
         if (scale >= 1) {
-            int vpW = virtualW * scale;
-            int vpH = virtualH * scale;
-            int vpX = (screenWidth - vpW) / 2;
-            int vpY = (screenHeight - vpH) / 2;
-            if (vpX < 0) vpX = 0;
-            if (vpY < 0) vpY = 0;
-            glViewport(vpX, vpY, vpW, vpH);
-        } else {
-            glViewport(0, 0, screenWidth, screenHeight);
+            vpW = virtualW * scale;
+            vpH = virtualH * scale;
+            vpX = std::max(0, (screenWidth - vpW) / 2);
+            vpY = std::max(0, (screenHeight - vpH) / 2);
         }
-    } else {
-        glViewport(0, 0, screenWidth, screenHeight);
     }
+    backend->beginPass(vpX, vpY, vpW, vpH);
     Mat4 proj = ortho(0.0f, (float)virtualW, (float)virtualH, 0.0f, -1.0f, 1.0f);
 
-    glUseProgram(shaderProgram);
-    glActiveTexture(GL_TEXTURE0);
-    glUniform1i(uniformTex, 0);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glEnableVertexAttribArray(attribPos);
-    glEnableVertexAttribArray(attribUV);
-    glEnableVertexAttribArray(attribColor);
-    glEnableVertexAttribArray(attribUseTex);
-    glVertexAttribPointer(attribPos, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-    glVertexAttribPointer(attribUV, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(float) * 2));
-    glVertexAttribPointer(attribColor, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(float) * 4));
-    glVertexAttribPointer(attribUseTex, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(float) * 8));
-
-    std::vector<Vertex> batch;
-    batch.reserve((buffer.size() + debugBuffer.size()) * 6);
+    std::vector<RenderVertex> batch;
+    batch.reserve((buffer.size() + particleQuads.size() + debugBuffer.size()) * 6);
     unsigned int currentTex = 0;
-    GLenum currentMode = GL_TRIANGLES;
-    auto flushBatch = [&](GLenum mode, unsigned int tex) {
+    PrimitiveMode currentMode = PrimitiveMode::Triangles;
+    unsigned int boundTex = ~0u; // other code (ImGui) binds between flushes
+    auto flushBatch = [&](PrimitiveMode mode, unsigned int tex) {
         if (batch.empty()) return;
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glBufferData(GL_ARRAY_BUFFER, batch.size() * sizeof(Vertex), batch.data(), GL_DYNAMIC_DRAW);
-        glDrawArrays(mode, 0, (int)batch.size());
+        if (tex != boundTex) {
+            backend->bindTexture(tex);
+            boundTex = tex;
+            pending.textureBinds++;
+        }
+        backend->draw(mode, batch.data(), batch.size());
+        pending.batches++;
+        pending.vertices += (uint32_t)batch.size();
+        pending.vertexBytes += batch.size() * sizeof(RenderVertex);
         batch.clear();
     };
+    // Switching texture or primitive mode ends the current batch.
+    auto setState = [&](PrimitiveMode mode, unsigned int tex) {
+        if (mode == currentMode && tex == currentTex) return;
+        if (!batch.empty()) {
+            if (mode != currentMode) pending.modeBreaks++;
+            else pending.textureBreaks++;
+        }
+        flushBatch(currentMode, currentTex);
+        currentMode = mode;
+        currentTex = tex;
+    };
 
     if (useCamera) {
         float renderX = cameraX + cameraShakeOffsetX;
@@ -953,19 +955,16 @@ void Renderer2D::flush(int screenWidth, int screenHeight, bool useCamera) {
                             mul(scale(cameraZoom, cameraZoom, 1.0f),
                                 translate(-renderX, -renderY, 0.0f))));
         Mat4 mvp = mul(proj, view);
-        glUniformMatrix4fv(uniformMvp, 1, GL_FALSE, mvp.m);
+        backend->setTransform(mvp.m);
     } else {
-        glUniformMatrix4fv(uniformMvp, 1, GL_FALSE, proj.m);
+        backend->setTransform(proj.m);
     }
 
     if (hasRender) {
         for (const auto& cmd : buffer) {
+            pending.commands[(int)cmd.type]++;
             if (cmd.type == RenderCmdType::Rect) {
-                if (currentMode != GL_TRIANGLES || currentTex != 0) {
-                    flushBatch(currentMode, currentTex);
-                    currentMode = GL_TRIANGLES;
-                    currentTex = 0;
-                }
+                setState(PrimitiveMode::Triangles, 0);
                 SpriteVerts verts{};
                 verts.pos[0][0] = cmd.rect.x; verts.pos[0][1] = cmd.rect.y;
                 verts.pos[1][0] = cmd.rect.x + cmd.rect.w; verts.pos[1][1] = cmd.rect.y;
@@ -989,11 +988,7 @@ void Renderer2D::flush(int screenWidth, int screenHeight, bool useCamera) {
                         verts.uv[i][1] = 1.0f - verts.uv[i][1];
                     }
                 }
-                if (currentMode != GL_TRIANGLES || currentTex != tex.handle) {
-                    flushBatch(currentMode, currentTex);
-                    currentMode = GL_TRIANGLES;
-                    currentTex = tex.handle;
-                }
+                setState(PrimitiveMode::Triangles, tex.handle);
                 pushQuad(batch, verts, 1.0f, 1.0f, 1.0f, cmd.sprite.alpha, true);
             } else if (cmd.type == RenderCmdType::SpriteFrame) {
                 if (cmd.spriteFrame.sheetId < 0 || cmd.spriteFrame.sheetId >= (int)spriteSheets.size()) {
@@ -1026,22 +1021,59 @@ void Renderer2D::flush(int screenWidth, int screenHeight, bool useCamera) {
                         verts.uv[i][1] = v0 + (v1 - verts.uv[i][1]);
                     }
                 }
-                if (currentMode != GL_TRIANGLES || currentTex != sheet.texture) {
-                    flushBatch(currentMode, currentTex);
-                    currentMode = GL_TRIANGLES;
-                    currentTex = sheet.texture;
-                }
+                setState(PrimitiveMode::Triangles, sheet.texture);
                 pushQuad(batch, verts, 1.0f, 1.0f, 1.0f, cmd.spriteFrame.alpha, true);
+            } else if (cmd.type == RenderCmdType::Particles) {
+                pending.particleQuads += (uint32_t)cmd.particles.count;
+                const ParticleQuad* quads = particleQuads.data() + cmd.particles.first;
+                if (cmd.particles.sheetId < 0) {
+                    setState(PrimitiveMode::Triangles, 0);
+                    SpriteVerts verts{};
+                    for (size_t i = 0; i < cmd.particles.count; ++i) {
+                        const ParticleQuad& q = quads[i];
+                        float half = q.size * 0.5f;
+                        verts.pos[0][0] = q.x - half; verts.pos[0][1] = q.y - half;
+                        verts.pos[1][0] = q.x + half; verts.pos[1][1] = q.y - half;
+                        verts.pos[2][0] = q.x + half; verts.pos[2][1] = q.y + half;
+                        verts.pos[3][0] = q.x - half; verts.pos[3][1] = q.y + half;
+                        pushQuad(batch, verts, q.r, q.g, q.b, q.a, false);
+                    }
+                    continue;
+                }
+                if (cmd.particles.sheetId >= (int)spriteSheets.size()) continue;
+                const auto& sheet = spriteSheets[cmd.particles.sheetId];
+                int maxFrames = sheet.cols * sheet.rows;
+                if (sheet.frameW <= 0 || sheet.frameH <= 0 || sheet.texW <= 0 || sheet.texH <= 0 || maxFrames <= 0) continue;
+                setState(PrimitiveMode::Triangles, sheet.texture);
+                float fw = (float)sheet.frameW;
+                float fh = (float)sheet.frameH;
+                SpriteVerts verts{};
+                for (size_t i = 0; i < cmd.particles.count; ++i) {
+                    const ParticleQuad& q = quads[i];
+                    int frameIdx = q.frame % maxFrames;
+                    if (frameIdx < 0) frameIdx += maxFrames;
+                    int col = frameIdx % sheet.cols;
+                    int row = frameIdx / sheet.cols;
+                    float u0 = (float)(col * sheet.frameW) / (float)sheet.texW;
+                    float v0 = (float)(row * sheet.frameH) / (float)sheet.texH;
+                    float u1 = (float)((col + 1) * sheet.frameW) / (float)sheet.texW;
+                    float v1 = (float)((row + 1) * sheet.frameH) / (float)sheet.texH;
+                    verts.pos[0][0] = q.x; verts.pos[0][1] = q.y;
+                    verts.pos[1][0] = q.x + fw; verts.pos[1][1] = q.y;
+                    verts.pos[2][0] = q.x + fw; verts.pos[2][1] = q.y + fh;
+                    verts.pos[3][0] = q.x; verts.pos[3][1] = q.y + fh;
+                    verts.uv[0][0] = u0; verts.uv[0][1] = v0;
+                    verts.uv[1][0] = u1; verts.uv[1][1] = v0;
+                    verts.uv[2][0] = u1; verts.uv[2][1] = v1;
+                    verts.uv[3][0] = u0; verts.uv[3][1] = v1;
+                    pushQuad(batch, verts, 1.0f, 1.0f, 1.0f, q.a, true);
+                }
             } else if (cmd.type == RenderCmdType::Text) {
                 if (cmd.text.fontId < 0 || cmd.text.fontId >= (int)fonts.size()) continue;
                 const Font& font = fonts[cmd.text.fontId];
                 TextLayout layout = layoutText(font, cmd.text.text, cmd.text.scale, cmd.text.maxWidth, cmd.text.lineHeight);
                 float step = (cmd.text.lineHeight > 0.0f ? cmd.text.lineHeight : (float)font.lineHeight) * cmd.text.scale;
-                if (currentMode != GL_TRIANGLES || currentTex != font.texture) {
-                    flushBatch(currentMode, currentTex);
-                    currentMode = GL_TRIANGLES;
-                    currentTex = font.texture;
-                }
+                setState(PrimitiveMode::Triangles, font.texture);
                 for (size_t li = 0; li < layout.lines.size(); ++li) {
                     float lineW = layout.widths[li];
                     float startX = cmd.text.x;
@@ -1079,16 +1111,14 @@ void Renderer2D::flush(int screenWidth, int screenHeight, bool useCamera) {
     }
     flushBatch(currentMode, currentTex);
     buffer.clear();
+    particleQuads.clear();
 
     if (hasDebug) {
+        pending.debugCommands += (uint32_t)debugBuffer.size();
         for (const auto& d : debugBuffer) {
             if (d.isLine) {
-                if (currentMode != GL_LINES || currentTex != 0) {
-                    flushBatch(currentMode, currentTex);
-                    currentMode = GL_LINES;
-                    currentTex = 0;
-                }
-                Vertex v0{}, v1{};
+                setState(PrimitiveMode::Lines, 0);
+                RenderVertex v0{}, v1{};
                 v0.pos[0] = d.x1; v0.pos[1] = d.y1;
                 v1.pos[0] = d.x2; v1.pos[1] = d.y2;
                 v0.uv[0] = v0.uv[1] = v1.uv[0] = v1.uv[1] = 0.0f;
@@ -1100,21 +1130,17 @@ void Renderer2D::flush(int screenWidth, int screenHeight, bool useCamera) {
                 batch.push_back(v0);
                 batch.push_back(v1);
             } else {
-                if (currentMode != GL_LINES || currentTex != 0) {
-                    flushBatch(currentMode, currentTex);
-                    currentMode = GL_LINES;
-                    currentTex = 0;
-                }
+                setState(PrimitiveMode::Lines, 0);
                 float x = d.x1;
                 float y = d.y1;
                 float w = d.x2;
                 float h = d.y2;
-                Vertex v0{}, v1{}, v2{}, v3{};
+                RenderVertex v0{}, v1{}, v2{}, v3{};
                 v0.pos[0] = x; v0.pos[1] = y;
                 v1.pos[0] = x + w; v1.pos[1] = y;
                 v2.pos[0] = x + w; v2.pos[1] = y + h;
                 v3.pos[0] = x; v3.pos[1] = y + h;
-                Vertex arr[4] = {v0, v1, v2, v3};
+                RenderVertex arr[4] = {v0, v1, v2, v3};
                 for (int i = 0; i < 4; ++i) {
                     arr[i].uv[0] = arr[i].uv[1] = 0.0f;
                     arr[i].useTex = 0.0f;
@@ -1132,74 +1158,53 @@ void Renderer2D::flush(int screenWidth, int screenHeight, bool useCamera) {
     }
     flushBatch(currentMode, currentTex);
     debugBuffer.clear();
-    glDisableVertexAttribArray(attribPos);
-    glDisableVertexAttribArray(attribUV);
-    glDisableVertexAttribArray(attribColor);
-    glDisableVertexAttribArray(attribUseTex);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glUseProgram(0);
+    backend->endPass();
+    if (query != 0) backend->endTimer();
 }
 
-bool Renderer2D::initGraphics() {
-    const char* vsSrc =
-        "#version 120\n"
-        "attribute vec2 a_pos;\n"
-        "attribute vec2 a_uv;\n"
-        "attribute vec4 a_color;\n"
-        "attribute float a_useTex;\n"
-        "uniform mat4 u_mvp;\n"
-        "varying vec2 v_uv;\n"
-        "varying vec4 v_color;\n"
-        "varying float v_useTex;\n"
-        "void main() {\n"
-        " v_uv = a_uv;\n"
-        " v_color = a_color;\n"
-        " v_useTex = a_useTex;\n"
-        " gl_Position = u_mvp * vec4(a_pos, 0.0, 1.0);\n"
-        "}\n";
-    const char* fsSrc =
-        "#version 120\n"
-        "uniform sampler2D u_tex;\n"
-        "varying vec2 v_uv;\n"
-        "varying vec4 v_color;\n"
-        "varying float v_useTex;\n"
-        "void main() {\n"
-        " vec4 c = v_color;\n"
-        " if (v_useTex > 0.5) {\n"
-        "  c *= texture2D(u_tex, v_uv);\n"
-        " }\n"
-        " gl_FragColor = c;\n"
-        "}\n";
-    unsigned int vs = compileShader(GL_VERTEX_SHADER, vsSrc);
-    if (!vs) return false;
-    unsigned int fs = compileShader(GL_FRAGMENT_SHADER, fsSrc);
-    if (!fs) {
-        glDeleteShader(vs);
-        return false;
+void Renderer2D::endFrame() {
+    uint64_t frame = statsFrame++;
+    collectGpuQueries();
+    RenderStats done = pending;
+    done.gpuMs = stats.gpuMs;
+    done.gpuLatency = stats.gpuLatency;
+    if (gpuResolved) {
+        done.gpuMs = (double)gpuResolvedNs / 1e6;
+        done.gpuLatency = (uint32_t)(frame - gpuResolvedFrame);
+        gpuResolved = false;
     }
-    shaderProgram = linkProgram(vs, fs);
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    if (!shaderProgram) return false;
-    attribPos = 0;
-    attribUV = 1;
-    attribColor = 2;
-    attribUseTex = 3;
-    uniformMvp = glGetUniformLocation(shaderProgram, "u_mvp");
-    uniformTex = glGetUniformLocation(shaderProgram, "u_tex");
-    glGenBuffers(1, &vbo);
-    return uniformMvp >= 0 && uniformTex >= 0 && vbo != 0;
+    stats = done;
+    pending = RenderStats();
 }
 
-void Renderer2D::destroyGraphics() {
-    if (vbo != 0) {
-        glDeleteBuffers(1, &vbo);
-        vbo = 0;
-    }
-    if (shaderProgram != 0) {
-        glDeleteProgram(shaderProgram);
-        shaderProgram = 0;
+// Queries finish in issue order, so once a result for a later frame arrives
+// every query of the frame being summed has been read.
+void Renderer2D::collectGpuQueries() {
+    while (!gpuQueries.empty()) {
+        GpuQuery q = gpuQueries.front();
+        uint64_t ns = 0;
+        if (!backend->readTimer(q.id, ns)) break;
+        gpuQueries.pop_front();
+        if (q.frame != gpuFrame) {
+            if (gpuFrameNs > 0) {
+                gpuResolved = true;
+                gpuResolvedFrame = gpuFrame;
+                gpuResolvedNs = gpuFrameNs;
+            }
+            gpuFrame = q.frame;
+            gpuFrameNs = 0;
+        }
+        gpuFrameNs += ns;
     }
+}
+
+bool Renderer2D::initGraphics() {
+    return backend->init();
+}
+
+void Renderer2D::destroyGraphics() {
+    gpuQueries.clear();
+    backend->shutdown();
     graphicsReady = false;
 }
 
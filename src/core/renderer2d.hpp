@@ -1,4 +1,8 @@
 #pragma once
+#include "render_backend.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -21,7 +25,14 @@ struct SpriteTransform {
         : x(px), y(py), rotationDeg(rotDeg), scaleX(sx), scaleY(sy), flipX(fx), flipY(fy), originX(ox), originY(oy) {}
 };
 
-enum class RenderCmdType { Rect, Sprite, Text, SpriteFrame };
+struct ParticleQuad {
+    float x, y;
+    float size;
+    float r, g, b, a;
+    int frame;
+};
+
+enum class RenderCmdType { Rect, Sprite, Text, SpriteFrame, Particles };
 
 struct RenderCmd {
     RenderCmdType type;
@@ -60,11 +71,39 @@ struct RenderCmd {
         float lineHeight = 0.0f;
         int align = 0; // 0 left, 1 center, 2 right
     } text;
+    struct ParticleData {
+        int sheetId = -1; // -1 draws untextured squares centered on x/y
+        size_t first = 0;
+        size_t count = 0;
+    } particles;
+};
+
+// Counters for one frame of rendering, summed over every flush() of the
+// frame. A batch is one glDrawArrays call; it ends early ("breaks") when the
+// next command needs another texture or primitive mode.
+struct RenderStats {
+    uint32_t flushes = 0;
+    uint32_t commands[5] = {}; // indexed by RenderCmdType
+    uint32_t debugCommands = 0;
+    uint32_t particleQuads = 0;
+    uint32_t batches = 0;
+    uint32_t vertices = 0;
+    uint32_t textureBinds = 0; // binds that changed the bound texture
+    uint32_t textureBreaks = 0;
+    uint32_t modeBreaks = 0;
+    uint64_t vertexBytes = 0;
+    uint64_t textureBytes = 0; // texture uploads (loads, sheet updates)
+    // GL_TIME_ELAPSED of the flushes of an earlier frame (gpuLatency frames
+    // back); negative when timer queries are unavailable or nothing has
+    // resolved yet.
+    double gpuMs = -1.0;
+    uint32_t gpuLatency = 0;
 };
 
 class Renderer2D {
 public:
-    Renderer2D();
+    Renderer2D(); // OpenGL backend
+    explicit Renderer2D(std::unique_ptr<RenderBackend> backend);
     ~Renderer2D();
 
     void drawRect(float x, float y, float w, float h, float r, float g, float b, float a = 1.0f);
@@ -75,8 +114,12 @@ public:
     int loadSpriteSheet(const std::string& path, int frameW, int frameH);
     int createSpriteSheetFromFrames(int frameW, int frameH, const std::vector<std::vector<unsigned char>>& frames);
     bool updateSpriteSheetFromFrames(int sheetId, int frameW, int frameH, const std::vector<std::vector<unsigned char>>& frames);
+    // Re-uploads a w*h region of one frame of a sheet built from frames; `pixels`
+    // points at the region's first pixel inside a frame that is frameW wide.
+    bool updateSpriteSheetFrameRect(int sheetId, int frame, int x, int y, int w, int h, const unsigned char* pixels);
     unsigned int getSpriteSheetGlHandle(int sheetId) const;
     void drawSpriteFrame(int sheetId, int frame, float x, float y, float rotationDeg, float scaleX, float scaleY, bool flipX, bool flipY, float originX = -1.0f, float originY = -1.0f, float alpha = 1.0f);
+    ParticleQuad* drawParticles(int sheetId, size_t count);
     int loadFont(const std::string& imagePath, const std::string& metricsPath);
     unsigned int getFontGlHandle(int fontId) const;
     void drawText(int fontId, const std::string& text, float x, float y);
@@ -113,6 +156,24 @@ public:
         std::unordered_map<int, FontGlyph> glyphs;
     };
 
+    // The loaders are split into a CPU decode, safe to run on worker threads,
+    // and a GL upload that must run on the main thread. Uploads share the
+    // loaders' caches, so a path decoded twice still maps to one id.
+    struct DecodedImage {
+        int w = 0;
+        int h = 0;
+        std::vector<unsigned char> pixels;
+    };
+    struct DecodedFont {
+        Font font;
+        std::vector<unsigned char> pixels;
+    };
+    static bool decodeImage(const std::string& path, DecodedImage& out);
+    static bool decodeFont(const std::string& metricsPath, DecodedFont& out);
+    int uploadSprite(const std::string& path, const DecodedImage& image);
+    int uploadSpriteSheet(const std::string& path, int frameW, int frameH, const DecodedImage& image);
+    int uploadFont(const std::string& metricsPath, const DecodedFont& decoded);
+
     void setVirtualResolution(int w, int h);
     int getVirtualWidth() const { return virtualW; }
     int getVirtualHeight() const { return virtualH; }
@@ -144,12 +205,22 @@ public:
     bool isDebugEnabled() const { return debugEnabled; }
 
     void flush(int screenWidth, int screenHeight, bool useCamera = true);
+    // Publishes the counters gathered since the previous call as getStats()
+    // and collects finished GPU timer queries. Called once per frame, after
+    // the last flush.
+    void endFrame();
+    const RenderStats& getStats() const { return stats; }
+    bool hasGpuTimer() const { return backend->hasTimer(); }
+    RenderBackend& getBackend() { return *backend; }
 
 private:
     bool initGraphics();
     void destroyGraphics();
 
+    std::unique_ptr<RenderBackend> backend;
+
     std::vector<RenderCmd> buffer;
+    std::vector<ParticleQuad> particleQuads;
     int spriteCounter;
     struct DebugCmd {
         bool isLine;
@@ -187,17 +258,25 @@ private:
     float cameraShakeAccum = 0.0f;
     float cameraShakeOffsetX = 0.0f;
     float cameraShakeOffsetY = 0.0f;
-    unsigned int shaderProgram = 0;
-    unsigned int vbo = 0;
-    int attribPos = -1;
-    int attribUV = -1;
-    int attribColor = -1;
-    int attribUseTex = -1;
-    int uniformMvp = -1;
-    int uniformTex = -1;
     bool graphicsReady = false;
     std::vector<SpriteSheet> spriteSheets;
 
+    RenderStats stats;    // last completed frame
+    RenderStats pending;  // frame in progress
+    uint64_t statsFrame = 0;
+    struct GpuQuery {
+        unsigned int id;
+        uint64_t frame;
+    };
+    static constexpr size_t kMaxGpuQueries = 16; // stop timing if the GPU falls this far behind
+    std::deque<GpuQuery> gpuQueries; // issued, oldest first
+    uint64_t gpuFrame = 0;           // frame whose results are being summed
+    uint64_t gpuFrameNs = 0;
+    bool gpuResolved = false;        // a frame completed since the last endFrame()
+    uint64_t gpuResolvedFrame = 0;
+    uint64_t gpuResolvedNs = 0;
+    void collectGpuQueries();
+
     std::unordered_map<std::string, int> spriteCache;
     std::unordered_map<std::string, int> sheetCache;
     std::unordered_map<std::string, int> fontCache;
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace yuki {
+
+// Generational slot map. Values live packed in `dense` so per-frame loops walk
+// contiguous memory; handles index a slot table that points into it.
+// A handle is (generation << kIndexBits) | (slot + 1): it is always > 0, the
+// first generation yields 1, 2, 3..., and erasing a slot bumps its generation
+// so handles held by scripts past an erase no longer resolve. A slot whose
+// generation is exhausted is retired instead of reused, so a stale handle can
+// never alias a newer value.
+template <typename T>
+class SlotMap {
+public:
+    using Handle = int;
+    static constexpr int kIndexBits = 20;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr uint32_t kGenerationMask = (1u << (31 - kIndexBits)) - 1;
+
+    Handle insert(T value) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (slots.size() >= kIndexMask) return -1;
+            slot = (uint32_t)slots.size();
+            slots.push_back(Slot{});
+        }
+        slots[slot].dense = (uint32_t)dense.size();
+        slots[slot].live = true;
+        dense.push_back(std::move(value));
+        denseToSlot.push_back(slot);
+        return makeHandle(slot);
+    }
+
+    T* get(Handle h) {
+        uint32_t slot;
+        if (!resolve(h, slot)) return nullptr;
+        return &dense[slots[slot].dense];
+    }
+    const T* get(Handle h) const {
+        uint32_t slot;
+        if (!resolve(h, slot)) return nullptr;
+        return &dense[slots[slot].dense];
+    }
+    bool contains(Handle h) const {
+        uint32_t slot;
+        return resolve(h, slot);
+    }
+
+    // Swap-removes the value; the last dense element moves into its place, so
+    // index-based loops that erase should not advance past the current index.
+    bool erase(Handle h) {
+        uint32_t slot;
+        if (!resolve(h, slot)) return false;
+        uint32_t idx = slots[slot].dense;
+        uint32_t last = (uint32_t)dense.size() - 1;
+        if (idx != last) {
+            dense[idx] = std::move(dense[last]);
+            denseToSlot[idx] = denseToSlot[last];
+            slots[denseToSlot[idx]].dense = idx;
+        }
+        dense.pop_back();
+        denseToSlot.pop_back();
+        release(slot);
+        return true;
+    }
+
+    void clear() {
+        for (uint32_t slot : denseToSlot) release(slot);
+        dense.clear();
+        denseToSlot.clear();
+    }
+
+    size_t size() const { return dense.size(); }
+    bool empty() const { return dense.empty(); }
+    T& at(size_t denseIndex) { return dense[denseIndex]; }
+    const T& at(size_t denseIndex) const { return dense[denseIndex]; }
+    Handle handleAt(size_t denseIndex) const { return makeHandle(denseToSlot[denseIndex]); }
+    T* data() { return dense.data(); }
+    typename std::vector<T>::iterator begin() { return dense.begin(); }
+    typename std::vector<T>::iterator end() { return dense.end(); }
+    typename std::vector<T>::const_iterator begin() const { return dense.begin(); }
+    typename std::vector<T>::const_iterator end() const { return dense.end(); }
+
+private:
+    struct Slot {
+        uint32_t dense = 0;
+        uint32_t generation = 0;
+        bool live = false;
+    };
+
+    void release(uint32_t slot) {
+        Slot& s = slots[slot];
+        s.live = false;
+        // Last generation used: the slot stays dead for good.
+        if (s.generation == kGenerationMask) return;
+        ++s.generation;
+        freeSlots.push_back(slot);
+    }
+
+    Handle makeHandle(uint32_t slot) const {
+        return (Handle)((slots[slot].generation << kIndexBits) | (slot + 1));
+    }
+    bool resolve(Handle h, uint32_t& slot) const {
+        if (h <= 0) return false;
+        uint32_t raw = (uint32_t)h;
+        uint32_t idx = raw & kIndexMask;
+        if (idx == 0 || idx > slots.size()) return false;
+        slot = idx - 1;
+        const Slot& s = slots[slot];
+        return s.live && s.generation == (raw >> kIndexBits);
+    }
+
+    std::vector<T> dense;
+    std::vector<uint32_t> denseToSlot;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+};
+} // namespace yuki
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace yuki {
+// Bump on releases and whenever script ASTs change shape; cached ASTs built by
+// another version are ignored.
+inline constexpr const char* kEngineVersion = "0.2.0-dev";
+}
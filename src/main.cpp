@@ -3,46 +3,63 @@
 #include "log.hpp"
 #include "config.hpp"
 #include "engine_bindings.hpp"
-#include "../script/yuki_script_loader.hpp"
-#include "../script/token.hpp"
-#include "../script/parser.hpp"
+#include "renderer2d.hpp"
+#include "render_backend.hpp"
+#include "frame_profiler.hpp"
+#include "alloc_tracker.hpp"
+#include "bench.hpp"
+#include "../script/ast_cache.hpp"
 #include "../script/ast.hpp"
 #include "../script/interpreter.hpp"
+#include "../script/frame_arena.hpp"
+#include "../script/script_profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
 #include <string>
 #include <vector>
 #include <filesystem>
 
 namespace {
-int headlessRun(const std::string& scriptPath, bool execute) {
-    yuki::ScriptLoader loader(scriptPath);
-    std::string content = loader.load();
-    if (content.empty()) {
-        yuki::logError("Failed to load script: " + scriptPath);
-        return 1;
-    }
-    yuki::Tokenizer tokenizer(content);
-    std::vector<yuki::Token> tokens = tokenizer.scanTokens();
-    if (tokenizer.hadError()) {
-        for (const auto& err : tokenizer.getErrors()) {
-            yuki::logError(err);
-        }
-        return 1;
-    }
-    yuki::Parser parser(tokens);
-    std::vector<std::unique_ptr<yuki::Stmt>> statements = parser.parse();
-    if (parser.hadError()) {
-        for (const auto& err : parser.getErrors()) {
-            yuki::logError(err);
-        }
-        return 1;
+constexpr size_t kProfileReportLines = 15;
+constexpr size_t kAllocSiteLines = 15;
+constexpr const char* kSimulateUsage = "Usage: yuki2d --simulate <script.ys> <steps> [dt] [--profile <out.folded>] [--trace <out.json>] [--render] [--max-batches <n>] [--allocs]";
+
+// Whole-argument number; std::stod would accept "5x" and throw on "--x".
+bool parseNumberArg(const char* text, double& out) {
+    char* end = nullptr;
+    out = std::strtod(text, &end);
+    return end != text && *end == '\0';
+}
+
+bool parseOrLog(const std::string& scriptPath, yuki::ScriptModule& script) {
+    std::vector<std::string> errors;
+    if (yuki::parseScriptFile(scriptPath, script, errors)) return true;
+    for (const auto& err : errors) {
+        yuki::logError(err);
     }
+    return false;
+}
+
+void writeProfile(const std::string& path) {
+    yuki::ScriptProfiler& profiler = yuki::scriptProfiler();
+    profiler.stop();
+    for (const auto& line : profiler.report(kProfileReportLines)) yuki::logInfo(line);
+    if (profiler.writeCollapsed(path)) yuki::logInfo("Script profile written to " + path);
+    else yuki::logError("Could not write script profile: " + path);
+}
+
+int headlessRun(const std::string& scriptPath, bool execute) {
+    yuki::ScriptModule script;
+    if (!parseOrLog(scriptPath, script)) return 1;
     if (!execute) return 0;
     yuki::Interpreter interpreter;
     yuki::EngineBindings::init(nullptr, nullptr, &interpreter);
     std::filesystem::path scriptDir = std::filesystem::path(scriptPath).parent_path();
     yuki::EngineBindings::setAssetBase(std::filesystem::absolute(scriptDir).lexically_normal().string());
-    interpreter.exec(statements);
-    interpreter.retainModule(std::move(statements));
+    interpreter.exec(script.statements);
+    interpreter.retainModule(std::move(script));
     if (interpreter.hasRuntimeErrors()) return 1;
     yuki::Value initFn = yuki::Value::nilVal();
     auto initVal = interpreter.env->get("init");
@@ -54,35 +71,65 @@ int headlessRun(const std::string& scriptPath, bool execute) {
     return interpreter.hasRuntimeErrors() ? 1 : 0;
 }
 
-int headlessSimulate(const std::string& scriptPath, int steps, double dt) {
-    yuki::ScriptLoader loader(scriptPath);
-    std::string content = loader.load();
-    if (content.empty()) {
-        yuki::logError("Failed to load script: " + scriptPath);
+struct SimulateOptions {
+    bool render = false; // draw every step through a NullRenderBackend
+    int maxBatches = -1; // fail when a frame needs more draw calls; -1 = no limit
+    bool allocs = false; // report allocations per frame and the top sites
+};
+
+// Frame totals of a --render simulation, checked against what the backend saw.
+struct SimulateRenderTotals {
+    int frames = 0;
+    uint64_t commands = 0;
+    uint64_t batches = 0;
+    uint64_t breaks = 0;
+    uint64_t binds = 0;
+    uint64_t vertices = 0;
+    uint32_t maxBatches = 0;
+};
+
+int checkRenderTotals(const SimulateRenderTotals& totals, yuki::NullRenderBackend& backend, const SimulateOptions& options) {
+    const yuki::NullRenderBackend::Counters& seen = backend.counters();
+    double frames = (double)std::max(totals.frames, 1);
+    char line[200];
+    std::snprintf(line, sizeof(line), "Rendered %d frames: avg %.1f commands, %.1f batches (max %u), %.1f breaks, %.1f binds, %.0f vertices",
+                  totals.frames, totals.commands / frames, totals.batches / frames, totals.maxBatches, totals.breaks / frames,
+                  totals.binds / frames, totals.vertices / frames);
+    yuki::logInfo(line);
+    if (seen.draws != totals.batches || seen.binds != totals.binds || seen.vertices != totals.vertices) {
+        std::snprintf(line, sizeof(line), "Render stats disagree with the backend: %llu/%llu draws, %llu/%llu binds, %llu/%llu vertices",
+                      (unsigned long long)totals.batches, (unsigned long long)seen.draws, (unsigned long long)totals.binds,
+                      (unsigned long long)seen.binds, (unsigned long long)totals.vertices, (unsigned long long)seen.vertices);
+        yuki::logError(line);
         return 1;
     }
-    yuki::Tokenizer tokenizer(content);
-    std::vector<yuki::Token> tokens = tokenizer.scanTokens();
-    if (tokenizer.hadError()) {
-        for (const auto& err : tokenizer.getErrors()) {
-            yuki::logError(err);
-        }
+    if (options.maxBatches >= 0 && totals.maxBatches > (uint32_t)options.maxBatches) {
+        yuki::logError("A frame needed " + std::to_string(totals.maxBatches) + " batches (limit " + std::to_string(options.maxBatches) + ")");
         return 1;
     }
-    yuki::Parser parser(tokens);
-    std::vector<std::unique_ptr<yuki::Stmt>> statements = parser.parse();
-    if (parser.hadError()) {
-        for (const auto& err : parser.getErrors()) {
-            yuki::logError(err);
-        }
-        return 1;
+    return 0;
+}
+
+int headlessSimulate(const std::string& scriptPath, int steps, double dt, const SimulateOptions& options) {
+    yuki::ScriptModule script;
+    if (!parseOrLog(scriptPath, script)) return 1;
+    auto backend = std::make_unique<yuki::NullRenderBackend>();
+    yuki::NullRenderBackend& nullBackend = *backend;
+    std::unique_ptr<yuki::Renderer2D> renderer;
+    if (options.render) {
+        renderer = std::make_unique<yuki::Renderer2D>(std::move(backend));
+        renderer->setDebugEnabled(false);
     }
     yuki::Interpreter interpreter;
-    yuki::EngineBindings::init(nullptr, nullptr, &interpreter);
+    yuki::EngineBindings::init(nullptr, renderer.get(), &interpreter);
+    // Drop engine state that points at the renderer before it goes away.
+    struct ResetBindings {
+        ~ResetBindings() { yuki::EngineBindings::init(nullptr, nullptr, nullptr); }
+    } resetBindings;
     std::filesystem::path scriptDir = std::filesystem::path(scriptPath).parent_path();
     yuki::EngineBindings::setAssetBase(std::filesystem::absolute(scriptDir).lexically_normal().string());
-    interpreter.exec(statements);
-    interpreter.retainModule(std::move(statements));
+    interpreter.exec(script.statements);
+    interpreter.retainModule(std::move(script));
     if (interpreter.hasRuntimeErrors()) return 1;
 
     yuki::Value initFn = yuki::Value::nilVal();
@@ -97,17 +144,46 @@ int headlessSimulate(const std::string& scriptPath, int steps, double dt) {
         if (interpreter.hasRuntimeErrors()) return 1;
     }
 
+    yuki::EngineConfig config;
+    SimulateRenderTotals totals;
+    yuki::FrameProfiler& frames = yuki::frameProfiler();
+    yuki::AllocTracker& allocs = yuki::allocTracker();
+    // Loading and init() are not part of the per-frame numbers.
+    allocs.reset();
+    allocs.setRecordSites(options.allocs);
     for (int i = 0; i < steps; i++) {
+        frames.beginFrame();
         if (updateFn.isFunction()) {
+            yuki::ProfileZone zone("script update");
+            yuki::AllocScope tag(yuki::AllocTag::Script);
             std::vector<yuki::Value> args;
             args.push_back(yuki::Value::number(dt));
             interpreter.callFunction(updateFn, args);
             if (interpreter.hasRuntimeErrors()) return 1;
         }
         yuki::EngineBindings::update(dt);
+        if (renderer) {
+            renderer->flush(config.width, config.height);
+            renderer->endFrame();
+            const yuki::RenderStats& stats = renderer->getStats();
+            totals.frames++;
+            for (uint32_t count : stats.commands) totals.commands += count;
+            totals.batches += stats.batches;
+            totals.breaks += stats.textureBreaks + stats.modeBreaks;
+            totals.binds += stats.textureBinds;
+            totals.vertices += stats.vertices;
+            totals.maxBatches = std::max(totals.maxBatches, stats.batches);
+        }
+        yuki::frameArena().reset();
+        frames.endFrame();
+        allocs.endFrame();
         if (interpreter.hasRuntimeErrors()) return 1;
     }
-    return 0;
+    if (options.allocs) {
+        allocs.setRecordSites(false);
+        for (const auto& line : allocs.report(kAllocSiteLines)) yuki::logInfo(line);
+    }
+    return renderer ? checkRenderTotals(totals, nullBackend, options) : 0;
 }
 } // namespace
 
@@ -129,14 +205,47 @@ int main(int argc, char** argv) {
         return headlessRun(argv[2], true);
     }
     if (argc > 1 && std::string(argv[1]) == "--simulate") {
-        if (argc < 4) {
-            yuki::logError("Usage: yuki2d --simulate <script.ys> <steps> [dt]");
+        double stepsArg = 0.0;
+        if (argc < 4 || !parseNumberArg(argv[3], stepsArg)) {
+            yuki::logError(kSimulateUsage);
             return 2;
         }
-        int steps = std::stoi(argv[3]);
+        int steps = (int)stepsArg;
         double dt = 1.0 / 60.0;
-        if (argc >= 5) dt = std::stod(argv[4]);
-        return headlessSimulate(argv[2], steps, dt);
+        std::string profilePath;
+        std::string tracePath;
+        SimulateOptions options;
+        int a = 4;
+        // dt is positional: only right after <steps>.
+        if (a < argc && parseNumberArg(argv[a], dt)) ++a;
+        for (; a < argc; ++a) {
+            std::string arg = argv[a];
+            bool hasValue = a + 1 < argc;
+            double number = 0.0;
+            if (arg == "--profile" && hasValue) profilePath = argv[++a];
+            else if (arg == "--trace" && hasValue) tracePath = argv[++a];
+            else if (arg == "--render") options.render = true;
+            else if (arg == "--allocs") options.allocs = true;
+            else if (arg == "--max-batches" && hasValue && parseNumberArg(argv[a + 1], number)) {
+                options.render = true;
+                options.maxBatches = (int)number;
+                ++a;
+            } else {
+                yuki::logError(kSimulateUsage);
+                return 2;
+            }
+        }
+        if (!profilePath.empty()) yuki::scriptProfiler().start();
+        int rc = headlessSimulate(argv[2], steps, dt, options);
+        if (!profilePath.empty()) writeProfile(profilePath);
+        if (!tracePath.empty()) {
+            if (yuki::frameProfiler().writeChromeTrace(tracePath)) yuki::logInfo("Frame trace written to " + tracePath);
+            else yuki::logError("Could not write frame trace: " + tracePath);
+        }
+        return rc;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        return yuki::benchMain(argc, argv, 2);
     }
     if (argc > 1 && std::string(argv[1]) == "--watch") {
         watch = true;
@@ -0,0 +1,240 @@
+#include "bench.hpp"
+#include "../core/log.hpp"
+#include "../core/version.hpp"
+#include "../core/engine_bindings.hpp"
+#include "../core/renderer2d.hpp"
+#include "../core/render_backend.hpp"
+#include "../core/config.hpp"
+#include "../script/ast_cache.hpp"
+#include "../script/ast.hpp"
+#include "../script/interpreter.hpp"
+#include "../script/frame_arena.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace yuki {
+namespace {
+struct BenchResult {
+    std::string name;
+    std::string script;
+    std::string error; // empty on success
+    int steps = 0;
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+};
+
+// Nearest-rank percentile of sorted samples.
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+std::string firstError(Interpreter& interpreter) {
+    const auto& errors = interpreter.getRuntimeErrors();
+    return errors.empty() ? std::string("runtime error") : errors.front();
+}
+
+BenchResult runScenario(const std::filesystem::path& script, const BenchOptions& options) {
+    BenchResult result;
+    result.name = script.stem().string();
+    result.script = script.generic_string();
+
+    ScriptModule module;
+    std::vector<std::string> errors;
+    if (!parseScriptFile(script.string(), module, errors)) {
+        result.error = errors.empty() ? std::string("parse failed") : errors.front();
+        return result;
+    }
+    // Same seed for every run so random() driven scenarios repeat exactly.
+    std::srand(1);
+    Renderer2D renderer(std::make_unique<NullRenderBackend>());
+    renderer.setDebugEnabled(false);
+    EngineConfig config;
+    Interpreter interpreter;
+    EngineBindings::init(nullptr, &renderer, &interpreter);
+    // Drop the scenario's engine state while its interpreter is still alive.
+    struct ResetBindings {
+        ~ResetBindings() { EngineBindings::init(nullptr, nullptr, nullptr); }
+    } resetBindings;
+    EngineBindings::setAssetBase(std::filesystem::absolute(script.parent_path()).lexically_normal().string());
+    interpreter.exec(module.statements);
+    interpreter.retainModule(std::move(module));
+    if (interpreter.hasRuntimeErrors()) {
+        result.error = firstError(interpreter);
+        return result;
+    }
+    auto initVal = interpreter.env->get("init");
+    auto updateVal = interpreter.env->get("update");
+    Value updateFn = updateVal.has_value() ? updateVal.value() : Value::nilVal();
+    if (initVal.has_value() && initVal.value().isFunction()) {
+        std::vector<Value> noArgs;
+        interpreter.callFunction(initVal.value(), noArgs);
+        if (interpreter.hasRuntimeErrors()) {
+            result.error = firstError(interpreter);
+            return result;
+        }
+    }
+    if (!updateFn.isFunction()) {
+        result.error = "no update(dt) function";
+        return result;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> samples;
+    samples.reserve((size_t)std::max(options.steps, 0));
+    std::vector<Value> args;
+    for (int i = 0; i < options.warmup + options.steps; ++i) {
+        auto start = Clock::now();
+        args.clear();
+        args.push_back(Value::number(options.dt));
+        interpreter.callFunction(updateFn, args);
+        EngineBindings::update(options.dt);
+        renderer.flush(config.width, config.height);
+        renderer.endFrame();
+        frameArena().reset();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (interpreter.hasRuntimeErrors()) {
+            result.error = firstError(interpreter);
+            return result;
+        }
+        if (i >= options.warmup) samples.push_back(ms);
+    }
+
+    result.steps = (int)samples.size();
+    if (!samples.empty()) {
+        double total = 0.0;
+        for (double ms : samples) total += ms;
+        std::sort(samples.begin(), samples.end());
+        result.meanMs = total / (double)samples.size();
+        result.p50Ms = percentile(samples, 50.0);
+        result.p99Ms = percentile(samples, 99.0);
+        result.minMs = samples.front();
+        result.maxMs = samples.back();
+    }
+    return result;
+}
+
+std::string jsonString(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+std::string toJson(const std::vector<BenchResult>& results, const BenchOptions& options) {
+    std::ostringstream out;
+    char num[64];
+    auto fmt = [&](double v) {
+        std::snprintf(num, sizeof(num), "%.4f", v);
+        return std::string(num);
+    };
+    out << "{\n";
+    out << "  \"engine\": " << jsonString(kEngineVersion) << ",\n";
+    out << "  \"steps\": " << options.steps << ",\n";
+    out << "  \"warmup\": " << options.warmup << ",\n";
+    std::snprintf(num, sizeof(num), "%.6f", options.dt);
+    out << "  \"dt\": " << num << ",\n";
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": " << jsonString(r.name) << ", \"script\": " << jsonString(r.script);
+        if (!r.error.empty()) {
+            out << ", \"error\": " << jsonString(r.error) << "}";
+            continue;
+        }
+        out << ", \"steps\": " << r.steps << ", \"mean_ms\": " << fmt(r.meanMs) << ", \"p50_ms\": " << fmt(r.p50Ms)
+            << ", \"p99_ms\": " << fmt(r.p99Ms) << ", \"min_ms\": " << fmt(r.minMs) << ", \"max_ms\": " << fmt(r.maxMs) << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+} // namespace
+
+int runBenchmarks(const BenchOptions& options) {
+    std::error_code ec;
+    std::vector<std::filesystem::path> scripts;
+    for (const auto& entry : std::filesystem::directory_iterator(options.dir, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".ys") continue;
+        if (!options.filter.empty() && entry.path().stem().string().find(options.filter) == std::string::npos) continue;
+        scripts.push_back(entry.path());
+    }
+    if (ec) {
+        logError("Cannot read bench directory " + options.dir + ": " + ec.message());
+        return 2;
+    }
+    if (scripts.empty()) {
+        logError("No benchmark scripts matched in " + options.dir);
+        return 2;
+    }
+    std::sort(scripts.begin(), scripts.end());
+
+    std::vector<BenchResult> results;
+    int rc = 0;
+    for (const auto& script : scripts) {
+        results.push_back(runScenario(script, options));
+        if (!results.back().error.empty()) {
+            logError(results.back().name + ": " + results.back().error);
+            rc = 1;
+        }
+    }
+    std::string json = toJson(results, options);
+    if (options.outPath.empty()) {
+        std::cout << json;
+        return rc;
+    }
+    std::ofstream out(options.outPath, std::ios::trunc);
+    if (!(out << json)) {
+        logError("Could not write benchmark results: " + options.outPath);
+        return 1;
+    }
+    for (const auto& r : results) {
+        if (!r.error.empty()) continue;
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-20s mean %8.4f ms  p50 %8.4f ms  p99 %8.4f ms", r.name.c_str(), r.meanMs, r.p50Ms, r.p99Ms);
+        logInfo(line);
+    }
+    logInfo("Benchmark results written to " + options.outPath);
+    return rc;
+}
+
+int benchMain(int argc, char** argv, int first) {
+    BenchOptions options;
+    for (int a = first; a < argc; ++a) {
+        std::string arg = argv[a];
+        bool hasValue = a + 1 < argc;
+        if (arg == "--dir" && hasValue) options.dir = argv[++a];
+        else if (arg == "--filter" && hasValue) options.filter = argv[++a];
+        else if (arg == "--out" && hasValue) options.outPath = argv[++a];
+        else if (arg == "--steps" && hasValue) options.steps = std::max(1, std::atoi(argv[++a]));
+        else if (arg == "--warmup" && hasValue) options.warmup = std::max(0, std::atoi(argv[++a]));
+        else {
+            logError("Usage: --bench [--dir bench] [--filter name] [--steps 600] [--warmup 60] [--out results.json]");
+            return 2;
+        }
+    }
+    return runBenchmarks(options);
+}
+
+} // namespace yuki
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+namespace yuki {
+
+// Headless benchmark suite. Every `.ys` file in the bench directory is one
+// scenario: it is loaded into a fresh interpreter, init() runs, and after a
+// warmup each step (update(dt), the engine tick and batching the frame
+// through a NullRenderBackend) is timed on its own. Results are reported as
+// JSON with mean/p50/p99 per step for trend tracking.
+struct BenchOptions {
+    std::string dir = "bench";
+    std::string filter;  // substring of scenario names; empty runs all
+    std::string outPath; // JSON file; empty prints the JSON to stdout
+    int steps = 600;
+    int warmup = 60;
+    double dt = 1.0 / 60.0;
+};
+
+// Returns non-zero if a scenario fails to load or raises a runtime error.
+int runBenchmarks(const BenchOptions& options);
+
+// Parses `[--dir d] [--filter s] [--steps n] [--warmup n] [--out file.json]`
+// from argv[first..] and runs the suite; shared by `yuki2d --bench` and the
+// yuki2d_bench target.
+int benchMain(int argc, char** argv, int first);
+
+} // namespace yuki
@@ -5,9 +5,14 @@
 #include "../script/parser.hpp"
 #include "../script/ast.hpp"
 #include "../script/interpreter.hpp"
+#include "../script/script_profiler.hpp"
+#include "../script/frame_arena.hpp"
+#include "../core/frame_profiler.hpp"
+#include "../core/alloc_tracker.hpp"
 #include "../core/engine_bindings.hpp"
 #include <GLFW/glfw3.h>
 #include <algorithm>
+#include <cstdio>
 #include <memory>
 namespace yuki {
 namespace {
@@ -18,6 +23,8 @@ namespace {
         return s.substr(b, e - b + 1);
     }
     constexpr float kConsoleFontScale = 2.0f;
+    constexpr size_t kProfileReportLines = 10;
+    constexpr size_t kAllocSiteLines = 8;
 }
 DevConsole::DevConsole(Renderer2D* r, Interpreter* i) : active(false), renderer(r), interpreter(i), fontId(-1) {}
 void DevConsole::setInterpreter(Interpreter* i) {
@@ -52,10 +59,26 @@ void DevConsole::submit() {
         return;
     }
     if (src == "help") {
-        appendLine("Console: type Yuki code and enter. Commands: help, clear.");
+        appendLine("Console: type Yuki code and enter. Commands: help, clear, globals, profile, frames, stats, allocs.");
         appendLine("Tip: set globals like 'player_hp = 50;' then hit Enter.");
         return;
     }
+    if (src == "profile" || src.rfind("profile ", 0) == 0) {
+        profileCommand(trim(src.substr(7)));
+        return;
+    }
+    if (src == "stats") {
+        printRenderStats();
+        return;
+    }
+    if (src == "allocs" || src.rfind("allocs ", 0) == 0) {
+        allocsCommand(trim(src.substr(6)));
+        return;
+    }
+    if (src == "frames" || src.rfind("frames ", 0) == 0) {
+        framesCommand(trim(src.substr(6)));
+        return;
+    }
     if (src == "globals" || src == "ls") {
         listGlobals();
         history.push_back(src);
@@ -78,22 +101,21 @@ void DevConsole::submit() {
         return;
     }
     Parser parser(tokens);
-    std::vector<std::unique_ptr<Stmt>> statements = parser.parse();
+    ScriptModule script = parser.parse();
     if (parser.hadError()) {
         for (const auto& e : parser.getErrors()) appendLine(e);
         return;
     }
     interpreter->clearRuntimeErrors();
-    std::unique_ptr<ExpressionStmt> lastExpr;
-    if (!statements.empty() && statements.back()->getKind() == StmtKind::Expression) {
-        std::unique_ptr<Stmt> last = std::move(statements.back());
-        statements.pop_back();
-        lastExpr.reset(static_cast<ExpressionStmt*>(last.release()));
-    }
-    interpreter->exec(statements);
-    if (!statements.empty()) {
-        interpreter->retainModule(std::move(statements));
+    const ExpressionStmt* lastExpr = nullptr;
+    if (!script.statements.empty() && script.statements.back()->getKind() == StmtKind::Expression) {
+        lastExpr = static_cast<const ExpressionStmt*>(script.statements.back());
+        script.statements.pop_back();
     }
+    interpreter->exec(script.statements);
+    // The arena moves with the module but its nodes stay put, so lastExpr
+    // remains valid.
+    interpreter->retainModule(std::move(script));
     if (interpreter->hasRuntimeErrors()) {
         for (const auto& e : interpreter->getRuntimeErrors()) appendLine(e);
         interpreter->clearRuntimeErrors();
@@ -101,12 +123,7 @@ void DevConsole::submit() {
     }
     appendLine("> " + src);
     if (lastExpr) {
-        Value v = interpreter->evalExpr(lastExpr->expression.get());
-        {
-            std::vector<std::unique_ptr<Stmt>> keep;
-            keep.push_back(std::unique_ptr<Stmt>(lastExpr.release()));
-            interpreter->retainModule(std::move(keep));
-        }
+        Value v = interpreter->evalExpr(lastExpr->expression);
         if (v.type != ValueType::Nil) appendLine(v.toString());
         if (interpreter->hasRuntimeErrors()) {
             for (const auto& e : interpreter->getRuntimeErrors()) appendLine(e);
@@ -137,6 +154,84 @@ void DevConsole::backspace() {
         cursorPos--;
     }
 }
+void DevConsole::profileCommand(const std::string& args) {
+    ScriptProfiler& profiler = scriptProfiler();
+    if (args == "start") {
+        profiler.start();
+        appendLine("script profiler started");
+    } else if (args == "stop") {
+        profiler.stop();
+        for (const auto& line : profiler.report(kProfileReportLines)) appendLine(line);
+    } else if (args == "report") {
+        for (const auto& line : profiler.report(kProfileReportLines)) appendLine(line);
+    } else if (args == "save" || args.rfind("save ", 0) == 0) {
+        std::string path = args.size() > 5 ? trim(args.substr(5)) : std::string("script_profile.folded");
+        appendLine(profiler.writeCollapsed(path) ? "wrote " + path : "could not write " + path);
+    } else {
+        appendLine("profile start | stop | report | save [file.folded]");
+    }
+}
+void DevConsole::framesCommand(const std::string& args) {
+    FrameProfiler& profiler = frameProfiler();
+    if (args.empty()) {
+        char buf[160];
+        std::snprintf(buf, sizeof(buf), "%zu frames: avg %.2f ms, max %.2f ms (F3 for the graph)",
+                      profiler.frameCount(), profiler.averageFrameMs(), profiler.maxFrameMs());
+        appendLine(buf);
+        for (const auto& zone : profiler.zoneStats()) {
+            std::snprintf(buf, sizeof(buf), "%*s%-*s avg %7.3f  max %7.3f", (int)zone.depth * 2, "",
+                          24 - (int)zone.depth * 2, zone.name, zone.avgMs, zone.maxMs);
+            appendLine(buf);
+        }
+    } else if (args == "save" || args.rfind("save ", 0) == 0) {
+        std::string path = args.size() > 5 ? trim(args.substr(5)) : std::string("frame_trace.json");
+        appendLine(profiler.writeChromeTrace(path) ? "wrote " + path : "could not write " + path);
+    } else {
+        appendLine("frames | frames save [file.json]");
+    }
+}
+void DevConsole::printRenderStats() {
+    if (!renderer) return;
+    const RenderStats& rs = renderer->getStats();
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "commands: %u rect, %u sprite, %u frame, %u text, %u particle (%u quads), %u debug",
+                  rs.commands[(int)RenderCmdType::Rect], rs.commands[(int)RenderCmdType::Sprite],
+                  rs.commands[(int)RenderCmdType::SpriteFrame], rs.commands[(int)RenderCmdType::Text],
+                  rs.commands[(int)RenderCmdType::Particles], rs.particleQuads, rs.debugCommands);
+    appendLine(buf);
+    std::snprintf(buf, sizeof(buf), "%u batches in %u flushes, %u vertices, %u texture binds",
+                  rs.batches, rs.flushes, rs.vertices, rs.textureBinds);
+    appendLine(buf);
+    std::snprintf(buf, sizeof(buf), "batch breaks: %u texture, %u mode", rs.textureBreaks, rs.modeBreaks);
+    appendLine(buf);
+    std::snprintf(buf, sizeof(buf), "uploaded: %.1f KB vertices, %.1f KB textures",
+                  (double)rs.vertexBytes / 1024.0, (double)rs.textureBytes / 1024.0);
+    appendLine(buf);
+    if (rs.gpuMs >= 0.0) std::snprintf(buf, sizeof(buf), "gpu: %.3f ms (%u frames ago)", rs.gpuMs, rs.gpuLatency);
+    else std::snprintf(buf, sizeof(buf), "gpu: %s", renderer->hasGpuTimer() ? "pending" : "no timer queries");
+    appendLine(buf);
+}
+void DevConsole::allocsCommand(const std::string& args) {
+    AllocTracker& tracker = allocTracker();
+    if (args.empty()) {
+        for (const auto& line : tracker.report(tracker.isRecordingSites() ? kAllocSiteLines : 0)) appendLine(line);
+        const FrameArena::Stats& fa = frameArena().lastFrame();
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "frame arena: %zu maps, %zu arrays, %zu escaped", fa.maps, fa.arrays, fa.escaped);
+        appendLine(buf);
+    } else if (args == "sites" || args == "sites on") {
+        tracker.setRecordSites(true);
+        appendLine("recording allocation sites");
+    } else if (args == "sites off") {
+        tracker.setRecordSites(false);
+        for (const auto& line : tracker.report(kAllocSiteLines)) appendLine(line);
+    } else if (args == "reset") {
+        tracker.reset();
+        appendLine("allocation counters reset");
+    } else {
+        appendLine("allocs | allocs sites [on|off] | allocs reset");
+    }
+}
 void DevConsole::listGlobals() {
     if (!interpreter || !interpreter->env) return;
     appendLine("Globals:");
@@ -23,6 +23,10 @@ private:
     void historyPrev();
     void historyNext();
     void listGlobals();
+    void profileCommand(const std::string& args);
+    void framesCommand(const std::string& args);
+    void printRenderStats();
+    void allocsCommand(const std::string& args);
     void scroll(int delta);
     bool active;
     std::string input;
@@ -0,0 +1,63 @@
+#include "frame_scheduler.hpp"
+#include "../script/interpreter.hpp"
+#include <algorithm>
+#include <cmath>
+namespace yuki {
+double FrameScheduler::clampFrameDt(double dt) {
+    if (dt < 0.0) return 0.0;
+    return std::min(dt, kMaxFrameDt);
+}
+bool FrameScheduler::parsePhase(const std::string& name, SchedulePhase& out) {
+    if (name == "startup") out = SchedulePhase::Startup;
+    else if (name == "update") out = SchedulePhase::Update;
+    else if (name == "fixed") out = SchedulePhase::Fixed;
+    else if (name == "late") out = SchedulePhase::Late;
+    else if (name == "draw") out = SchedulePhase::Draw;
+    else return false;
+    return true;
+}
+void FrameScheduler::setFixedDt(double dt) {
+    if (dt > 0.0) fixedDt = dt;
+}
+void FrameScheduler::add(SchedulePhase phase, const Value& fn) {
+    if (!fn.isFunction()) return;
+    phases[(int)phase].push_back(fn);
+}
+void FrameScheduler::clear() {
+    for (auto& list : phases) list.clear();
+    accumulator = 0.0;
+    interpAlpha = 0.0;
+    started = false;
+}
+bool FrameScheduler::runPhase(Interpreter& interpreter, SchedulePhase phase, double dt, const Value& ctx) {
+    const auto& list = phases[(int)phase];
+    for (size_t i = 0; i < list.size(); ++i) {
+        callArgs.clear();
+        callArgs.push_back(Value::number(dt));
+        callArgs.push_back(ctx);
+        interpreter.callFunction(list[i], callArgs);
+        if (interpreter.hasRuntimeErrors()) return false;
+    }
+    return true;
+}
+void FrameScheduler::tick(Interpreter& interpreter, double dt, const Value& ctx) {
+    dt = clampFrameDt(dt);
+    if (!started) {
+        started = true;
+        if (!runPhase(interpreter, SchedulePhase::Startup, 0.0, ctx)) return;
+    }
+    if (!runPhase(interpreter, SchedulePhase::Update, dt, ctx)) return;
+    accumulator += dt;
+    int steps = 0;
+    while (accumulator >= fixedDt && steps < maxFixedSteps) {
+        accumulator -= fixedDt;
+        ++steps;
+        if (!runPhase(interpreter, SchedulePhase::Fixed, fixedDt, ctx)) return;
+    }
+    if (accumulator >= fixedDt) accumulator = std::fmod(accumulator, fixedDt);
+    fixedStepsLastTick = steps;
+    interpAlpha = accumulator / fixedDt;
+    if (!runPhase(interpreter, SchedulePhase::Late, dt, ctx)) return;
+    runPhase(interpreter, SchedulePhase::Draw, dt, ctx);
+}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "../script/value.hpp"
+
+namespace yuki {
+class Interpreter;
+
+enum class SchedulePhase { Startup, Update, Fixed, Late, Draw, Count };
+
+// Runs script callbacks in a fixed phase order each frame:
+// startup (once), update(dt), fixed(fixed_dt) x N, late(dt), draw(dt).
+// Fixed steps are capped per frame and the leftover time is dropped so a slow
+// frame cannot snowball; alpha() is the remaining fraction of a step for
+// render interpolation.
+class FrameScheduler {
+public:
+    static constexpr double kMaxFrameDt = 0.25;
+    static double clampFrameDt(double dt);
+    static bool parsePhase(const std::string& name, SchedulePhase& out);
+
+    void setFixedDt(double dt);
+    double getFixedDt() const { return fixedDt; }
+    void setMaxFixedSteps(int steps) { maxFixedSteps = steps > 0 ? steps : 1; }
+    int getMaxFixedSteps() const { return maxFixedSteps; }
+    void add(SchedulePhase phase, const Value& fn);
+    void clear();
+    void tick(Interpreter& interpreter, double dt, const Value& ctx);
+    double alpha() const { return interpAlpha; }
+    int lastFixedSteps() const { return fixedStepsLastTick; }
+
+private:
+    bool runPhase(Interpreter& interpreter, SchedulePhase phase, double dt, const Value& ctx);
+
+    std::vector<Value> phases[(int)SchedulePhase::Count];
+    std::vector<Value> callArgs;
+    double fixedDt = 1.0 / 60.0;
+    int maxFixedSteps = 6;
+    double accumulator = 0.0;
+    double interpAlpha = 0.0;
+    int fixedStepsLastTick = 0;
+    bool started = false;
+};
+}
@@ -1,8 +1,10 @@
 #include "imgui_layer.hpp"
 #include "../core/window.hpp"
+#include "../core/frame_profiler.hpp"
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl2.h>
+#include <algorithm>
 
 namespace yuki {
 ImGuiLayer::ImGuiLayer() {}
@@ -104,6 +106,65 @@ void ImGuiLayer::render() {
     ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
 }
 
+void ImGuiLayer::drawFrameProfiler() {
+    if (!isEnabled() || !profilerVisible) return;
+    FrameProfiler& profiler = frameProfiler();
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(420.0f, 360.0f), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Frame profiler", &profilerVisible)) {
+        ImGui::End();
+        return;
+    }
+    size_t count = profiler.frameCount();
+    float history[FrameProfiler::kFrameCount];
+    float peak = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        // Oldest first so the graph scrolls left.
+        history[i] = (float)((double)profiler.frame(count - 1 - i).durationNs / 1e6);
+        peak = std::max(peak, history[i]);
+    }
+    double lastMs = count ? (double)profiler.frame(0).durationNs / 1e6 : 0.0;
+    ImGui::Text("frame %.2f ms  avg %.2f ms  max %.2f ms", lastMs, profiler.averageFrameMs(), profiler.maxFrameMs());
+    // Scale to at least a 30 fps frame so a steady 60 fps sits mid-graph.
+    ImGui::PlotLines("##frames", history, (int)count, 0, nullptr, 0.0f, std::max(peak, 33.3f),
+                     ImVec2(ImGui::GetContentRegionAvail().x, 80.0f));
+
+    bool paused = !profiler.isEnabled();
+    if (ImGui::Checkbox("Pause", &paused)) profiler.setEnabled(!paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export trace")) {
+        const char* path = "frame_trace.json";
+        profilerStatus = profiler.writeChromeTrace(path) ? std::string("wrote ") + path
+                                                         : std::string("could not write ") + path;
+    }
+    if (!profilerStatus.empty()) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("%s", profilerStatus.c_str());
+    }
+
+    if (ImGui::BeginTable("zones", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("zone", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("last ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("avg ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("max ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableHeadersRow();
+        for (const auto& zone : profiler.zoneStats()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%*s%s", (int)zone.depth * 2, "", zone.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", zone.lastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", zone.avgMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", zone.maxMs);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
 bool ImGuiLayer::isEnabled() const {
     return ImGui::GetCurrentContext() != nullptr;
 }
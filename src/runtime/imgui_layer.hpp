@@ -1,4 +1,5 @@
 #pragma once
+#include <string>
 namespace yuki {
 class Window;
 class ImGuiLayer {
@@ -10,5 +11,12 @@ public:
     void newFrame();
     void render();
     bool isEnabled() const;
+    // Frame profiler overlay: frame-time graph and per-zone breakdown of the
+    // frames recorded by frameProfiler(). Drawn between newFrame and render.
+    void toggleFrameProfiler() { profilerVisible = !profilerVisible; }
+    void drawFrameProfiler();
+private:
+    bool profilerVisible = false;
+    std::string profilerStatus;
 };
 }
@@ -1,16 +1,19 @@
 #include "yuki_runner.hpp"
-#include "../script/yuki_script_loader.hpp"
 #include "../core/log.hpp"
 #include "../core/time.hpp"
 #include "../core/input.hpp"
 #include "../core/engine_bindings.hpp"
 #include "../core/renderer2d.hpp"
-#include "../script/token.hpp"
-#include "../script/parser.hpp"
+#include "../script/ast_cache.hpp"
 #include "../script/ast.hpp"
 #include "../script/interpreter.hpp"
+#include "../script/frame_arena.hpp"
 #include "dev_console.hpp"
 #include "imgui_layer.hpp"
+#include "frame_scheduler.hpp"
+#include "../core/file_watcher.hpp"
+#include "../core/frame_profiler.hpp"
+#include "../core/alloc_tracker.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -18,6 +21,9 @@
 #include <GL/gl.h>
 #include <optional>
 #include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 namespace yuki {
 YukiRunner::YukiRunner(const std::string& scriptPath) : scriptPath(scriptPath) {}
 YukiRunner::YukiRunner(const std::string& scriptPath, bool watch) : scriptPath(scriptPath), watch(watch) {}
@@ -39,57 +45,25 @@ void YukiRunner::run(Window& window) {
     initInput(window);
     Value updateFn = Value::nilVal();
 
-    auto parseProgram = [&](std::vector<std::unique_ptr<Stmt>>& out, std::vector<std::string>& outErrs) -> bool {
-        ScriptLoader loader(scriptPathAbs.string());
-        std::string content = loader.load();
-        if (content.empty()) {
-            outErrs.push_back("Failed to load script: " + scriptPathAbs.string());
-            return false;
-        }
-        Tokenizer tokenizer(content);
-        std::vector<Token> tokens = tokenizer.scanTokens();
-        if (tokenizer.hadError()) {
-            for (const auto& e : tokenizer.getErrors()) outErrs.push_back(e);
-            return false;
-        }
-        Parser parser(tokens);
-        out = parser.parse();
-        if (parser.hadError()) {
-            for (const auto& e : parser.getErrors()) outErrs.push_back(e);
-            return false;
-        }
-        return true;
+    auto parseProgram = [&](ScriptModule& out, std::vector<std::string>& outErrs) -> bool {
+        return parseScriptFile(scriptPathAbs.string(), out, outErrs);
     };
 
-    std::unordered_map<std::string, std::filesystem::file_time_type> watchTimes;
-    auto refreshWatchTimes = [&]() {
-        std::vector<std::string> paths = EngineBindings::getLoadedModulePaths();
-        paths.push_back(scriptPathAbs.string());
-        for (const auto& p : paths) {
-            std::error_code ec;
-            auto t = std::filesystem::last_write_time(p, ec);
-            if (ec) continue;
-            if (watchTimes.find(p) == watchTimes.end()) watchTimes.emplace(p, t);
-        }
-    };
-    auto checkWatchChanged = [&]() -> bool {
-        refreshWatchTimes();
-        for (auto& kv : watchTimes) {
-            std::error_code ec;
-            auto t = std::filesystem::last_write_time(kv.first, ec);
-            if (ec) continue;
-            if (t > kv.second) {
-                kv.second = t;
-                return true;
-            }
-        }
-        return false;
+    // Scripts and assets share one watcher; modules and Aseprite files
+    // register themselves when loaded.
+    FileWatcher& watcher = fileWatcher();
+    std::string mainScript = FileWatcher::normalize(scriptPathAbs.string());
+    if (watch) watcher.watch(mainScript);
+    auto isScriptPath = [&](const std::string& path) -> bool {
+        if (path == mainScript) return true;
+        std::vector<std::string> modules = EngineBindings::getLoadedModulePaths();
+        return std::find(modules.begin(), modules.end(), path) != modules.end();
     };
 
     auto loadAndInit = [&](bool logSuccess) -> bool {
-        std::vector<std::unique_ptr<Stmt>> statements;
+        ScriptModule script;
         std::vector<std::string> errs;
-        if (!parseProgram(statements, errs)) {
+        if (!parseProgram(script, errs)) {
             for (const auto& e : errs) {
                 logError(e);
                 console.log(e);
@@ -103,8 +77,8 @@ void YukiRunner::run(Window& window) {
         console.setInterpreter(interpreter.get());
 
         updateFn = Value::nilVal();
-        interpreter->exec(statements);
-        interpreter->retainModule(std::move(statements));
+        interpreter->exec(script.statements);
+        interpreter->retainModule(std::move(script));
         if (interpreter->hasRuntimeErrors()) {
             for (const auto& e : interpreter->getRuntimeErrors()) {
                 logError(e);
@@ -113,6 +87,7 @@ void YukiRunner::run(Window& window) {
             updateFn = Value::nilVal();
             return false;
         }
+        interpreter->recordModuleFunctions(interpreter->globals);
 
         auto initVal = interpreter->env->get("init");
         auto updateVal = interpreter->env->get("update");
@@ -130,10 +105,6 @@ void YukiRunner::run(Window& window) {
             return false;
         }
 
-        if (watch) {
-            watchTimes.clear();
-            refreshWatchTimes();
-        }
         if (logSuccess) {
             console.log("reloaded");
             logInfo("reloaded");
@@ -141,33 +112,86 @@ void YukiRunner::run(Window& window) {
         return true;
     };
 
+    // Incremental reload of one changed script: the main script is merged into
+    // globals, modules into their own scope. Nothing is reset and init() is not
+    // called again; on any error the previous code keeps running.
+    auto reloadScript = [&](const std::string& path) {
+        if (!interpreter) return;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::string> errs;
+        bool ok = false;
+        if (path == mainScript) {
+            ScriptModule script;
+            if (parseProgram(script, errs)) {
+                ok = interpreter->reloadInto(std::move(script), interpreter->globals);
+                if (!ok) {
+                    errs = interpreter->getRuntimeErrors();
+                    interpreter->clearRuntimeErrors();
+                }
+            }
+            auto updateVal = interpreter->globals->get("update");
+            if (updateVal.has_value()) updateFn = updateVal.value();
+        } else {
+            ok = EngineBindings::reloadModule(path, errs);
+        }
+        std::string name = std::filesystem::path(path).filename().string();
+        if (!ok) {
+            for (const auto& e : errs) {
+                logError(e);
+                console.log(e);
+            }
+            console.log("reload failed: " + name);
+            return;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::string msg = "reloaded " + name + " (" + std::to_string((int)std::lround(ms)) + " ms)";
+        console.log(msg);
+        logInfo(msg);
+    };
+
     if (!loadAndInit(false)) return;
 
     Time time;
-    double watchAccum = 0.0;
+    std::vector<std::string> changedFiles;
+    FrameProfiler& profiler = frameProfiler();
+    AllocTracker& allocs = allocTracker();
+    FrameArena& arena = frameArena();
+    allocs.reset();
     while (!window.shouldClose()) {
-        window.pollEvents();
+        profiler.beginFrame();
+        {
+            ProfileZone zone("poll events");
+            window.pollEvents();
+        }
         time.update();
-        float dt = time.deltaTime();
-        updateInput(window);
-        console.updateInput();
-        imgui.newFrame();
+        float dt = (float)FrameScheduler::clampFrameDt(time.deltaTime());
+        {
+            ProfileZone zone("input");
+            updateInput(window);
+            console.updateInput();
+            imgui.newFrame();
+            if (isKeyPressed(GLFW_KEY_F3)) imgui.toggleFrameProfiler();
+        }
 
-        bool wantReload = false;
-        if (watch) {
-            watchAccum += dt;
-            if (watchAccum >= 0.25) {
-                watchAccum = 0.0;
-                if (checkWatchChanged()) wantReload = true;
+        {
+            ProfileZone zone("file changes");
+            AllocScope tag(AllocTag::Script);
+            changedFiles.clear();
+            watcher.drain(changedFiles);
+            if (watch) {
+                for (const auto& path : changedFiles) {
+                    if (isScriptPath(path)) reloadScript(path);
+                }
+                // F5 is the full restart: fresh interpreter, init() runs again.
+                if (isKeyPressed(GLFW_KEY_F5)) loadAndInit(true);
             }
-            if (isKeyPressed(GLFW_KEY_F5)) wantReload = true;
-        }
-        if (wantReload) {
-            loadAndInit(true);
+            EngineBindings::handleFileChanges(changedFiles);
         }
 
         window.clear();
         if (updateFn.isFunction() && interpreter) {
+            ProfileZone zone("script update");
+            AllocScope tag(AllocTag::Script);
             std::vector<Value> args;
             args.push_back(Value::number(dt));
             interpreter->callFunction(updateFn, args);
@@ -182,12 +206,27 @@ void YukiRunner::run(Window& window) {
 
         renderer.flush(fbW, fbH);
         glViewport(0, 0, fbW, fbH);
-        imgui.render();
+        {
+            ProfileZone zone("imgui render");
+            AllocScope tag(AllocTag::Ui);
+            imgui.drawFrameProfiler();
+            imgui.render();
+        }
         if (console.isActive()) {
+            ProfileZone zone("console");
+            AllocScope tag(AllocTag::Ui);
             console.drawOverlay(renderer.getVirtualWidth(), renderer.getVirtualHeight());
             renderer.flush(fbW, fbH, false);
         }
-        window.swapBuffers();
+        {
+            ProfileZone zone("swap");
+            window.swapBuffers();
+        }
+        renderer.endFrame();
+        // Temporary frame_* values from this iteration are dead by now.
+        arena.reset();
+        profiler.endFrame();
+        allocs.endFrame();
     }
 }
 }
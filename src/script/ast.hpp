@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <memory>
+#include "ast_arena.hpp"
 
 namespace yuki {
 
@@ -30,6 +32,7 @@ struct IndexExpr;
 struct GetExpr;
 struct SetIndexExpr;
 struct SetExpr;
+struct ConcatExpr;
 
 enum class ExprKind {
     Literal,
@@ -42,7 +45,8 @@ enum class ExprKind {
     Index,
     Get,
     SetIndex,
-    Set
+    Set,
+    Concat
 };
 
 enum class StmtKind {
@@ -58,178 +62,196 @@ enum class StmtKind {
     DoWhile
 };
 
+// Nodes are allocated in the module's AstArena and link to each other with
+// plain pointers; names point into the interned name table. Nothing here owns
+// memory, so a whole tree is released by dropping its arena.
+using ExprList = NodeList<Expr>;
+using StmtList = NodeList<Stmt>;
+using ParamList = NodeList<const std::string>;
+
 // Base Expression
 struct Expr {
-    virtual ~Expr() = default;
-    virtual ExprKind getKind() const = 0;
+    ExprKind kind;
+    ExprKind getKind() const { return kind; }
+protected:
+    explicit Expr(ExprKind kind) : kind(kind) {}
 };
 
 // Base Statement
 struct Stmt {
-    virtual ~Stmt() = default;
-    virtual StmtKind getKind() const = 0;
+    StmtKind kind;
+    StmtKind getKind() const { return kind; }
+protected:
+    explicit Stmt(StmtKind kind) : kind(kind) {}
 };
 
 // Expressions
 
+// Literals are classified once at parse time with the rules the interpreter
+// used to apply on every evaluation (numeric text, true/false/nil, else string).
+enum class LiteralType : uint8_t { Nil, True, False, Number, String };
+
 struct Literal : Expr {
-    std::string value;
-    Literal(const std::string& value) : value(value) {}
-    ExprKind getKind() const override { return ExprKind::Literal; }
+    LiteralType type;
+    double number;
+    std::string_view value; // spelling; string literals already unescaped
+    Literal(LiteralType type, double number, std::string_view value)
+        : Expr(ExprKind::Literal), type(type), number(number), value(value) {}
 };
 
 struct VarExpr : Expr {
-    std::string name;
-    VarExpr(const std::string& name) : name(name) {}
-    ExprKind getKind() const override { return ExprKind::VarExpr; }
+    const std::string& name;
+    VarExpr(const std::string& name) : Expr(ExprKind::VarExpr), name(name) {}
 };
 
 struct AssignExpr : Expr {
-    std::string name;
-    std::unique_ptr<Expr> value;
-    AssignExpr(const std::string& name, std::unique_ptr<Expr> value)
-        : name(name), value(std::move(value)) {}
-    ExprKind getKind() const override { return ExprKind::AssignExpr; }
+    const std::string& name;
+    Expr* value;
+    AssignExpr(const std::string& name, Expr* value)
+        : Expr(ExprKind::AssignExpr), name(name), value(value) {}
 };
 
 struct Binary : Expr {
-    std::unique_ptr<Expr> left;
-    struct Op { int type; std::string lexeme; } op; 
-    std::unique_ptr<Expr> right;
-    
-    Binary(std::unique_ptr<Expr> left, int opType, std::string opLexeme, std::unique_ptr<Expr> right)
-        : left(std::move(left)), op{opType, opLexeme}, right(std::move(right)) {}
-    ExprKind getKind() const override { return ExprKind::Binary; }
+    Expr* left;
+    struct Op { int type; const std::string& lexeme; } op;
+    Expr* right;
+
+    Binary(Expr* left, int opType, const std::string& opLexeme, Expr* right)
+        : Expr(ExprKind::Binary), left(left), op{opType, opLexeme}, right(right) {}
 };
 
 struct Call : Expr {
-    std::unique_ptr<Expr> callee;
-    std::vector<std::unique_ptr<Expr>> arguments;
-    Call(std::unique_ptr<Expr> callee, std::vector<std::unique_ptr<Expr>> arguments)
-        : callee(std::move(callee)), arguments(std::move(arguments)) {}
-    ExprKind getKind() const override { return ExprKind::Call; }
+    Expr* callee;
+    ExprList arguments;
+    Call(Expr* callee, ExprList arguments)
+        : Expr(ExprKind::Call), callee(callee), arguments(arguments) {}
 };
 
 struct FunctionExpr : Expr {
-    std::vector<std::string> parameters;
-    std::unique_ptr<Block> body;
-    FunctionExpr(std::vector<std::string> parameters, std::unique_ptr<Block> body)
-        : parameters(std::move(parameters)), body(std::move(body)) {}
-    ExprKind getKind() const override { return ExprKind::Function; }
+    ParamList parameters;
+    Block* body;
+    FunctionExpr(ParamList parameters, Block* body)
+        : Expr(ExprKind::Function), parameters(parameters), body(body) {}
 };
 
 struct IndexExpr : Expr {
-    std::unique_ptr<Expr> object;
-    std::unique_ptr<Expr> index;
-    IndexExpr(std::unique_ptr<Expr> object, std::unique_ptr<Expr> index)
-        : object(std::move(object)), index(std::move(index)) {}
-    ExprKind getKind() const override { return ExprKind::Index; }
+    Expr* object;
+    Expr* index;
+    IndexExpr(Expr* object, Expr* index)
+        : Expr(ExprKind::Index), object(object), index(index) {}
 };
 
 struct GetExpr : Expr {
-    std::unique_ptr<Expr> object;
-    std::string name;
-    GetExpr(std::unique_ptr<Expr> object, std::string name)
-        : object(std::move(object)), name(std::move(name)) {}
-    ExprKind getKind() const override { return ExprKind::Get; }
+    Expr* object;
+    const std::string& name;
+    GetExpr(Expr* object, const std::string& name)
+        : Expr(ExprKind::Get), object(object), name(name) {}
 };
 
 struct SetIndexExpr : Expr {
-    std::unique_ptr<Expr> object;
-    std::unique_ptr<Expr> index;
-    std::unique_ptr<Expr> value;
-    SetIndexExpr(std::unique_ptr<Expr> object, std::unique_ptr<Expr> index, std::unique_ptr<Expr> value)
-        : object(std::move(object)), index(std::move(index)), value(std::move(value)) {}
-    ExprKind getKind() const override { return ExprKind::SetIndex; }
+    Expr* object;
+    Expr* index;
+    Expr* value;
+    SetIndexExpr(Expr* object, Expr* index, Expr* value)
+        : Expr(ExprKind::SetIndex), object(object), index(index), value(value) {}
 };
 
 struct SetExpr : Expr {
-    std::unique_ptr<Expr> object;
-    std::string name;
-    std::unique_ptr<Expr> value;
-    SetExpr(std::unique_ptr<Expr> object, std::string name, std::unique_ptr<Expr> value)
-        : object(std::move(object)), name(std::move(name)), value(std::move(value)) {}
-    ExprKind getKind() const override { return ExprKind::Set; }
+    Expr* object;
+    const std::string& name;
+    Expr* value;
+    SetExpr(Expr* object, const std::string& name, Expr* value)
+        : Expr(ExprKind::Set), object(object), name(name), value(value) {}
+};
+
+// A `+` chain the parser proved to be string concatenation: once a string
+// literal joins a left-associative chain, every later `+` appends text.
+// parts[0] may be any expression (a numeric `1 + 2` prefix stays a Binary);
+// the result is the text of all parts, built in one allocation.
+struct ConcatExpr : Expr {
+    ExprList parts;
+    explicit ConcatExpr(ExprList parts) : Expr(ExprKind::Concat), parts(parts) {}
 };
 
 struct Unary : Expr {
-    struct Op { int type; std::string lexeme; } op;
-    std::unique_ptr<Expr> right;
-    Unary(int opType, std::string opLexeme, std::unique_ptr<Expr> right)
-        : op{opType, opLexeme}, right(std::move(right)) {}
-    ExprKind getKind() const override { return ExprKind::Unary; }
+    struct Op { int type; const std::string& lexeme; } op;
+    Expr* right;
+    Unary(int opType, const std::string& opLexeme, Expr* right)
+        : Expr(ExprKind::Unary), op{opType, opLexeme}, right(right) {}
 };
 
-// Statements (Unchanged logic, just ensure consistency)
+// Statements
 
 struct ExpressionStmt : Stmt {
-    std::unique_ptr<Expr> expression;
-    ExpressionStmt(std::unique_ptr<Expr> expression)
-        : expression(std::move(expression)) {}
-    StmtKind getKind() const override { return StmtKind::Expression; }
+    Expr* expression;
+    ExpressionStmt(Expr* expression)
+        : Stmt(StmtKind::Expression), expression(expression) {}
 };
 
 struct VarDecl : Stmt {
-    std::string name;
-    std::unique_ptr<Expr> initializer;
-    VarDecl(const std::string& name, std::unique_ptr<Expr> initializer)
-        : name(name), initializer(std::move(initializer)) {}
-    StmtKind getKind() const override { return StmtKind::VarDecl; }
+    const std::string& name;
+    Expr* initializer;
+    VarDecl(const std::string& name, Expr* initializer)
+        : Stmt(StmtKind::VarDecl), name(name), initializer(initializer) {}
 };
 
 struct Block : Stmt {
-    std::vector<std::unique_ptr<Stmt>> statements;
-    Block(std::vector<std::unique_ptr<Stmt>> statements)
-        : statements(std::move(statements)) {}
-    StmtKind getKind() const override { return StmtKind::Block; }
+    StmtList statements;
+    Block(StmtList statements)
+        : Stmt(StmtKind::Block), statements(statements) {}
 };
 
 struct FunctionDecl : Stmt {
-    std::string name;
-    std::vector<std::string> parameters;
-    std::unique_ptr<Block> body;
-    FunctionDecl(const std::string& name, std::vector<std::string> parameters, std::unique_ptr<Block> body)
-        : name(name), parameters(std::move(parameters)), body(std::move(body)) {}
-    StmtKind getKind() const override { return StmtKind::Function; }
+    const std::string& name;
+    ParamList parameters;
+    Block* body;
+    FunctionDecl(const std::string& name, ParamList parameters, Block* body)
+        : Stmt(StmtKind::Function), name(name), parameters(parameters), body(body) {}
 };
 
 struct ReturnStmt : Stmt {
-    std::unique_ptr<Expr> value;
-    ReturnStmt(std::unique_ptr<Expr> value) : value(std::move(value)) {}
-    StmtKind getKind() const override { return StmtKind::Return; }
+    Expr* value;
+    ReturnStmt(Expr* value) : Stmt(StmtKind::Return), value(value) {}
 };
 
 struct IfStmt : Stmt {
-    std::unique_ptr<Expr> condition;
-    std::unique_ptr<Stmt> thenBranch;
-    std::unique_ptr<Stmt> elseBranch;
-    IfStmt(std::unique_ptr<Expr> condition, std::unique_ptr<Stmt> thenBranch, std::unique_ptr<Stmt> elseBranch)
-        : condition(std::move(condition)), thenBranch(std::move(thenBranch)), elseBranch(std::move(elseBranch)) {}
-    StmtKind getKind() const override { return StmtKind::If; }
+    Expr* condition;
+    Stmt* thenBranch;
+    Stmt* elseBranch;
+    IfStmt(Expr* condition, Stmt* thenBranch, Stmt* elseBranch)
+        : Stmt(StmtKind::If), condition(condition), thenBranch(thenBranch), elseBranch(elseBranch) {}
 };
 
 struct WhileStmt : Stmt {
-    std::unique_ptr<Expr> condition;
-    std::unique_ptr<Stmt> body;
-    WhileStmt(std::unique_ptr<Expr> condition, std::unique_ptr<Stmt> body)
-        : condition(std::move(condition)), body(std::move(body)) {}
-    StmtKind getKind() const override { return StmtKind::While; }
+    Expr* condition;
+    Stmt* body;
+    WhileStmt(Expr* condition, Stmt* body)
+        : Stmt(StmtKind::While), condition(condition), body(body) {}
 };
 
 struct BreakStmt : Stmt {
-    StmtKind getKind() const override { return StmtKind::Break; }
+    BreakStmt() : Stmt(StmtKind::Break) {}
 };
 
 struct ContinueStmt : Stmt {
-    StmtKind getKind() const override { return StmtKind::Continue; }
+    ContinueStmt() : Stmt(StmtKind::Continue) {}
 };
 
 struct DoWhileStmt : Stmt {
-    std::unique_ptr<Stmt> body;
-    std::unique_ptr<Expr> condition;
-    DoWhileStmt(std::unique_ptr<Stmt> body, std::unique_ptr<Expr> condition)
-        : body(std::move(body)), condition(std::move(condition)) {}
-    StmtKind getKind() const override { return StmtKind::DoWhile; }
+    Stmt* body;
+    Expr* condition;
+    DoWhileStmt(Stmt* body, Expr* condition)
+        : Stmt(StmtKind::DoWhile), body(body), condition(condition) {}
+};
+
+// Builds a literal from its (unescaped) spelling, copying the text into the arena.
+Literal* makeLiteral(AstArena& arena, std::string_view value);
+
+// One parsed script: its top-level statements and the arena that owns every
+// node below them. Dropping the module frees the whole tree at once.
+struct ScriptModule {
+    AstArena arena;
+    std::vector<Stmt*> statements;
 };
 
 }
@@ -0,0 +1,62 @@
+#include "ast_arena.hpp"
+#include "ast.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace yuki {
+
+AstArena::AstArena(size_t firstBlockBytes)
+    : nextBlockBytes(std::clamp(firstBlockBytes, kMinBlockBytes, kMaxBlockBytes)) {}
+
+void* AstArena::allocate(size_t size, size_t align) {
+    size_t pad = (align - ((uintptr_t)cursor & (align - 1))) & (align - 1);
+    if (!cursor || pad + size > remaining) {
+        size_t bytes = std::max(nextBlockBytes, size + align);
+        blocks.push_back(std::unique_ptr<std::byte[]>(new std::byte[bytes])); // left uninitialized
+        cursor = blocks.back().get();
+        remaining = bytes;
+        nextBlockBytes = std::min(nextBlockBytes * 2, kMaxBlockBytes);
+        pad = (align - ((uintptr_t)cursor & (align - 1))) & (align - 1);
+    }
+    void* p = cursor + pad;
+    cursor += pad + size;
+    remaining -= pad + size;
+    used += size;
+    return p;
+}
+
+std::string_view AstArena::text(std::string_view s) {
+    char* dst = static_cast<char*>(allocate(s.size() + 1, 1));
+    if (!s.empty()) std::memcpy(dst, s.data(), s.size());
+    dst[s.size()] = '\0';
+    return std::string_view(dst, s.size());
+}
+
+const std::string& internName(std::string_view name) {
+    // Keys view the owned strings, so lookups never allocate.
+    static std::mutex mutex;
+    static std::unordered_map<std::string_view, std::unique_ptr<std::string>> names;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = names.find(name);
+    if (it != names.end()) return *it->second;
+    auto owned = std::make_unique<std::string>(name);
+    const std::string& ref = *owned;
+    names.emplace(std::string_view(ref), std::move(owned));
+    return ref;
+}
+
+Literal* makeLiteral(AstArena& arena, std::string_view value) {
+    std::string_view text = arena.text(value);
+    char* end = nullptr;
+    double d = std::strtod(text.data(), &end);
+    if (end != text.data() && *end == '\0') return arena.make<Literal>(LiteralType::Number, d, text);
+    if (text == "true") return arena.make<Literal>(LiteralType::True, 0.0, text);
+    if (text == "false") return arena.make<Literal>(LiteralType::False, 0.0, text);
+    if (text == "nil") return arena.make<Literal>(LiteralType::Nil, 0.0, text);
+    return arena.make<Literal>(LiteralType::String, 0.0, text);
+}
+
+} // namespace yuki
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace yuki {
+
+// Non-owning list of arena nodes (or interned names): a pointer array that
+// lives in the same arena as the nodes it points at.
+template <class T>
+struct NodeList {
+    T* const* items = nullptr;
+    uint32_t count = 0;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T* operator[](size_t i) const { return items[i]; }
+    T* const* begin() const { return items; }
+    T* const* end() const { return items + count; }
+};
+
+// Bump allocator owning one script's AST. Nodes must be trivially
+// destructible: nothing is destroyed individually, the blocks are freed
+// together when the arena goes away.
+class AstArena {
+public:
+    explicit AstArena(size_t firstBlockBytes = kMinBlockBytes);
+    AstArena(AstArena&&) noexcept = default;
+    AstArena& operator=(AstArena&&) noexcept = default;
+    AstArena(const AstArena&) = delete;
+    AstArena& operator=(const AstArena&) = delete;
+
+    template <class T, class... Args>
+    T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena nodes are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Uninitialized array of `n` pointers, for building a NodeList in place.
+    template <class T>
+    T** pointerArray(size_t n) {
+        return static_cast<T**>(allocate(sizeof(T*) * n, alignof(T*)));
+    }
+
+    // Copies `n` pointers into the arena.
+    template <class T>
+    NodeList<T> list(T* const* src, size_t n) {
+        NodeList<T> out;
+        if (n == 0) return out;
+        T** dst = pointerArray<T>(n);
+        for (size_t i = 0; i < n; ++i) dst[i] = src[i];
+        out.items = dst;
+        out.count = (uint32_t)n;
+        return out;
+    }
+
+    // Null-terminated copy of `s` owned by the arena.
+    std::string_view text(std::string_view s);
+
+    size_t bytesUsed() const { return used; }
+    size_t blockCount() const { return blocks.size(); }
+
+private:
+    static constexpr size_t kMinBlockBytes = 4096;
+    static constexpr size_t kMaxBlockBytes = 1 << 20;
+
+    void* allocate(size_t size, size_t align);
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte* cursor = nullptr;
+    size_t remaining = 0;
+    size_t nextBlockBytes = kMinBlockBytes;
+    size_t used = 0;
+};
+
+// Process-wide name table. Identifiers, property names and operator lexemes
+// are interned once; AST nodes refer to the returned string, which lives for
+// the rest of the program.
+const std::string& internName(std::string_view name);
+
+} // namespace yuki
@@ -0,0 +1,519 @@
+#include "ast_cache.hpp"
+#include "token.hpp"
+#include "parser.hpp"
+#include "../core/version.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace yuki {
+namespace {
+constexpr char kMagic[4] = {'Y', 'A', 'S', 'T'};
+constexpr uint32_t kFormatVersion = 4;
+constexpr uint8_t kNullNode = 0xFF;
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t format;
+    uint64_t engineHash;
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+};
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t h = 1469598103934665603ull) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint64_t engineHash() {
+    static const uint64_t hash = fnv1a(kEngineVersion, std::strlen(kEngineVersion));
+    return hash;
+}
+
+bool cacheEnabled() {
+    const char* env = std::getenv("YUKI_CACHE");
+    return !(env && std::string(env) == "0");
+}
+
+std::filesystem::path cachePathFor(const std::string& scriptPath) {
+    const char* dirEnv = std::getenv("YUKI_CACHE_DIR");
+    std::filesystem::path dir = dirEnv && *dirEnv ? std::filesystem::path(dirEnv) : std::filesystem::path(".yukicache");
+    std::error_code ec;
+    std::filesystem::path abs = std::filesystem::absolute(scriptPath, ec);
+    std::string key = (ec ? std::filesystem::path(scriptPath) : abs).lexically_normal().string();
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.yast", (unsigned long long)fnv1a(key.data(), key.size()));
+    return dir / name;
+}
+
+// Serialized as a pre-order walk: one kind byte per node (kNullNode for an
+// absent child), strings as u32 length + bytes, lists as u32 count + items.
+class Writer {
+public:
+    std::string out;
+
+    void u8(uint8_t v) { out.push_back((char)v); }
+    void u32(uint32_t v) { out.append((const char*)&v, sizeof(v)); }
+    void i32(int32_t v) { out.append((const char*)&v, sizeof(v)); }
+    void str(std::string_view s) {
+        u32((uint32_t)s.size());
+        out.append(s);
+    }
+    void params(ParamList v) {
+        u32((uint32_t)v.size());
+        for (const std::string* s : v) str(*s);
+    }
+    void stmts(StmtList v) {
+        u32((uint32_t)v.size());
+        for (const Stmt* s : v) stmt(s);
+    }
+    void stmts(const std::vector<Stmt*>& v) {
+        u32((uint32_t)v.size());
+        for (const Stmt* s : v) stmt(s);
+    }
+
+    void expr(const Expr* e) {
+        if (!e) {
+            u8(kNullNode);
+            return;
+        }
+        ExprKind kind = e->getKind();
+        u8((uint8_t)kind);
+        switch (kind) {
+        case ExprKind::Literal: str(static_cast<const Literal*>(e)->value); break;
+        case ExprKind::VarExpr: str(static_cast<const VarExpr*>(e)->name); break;
+        case ExprKind::AssignExpr: {
+            const auto* a = static_cast<const AssignExpr*>(e);
+            str(a->name);
+            expr(a->value);
+            break;
+        }
+        case ExprKind::Unary: {
+            const auto* u = static_cast<const Unary*>(e);
+            i32(u->op.type);
+            str(u->op.lexeme);
+            expr(u->right);
+            break;
+        }
+        case ExprKind::Binary: {
+            const auto* b = static_cast<const Binary*>(e);
+            expr(b->left);
+            i32(b->op.type);
+            str(b->op.lexeme);
+            expr(b->right);
+            break;
+        }
+        case ExprKind::Call: {
+            const auto* c = static_cast<const Call*>(e);
+            expr(c->callee);
+            u32((uint32_t)c->arguments.size());
+            for (const Expr* a : c->arguments) expr(a);
+            break;
+        }
+        case ExprKind::Function: {
+            const auto* f = static_cast<const FunctionExpr*>(e);
+            params(f->parameters);
+            stmt(f->body);
+            break;
+        }
+        case ExprKind::Index: {
+            const auto* i = static_cast<const IndexExpr*>(e);
+            expr(i->object);
+            expr(i->index);
+            break;
+        }
+        case ExprKind::Get: {
+            const auto* g = static_cast<const GetExpr*>(e);
+            expr(g->object);
+            str(g->name);
+            break;
+        }
+        case ExprKind::SetIndex: {
+            const auto* s = static_cast<const SetIndexExpr*>(e);
+            expr(s->object);
+            expr(s->index);
+            expr(s->value);
+            break;
+        }
+        case ExprKind::Set: {
+            const auto* s = static_cast<const SetExpr*>(e);
+            expr(s->object);
+            str(s->name);
+            expr(s->value);
+            break;
+        }
+        case ExprKind::Concat: {
+            const auto* c = static_cast<const ConcatExpr*>(e);
+            u32((uint32_t)c->parts.size());
+            for (const Expr* p : c->parts) expr(p);
+            break;
+        }
+        }
+    }
+
+    void stmt(const Stmt* s) {
+        if (!s) {
+            u8(kNullNode);
+            return;
+        }
+        StmtKind kind = s->getKind();
+        u8((uint8_t)kind);
+        switch (kind) {
+        case StmtKind::Expression: expr(static_cast<const ExpressionStmt*>(s)->expression); break;
+        case StmtKind::VarDecl: {
+            const auto* v = static_cast<const VarDecl*>(s);
+            str(v->name);
+            expr(v->initializer);
+            break;
+        }
+        case StmtKind::Block: stmts(static_cast<const Block*>(s)->statements); break;
+        case StmtKind::Function: {
+            const auto* f = static_cast<const FunctionDecl*>(s);
+            str(f->name);
+            params(f->parameters);
+            stmt(f->body);
+            break;
+        }
+        case StmtKind::Return: expr(static_cast<const ReturnStmt*>(s)->value); break;
+        case StmtKind::If: {
+            const auto* i = static_cast<const IfStmt*>(s);
+            expr(i->condition);
+            stmt(i->thenBranch);
+            stmt(i->elseBranch);
+            break;
+        }
+        case StmtKind::While: {
+            const auto* w = static_cast<const WhileStmt*>(s);
+            expr(w->condition);
+            stmt(w->body);
+            break;
+        }
+        case StmtKind::Break:
+        case StmtKind::Continue:
+            break;
+        case StmtKind::DoWhile: {
+            const auto* d = static_cast<const DoWhileStmt*>(s);
+            stmt(d->body);
+            expr(d->condition);
+            break;
+        }
+        }
+    }
+};
+
+// Rebuilds the tree straight into `arena`. Every read is bounds-checked; a
+// malformed entry sets `ok` to false and the caller falls back to parsing
+// the source (the half-built arena is simply dropped).
+class Reader {
+public:
+    Reader(const unsigned char* p, const unsigned char* end, AstArena& arena) : p(p), end(end), arena(arena) {}
+    bool ok = true;
+
+    bool atEnd() const { return p == end; }
+
+    uint8_t u8() {
+        if (!need(1)) return kNullNode;
+        return *p++;
+    }
+    uint32_t u32() {
+        uint32_t v = 0;
+        if (!need(sizeof(v))) return 0;
+        std::memcpy(&v, p, sizeof(v));
+        p += sizeof(v);
+        return v;
+    }
+    int32_t i32() { return (int32_t)u32(); }
+    std::string_view str() {
+        uint32_t n = u32();
+        if (!need(n)) return {};
+        std::string_view s((const char*)p, n);
+        p += n;
+        return s;
+    }
+    const std::string& name() { return internName(str()); }
+
+    // Every list entry takes at least one byte, which bounds `n` before
+    // anything is allocated for it.
+    uint32_t count() {
+        uint32_t n = u32();
+        if (ok && n > (size_t)(end - p)) ok = false;
+        return ok ? n : 0;
+    }
+    ParamList params() {
+        ParamList out;
+        uint32_t n = count();
+        if (n == 0) return out;
+        const std::string** items = arena.pointerArray<const std::string>(n);
+        for (uint32_t i = 0; i < n; ++i) items[i] = ok ? &name() : nullptr;
+        out.items = items;
+        out.count = n;
+        return out;
+    }
+    template <class T, class Fn>
+    NodeList<T> list(Fn read) {
+        NodeList<T> out;
+        uint32_t n = count();
+        if (n == 0) return out;
+        T** items = arena.pointerArray<T>(n);
+        for (uint32_t i = 0; i < n; ++i) items[i] = ok ? (this->*read)() : nullptr;
+        out.items = items;
+        out.count = n;
+        return out;
+    }
+    std::vector<Stmt*> topLevel() {
+        uint32_t n = count();
+        std::vector<Stmt*> v;
+        v.reserve(n);
+        for (uint32_t i = 0; i < n && ok; ++i) v.push_back(stmt());
+        return v;
+    }
+
+    Block* block() {
+        Stmt* s = stmt();
+        if (!ok || !s || s->getKind() != StmtKind::Block) {
+            ok = false;
+            return nullptr;
+        }
+        return static_cast<Block*>(s);
+    }
+
+    Expr* expr() {
+        uint8_t tag = u8();
+        if (!ok || tag == kNullNode) return nullptr;
+        switch ((ExprKind)tag) {
+        case ExprKind::Literal: return makeLiteral(arena, str());
+        case ExprKind::VarExpr: return arena.make<VarExpr>(name());
+        case ExprKind::AssignExpr: {
+            const std::string& n = name();
+            return arena.make<AssignExpr>(n, expr());
+        }
+        case ExprKind::Unary: {
+            int type = i32();
+            const std::string& lexeme = name();
+            return arena.make<Unary>(type, lexeme, expr());
+        }
+        case ExprKind::Binary: {
+            Expr* left = expr();
+            int type = i32();
+            const std::string& lexeme = name();
+            return arena.make<Binary>(left, type, lexeme, expr());
+        }
+        case ExprKind::Call: {
+            Expr* callee = expr();
+            return arena.make<Call>(callee, list<Expr>(&Reader::expr));
+        }
+        case ExprKind::Function: {
+            ParamList parameters = params();
+            return arena.make<FunctionExpr>(parameters, block());
+        }
+        case ExprKind::Index: {
+            Expr* object = expr();
+            return arena.make<IndexExpr>(object, expr());
+        }
+        case ExprKind::Get: {
+            Expr* object = expr();
+            return arena.make<GetExpr>(object, name());
+        }
+        case ExprKind::SetIndex: {
+            Expr* object = expr();
+            Expr* index = expr();
+            return arena.make<SetIndexExpr>(object, index, expr());
+        }
+        case ExprKind::Set: {
+            Expr* object = expr();
+            const std::string& n = name();
+            return arena.make<SetExpr>(object, n, expr());
+        }
+        case ExprKind::Concat: return arena.make<ConcatExpr>(list<Expr>(&Reader::expr));
+        }
+        ok = false;
+        return nullptr;
+    }
+
+    Stmt* stmt() {
+        uint8_t tag = u8();
+        if (!ok || tag == kNullNode) return nullptr;
+        switch ((StmtKind)tag) {
+        case StmtKind::Expression: return arena.make<ExpressionStmt>(expr());
+        case StmtKind::VarDecl: {
+            const std::string& n = name();
+            return arena.make<VarDecl>(n, expr());
+        }
+        case StmtKind::Block: return arena.make<Block>(list<Stmt>(&Reader::stmt));
+        case StmtKind::Function: {
+            const std::string& n = name();
+            ParamList parameters = params();
+            return arena.make<FunctionDecl>(n, parameters, block());
+        }
+        case StmtKind::Return: return arena.make<ReturnStmt>(expr());
+        case StmtKind::If: {
+            Expr* condition = expr();
+            Stmt* thenBranch = stmt();
+            return arena.make<IfStmt>(condition, thenBranch, stmt());
+        }
+        case StmtKind::While: {
+            Expr* condition = expr();
+            return arena.make<WhileStmt>(condition, stmt());
+        }
+        case StmtKind::Break: return arena.make<BreakStmt>();
+        case StmtKind::Continue: return arena.make<ContinueStmt>();
+        case StmtKind::DoWhile: {
+            Stmt* body = stmt();
+            return arena.make<DoWhileStmt>(body, expr());
+        }
+        }
+        ok = false;
+        return nullptr;
+    }
+
+private:
+    bool need(size_t n) {
+        if (!ok || (size_t)(end - p) < n) {
+            ok = false;
+            return false;
+        }
+        return true;
+    }
+
+    const unsigned char* p;
+    const unsigned char* end;
+    AstArena& arena;
+};
+
+// Read-only view of a cache file; mmap where available.
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat sb;
+        if (fstat(fd, &sb) == 0 && sb.st_size > 0) {
+            void* p = mmap(nullptr, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                mapped = p;
+                bytes = static_cast<const unsigned char*>(p);
+                length = (size_t)sb.st_size;
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return;
+        fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        bytes = reinterpret_cast<const unsigned char*>(fallback.data());
+        length = fallback.size();
+#endif
+    }
+    ~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped) munmap(mapped, length);
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    void* mapped = nullptr;
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+#if !(defined(__unix__) || defined(__APPLE__))
+    std::string fallback;
+#endif
+};
+
+bool readCache(const std::filesystem::path& cachePath, uint64_t sourceHash, uint64_t sourceSize, ScriptModule& out) {
+    MappedFile file(cachePath);
+    if (file.size() < sizeof(CacheHeader)) return false;
+    CacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) return false;
+    if (header.format != kFormatVersion || header.engineHash != engineHash()) return false;
+    if (header.sourceHash != sourceHash || header.sourceSize != sourceSize) return false;
+    // Nodes take roughly three times their serialized size.
+    ScriptModule module{AstArena((file.size() - sizeof(header)) * 3), {}};
+    Reader reader(file.data() + sizeof(header), file.data() + file.size(), module.arena);
+    module.statements = reader.topLevel();
+    if (!reader.ok || !reader.atEnd()) return false;
+    out = std::move(module);
+    return true;
+}
+
+void writeCache(const std::filesystem::path& cachePath, uint64_t sourceHash, uint64_t sourceSize, const std::vector<Stmt*>& statements) {
+    CacheHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.format = kFormatVersion;
+    header.engineHash = engineHash();
+    header.sourceHash = sourceHash;
+    header.sourceSize = sourceSize;
+    Writer writer;
+    writer.out.append((const char*)&header, sizeof(header));
+    writer.stmts(statements);
+
+    std::error_code ec;
+    std::filesystem::create_directories(cachePath.parent_path(), ec);
+    // Write then rename so a concurrent reader never maps a partial file.
+    std::filesystem::path tmp = cachePath;
+    tmp += ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+        file.write(writer.out.data(), (std::streamsize)writer.out.size());
+        if (!file) return;
+    }
+    std::filesystem::rename(tmp, cachePath, ec);
+    if (ec) std::filesystem::remove(tmp, ec);
+}
+} // namespace
+
+bool parseScriptFile(const std::string& path, ScriptModule& out, std::vector<std::string>& errors) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        errors.push_back("Failed to load script: " + path);
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string content = buffer.str();
+
+    bool useCache = cacheEnabled();
+    uint64_t sourceHash = fnv1a(content.data(), content.size());
+    std::filesystem::path cachePath;
+    if (useCache) {
+        cachePath = cachePathFor(path);
+        if (readCache(cachePath, sourceHash, content.size(), out)) return true;
+    }
+
+    Tokenizer tokenizer(content);
+    std::vector<Token> tokens = tokenizer.scanTokens();
+    if (tokenizer.hadError()) {
+        for (const auto& e : tokenizer.getErrors()) errors.push_back(e);
+        return false;
+    }
+    Parser parser(tokens);
+    out = parser.parse();
+    if (parser.hadError()) {
+        for (const auto& e : parser.getErrors()) errors.push_back(e);
+        return false;
+    }
+    if (useCache) writeCache(cachePath, sourceHash, content.size(), out.statements);
+    return true;
+}
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "ast.hpp"
+
+namespace yuki {
+// Reads, tokenizes and parses a script, going through an on-disk AST cache.
+// Entries live in `.yukicache/` (override with YUKI_CACHE_DIR, disable with
+// YUKI_CACHE=0), are keyed by the script path and validated against a hash of
+// the source and the engine version, and are memory-mapped when read.
+// Returns false with messages in `errors` if the file is missing or invalid.
+bool parseScriptFile(const std::string& path, ScriptModule& out, std::vector<std::string>& errors);
+}
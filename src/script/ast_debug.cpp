@@ -9,7 +9,7 @@ std::string printExpr(const Expr* expr) {
     switch (expr->getKind()) {
         case ExprKind::Literal: {
             const auto* l = static_cast<const Literal*>(expr);
-            return l->value;
+            return std::string(l->value);
         }
         case ExprKind::VarExpr: { // Renamed from Variable
             const auto* v = static_cast<const VarExpr*>(expr); // Renamed type
@@ -17,22 +17,28 @@ std::string printExpr(const Expr* expr) {
         }
         case ExprKind::AssignExpr: { // Renamed from Assign
             const auto* a = static_cast<const AssignExpr*>(expr); // Renamed type
-            return "(" + a->name + " = " + printExpr(a->value.get()) + ")";
+            return "(" + a->name + " = " + printExpr(a->value) + ")";
         }
         case ExprKind::Unary: {
             const auto* u = static_cast<const Unary*>(expr);
-            return "(" + u->op.lexeme + printExpr(u->right.get()) + ")";
+            return "(" + u->op.lexeme + printExpr(u->right) + ")";
         }
         case ExprKind::Binary: {
             const auto* b = static_cast<const Binary*>(expr);
-            return "(" + printExpr(b->left.get()) + " " + b->op.lexeme + " " + printExpr(b->right.get()) + ")";
+            return "(" + printExpr(b->left) + " " + b->op.lexeme + " " + printExpr(b->right) + ")";
+        }
+        case ExprKind::Concat: {
+            const auto* c = static_cast<const ConcatExpr*>(expr);
+            std::string s = "(";
+            for (size_t i = 0; i < c->parts.size(); ++i) s += (i ? " + " : "") + printExpr(c->parts[i]);
+            return s + ")";
         }
         case ExprKind::Call: {
             const auto* c = static_cast<const Call*>(expr);
             std::stringstream ss;
-            ss << printExpr(c->callee.get()) << "(";
+            ss << printExpr(c->callee) << "(";
             for (size_t i = 0; i < c->arguments.size(); ++i) {
-                ss << printExpr(c->arguments[i].get());
+                ss << printExpr(c->arguments[i]);
                 if (i < c->arguments.size() - 1) ss << ", ";
             }
             ss << ")";
@@ -49,21 +55,21 @@ std::string printStmt(const Stmt* stmt) {
     switch (stmt->getKind()) {
         case StmtKind::Expression: {
             const auto* e = static_cast<const ExpressionStmt*>(stmt);
-            return printExpr(e->expression.get()) + ";";
+            return printExpr(e->expression) + ";";
         }
         case StmtKind::VarDecl: {
             const auto* v = static_cast<const VarDecl*>(stmt);
             std::string s = "var " + v->name;
             if (v->initializer) {
-                s += " = " + printExpr(v->initializer.get());
+                s += " = " + printExpr(v->initializer);
             }
             return s + ";";
         }
         case StmtKind::Block: {
             const auto* b = static_cast<const Block*>(stmt);
             std::string s = "{ ";
-            for (const auto& st : b->statements) {
-                s += printStmt(st.get()) + " ";
+            for (const Stmt* st : b->statements) {
+                s += printStmt(st) + " ";
             }
             s += "}";
             return s;
@@ -72,31 +78,31 @@ std::string printStmt(const Stmt* stmt) {
             const auto* f = static_cast<const FunctionDecl*>(stmt);
             std::string s = "fn " + f->name + "(";
             for (size_t i = 0; i < f->parameters.size(); ++i) {
-                s += f->parameters[i];
+                s += *f->parameters[i];
                 if (i < f->parameters.size() - 1) s += ", ";
             }
-            s += ") " + printStmt(f->body.get());
+            s += ") " + printStmt(f->body);
             return s;
         }
         case StmtKind::Return: {
             const auto* r = static_cast<const ReturnStmt*>(stmt);
             std::string s = "return";
             if (r->value) {
-                s += " " + printExpr(r->value.get());
+                s += " " + printExpr(r->value);
             }
             return s + ";";
         }
         case StmtKind::If: {
             const auto* i = static_cast<const IfStmt*>(stmt);
-            std::string s = "if (" + printExpr(i->condition.get()) + ") " + printStmt(i->thenBranch.get());
+            std::string s = "if (" + printExpr(i->condition) + ") " + printStmt(i->thenBranch);
             if (i->elseBranch) {
-                s += " else " + printStmt(i->elseBranch.get());
+                s += " else " + printStmt(i->elseBranch);
             }
             return s;
         }
         case StmtKind::While: {
             const auto* w = static_cast<const WhileStmt*>(stmt);
-            return "while (" + printExpr(w->condition.get()) + ") " + printStmt(w->body.get());
+            return "while (" + printExpr(w->condition) + ") " + printStmt(w->body);
         }
         default:
             return "UnknownStmt";
@@ -1,5 +1,6 @@
 #include "builtins.hpp"
 #include "value.hpp"
+#include "frame_arena.hpp"
 #include <iostream>
 #include <unordered_map>
 #include <cmath>
@@ -136,6 +137,13 @@ Value builtinMapKeys(const std::vector<Value>& args) {
     }
     return Value::array(keys);
 }
+Value builtinFrameMapKeys(const std::vector<Value>& args) {
+    Value keys = frameArray();
+    if (args.size() < 1 || !args[0].isMap() || !args[0].mapPtr) return keys;
+    keys.arrayPtr->reserve(args[0].mapPtr->size());
+    for (const auto& kv : *args[0].mapPtr) keys.arrayPtr->push_back(Value::string(kv.first));
+    return keys;
+}
 Value builtinMapValues(const std::vector<Value>& args) {
     if (args.size() < 1 || !args[0].isMap() || !args[0].mapPtr) return Value::array({});
     std::vector<Value> vals;
@@ -235,6 +243,26 @@ Value builtinStrSplit(const std::vector<Value>& args) {
     parts.push_back(Value::string(s.substr(start)));
     return Value::array(parts);
 }
+Value builtinFrameStrSplit(const std::vector<Value>& args) {
+    Value parts = frameArray();
+    if (args.size() < 2 || !args[0].isString() || !args[1].isString()) return parts;
+    const std::string& s = args[0].stringVal;
+    const std::string& delim = args[1].stringVal;
+    std::vector<Value>& out = *parts.arrayPtr;
+    if (delim.empty()) {
+        out.push_back(args[0]);
+        return parts;
+    }
+    size_t start = 0;
+    size_t pos = s.find(delim);
+    while (pos != std::string::npos) {
+        out.push_back(Value::string(s.substr(start, pos - start)));
+        start = pos + delim.size();
+        pos = s.find(delim, start);
+    }
+    out.push_back(Value::string(s.substr(start)));
+    return parts;
+}
 Value builtinTypeOf(const std::vector<Value>& args) {
     if (args.empty()) return Value::string("nil");
     switch (args[0].type) {
@@ -316,6 +344,7 @@ void registerScriptBuiltins(std::unordered_map<std::string, NativeFn>& builtins)
     builtins["map_get"] = builtinMapGet;
     builtins["map_has"] = builtinMapHas;
     builtins["map_keys"] = builtinMapKeys;
+    builtins["frame_map_keys"] = builtinFrameMapKeys;
     builtins["map_values"] = builtinMapValues;
     builtins["map_delete"] = builtinMapDelete;
     builtins["map_merge"] = builtinMapMerge;
@@ -328,6 +357,7 @@ void registerScriptBuiltins(std::unordered_map<std::string, NativeFn>& builtins)
     builtins["join"] = builtinJoin;
     builtins["str_replace"] = builtinStrReplace;
     builtins["str_split"] = builtinStrSplit;
+    builtins["frame_str_split"] = builtinFrameStrSplit;
     builtins["typeof"] = builtinTypeOf;
     builtins["assert"] = builtinAssert;
     builtins["randf"] = builtinRandf;
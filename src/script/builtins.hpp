@@ -24,6 +24,7 @@ namespace yuki {
     Value builtinMapGet(const std::vector<Value>& args);
     Value builtinMapHas(const std::vector<Value>& args);
     Value builtinMapKeys(const std::vector<Value>& args);
+    Value builtinFrameMapKeys(const std::vector<Value>& args);
     Value builtinMapValues(const std::vector<Value>& args);
     Value builtinMapDelete(const std::vector<Value>& args);
     Value builtinMapMerge(const std::vector<Value>& args);
@@ -36,6 +37,7 @@ namespace yuki {
     Value builtinJoin(const std::vector<Value>& args);
     Value builtinStrReplace(const std::vector<Value>& args);
     Value builtinStrSplit(const std::vector<Value>& args);
+    Value builtinFrameStrSplit(const std::vector<Value>& args);
     Value builtinTypeOf(const std::vector<Value>& args);
     Value builtinAssert(const std::vector<Value>& args);
     Value builtinRandf(const std::vector<Value>& args);
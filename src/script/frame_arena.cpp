@@ -0,0 +1,96 @@
+#include "frame_arena.hpp"
+
+namespace yuki {
+namespace {
+// The pool's own reference is the only one left.
+template <class T>
+bool unused(const std::shared_ptr<T>& p) {
+    return p && p.use_count() == 1;
+}
+
+// Moves the still-usable entries of `pool[0, used)` to the front, dropping
+// escaped ones; returns how many were dropped.
+template <class T>
+size_t compact(std::vector<std::shared_ptr<T>>& pool, size_t used) {
+    size_t kept = 0;
+    for (size_t i = 0; i < pool.size(); ++i) {
+        if (i < used && !unused(pool[i])) continue;
+        if (kept != i) pool[kept] = std::move(pool[i]);
+        ++kept;
+    }
+    size_t dropped = pool.size() - kept;
+    pool.resize(kept);
+    return dropped;
+}
+} // namespace
+
+std::shared_ptr<FrameArena::Array> FrameArena::array() {
+    if (arrayCursor == arrays.size()) arrays.push_back(std::make_shared<Array>());
+    std::shared_ptr<Array>& slot = arrays[arrayCursor++];
+    slot->clear();
+    return slot;
+}
+
+std::shared_ptr<FrameArena::Map> FrameArena::map(std::initializer_list<std::pair<const char*, Value>> fields) {
+    if (mapCursor == maps.size()) maps.push_back(std::make_shared<Map>());
+    std::shared_ptr<Map>& slot = maps[mapCursor++];
+    Map& m = *slot;
+    // Same keys as last time (the usual case): overwrite in place.
+    bool sameKeys = m.size() == fields.size();
+    if (sameKeys) {
+        for (const auto& field : fields) {
+            auto it = m.find(field.first);
+            if (it == m.end()) {
+                sameKeys = false;
+                break;
+            }
+            it->second = field.second;
+        }
+    }
+    if (!sameKeys) {
+        m.clear();
+        for (const auto& field : fields) m[field.first] = field.second;
+    }
+    return slot;
+}
+
+void FrameArena::reset() {
+    last.maps = mapCursor;
+    last.arrays = arrayCursor;
+    // Arrays first: emptying them releases the maps they hold (hit lists).
+    for (size_t i = 0; i < arrayCursor; ++i) {
+        if (unused(arrays[i])) arrays[i]->clear();
+    }
+    last.escaped = compact(arrays, arrayCursor) + compact(maps, mapCursor);
+    arrayCursor = 0;
+    mapCursor = 0;
+}
+
+void FrameArena::clear() {
+    arrays.clear();
+    maps.clear();
+    arrayCursor = 0;
+    mapCursor = 0;
+    last = Stats{};
+}
+
+FrameArena& frameArena() {
+    static FrameArena arena;
+    return arena;
+}
+
+Value frameArray() {
+    Value v;
+    v.type = ValueType::Array;
+    v.arrayPtr = frameArena().array();
+    return v;
+}
+
+Value frameMap(std::initializer_list<std::pair<const char*, Value>> fields) {
+    Value v;
+    v.type = ValueType::Map;
+    v.mapPtr = frameArena().map(fields);
+    return v;
+}
+
+} // namespace yuki
@@ -0,0 +1,61 @@
+#pragma once
+#include "value.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace yuki {
+
+// Frame-scoped storage for the temporary maps and arrays returned by the
+// `frame_*` builtins. Containers are handed out from two pools with a cursor
+// that reset() rewinds once per frame, so the same call sequence gets the
+// same containers back every frame and a steady-state frame allocates
+// nothing for them: arrays keep their capacity, maps keep their nodes when
+// refilled with the same keys.
+//
+// Escapes are caught at reset(): a container the script still references
+// (stored in a global, a map, an entity...) is released from the pool and
+// lives on as an ordinary value, so holding on to a frame value is slower
+// but never unsafe. Main thread only.
+class FrameArena {
+public:
+    using Map = std::unordered_map<std::string, Value>;
+    using Array = std::vector<Value>;
+
+    struct Stats {
+        size_t maps = 0;    // handed out during the frame
+        size_t arrays = 0;
+        size_t escaped = 0; // still referenced at the end of the frame
+    };
+
+    // Empty array.
+    std::shared_ptr<Array> array();
+    // Map holding exactly `fields`.
+    std::shared_ptr<Map> map(std::initializer_list<std::pair<const char*, Value>> fields);
+
+    // End of frame: rewinds the pools and drops escaped containers.
+    void reset();
+    // Drops every pooled container (interpreter restart).
+    void clear();
+
+    const Stats& lastFrame() const { return last; }
+
+private:
+    std::vector<std::shared_ptr<Array>> arrays;
+    std::vector<std::shared_ptr<Map>> maps;
+    size_t arrayCursor = 0;
+    size_t mapCursor = 0;
+    Stats last;
+};
+
+FrameArena& frameArena();
+
+// Value wrappers for bindings.
+Value frameArray();
+Value frameMap(std::initializer_list<std::pair<const char*, Value>> fields);
+
+} // namespace yuki
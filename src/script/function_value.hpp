@@ -3,11 +3,13 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include "ast_arena.hpp"
 
 namespace yuki {
 
 class Environment;
 struct Block;
+struct ScriptModule;
 struct Value;
 
 using NativeFn = Value(*)(const std::vector<Value>&);
@@ -17,9 +19,12 @@ struct FunctionValue {
     std::string name;
 
     // Script Function
-    std::vector<std::string> parameters;
+    NodeList<const std::string> parameters; // Interned names, listed in the AST
     Block* body; // Owned by AST, not FunctionValue
     std::shared_ptr<Environment> closure; // Shared lifetime with captured scope
+    // Keeps a hot-reloaded module's AST alive while functions point into it;
+    // null for code from modules the interpreter retains for good.
+    std::shared_ptr<const ScriptModule> module;
 
     // Native Function
     NativeFn nativeFn;
@@ -2,6 +2,7 @@
 #include "../core/engine_bindings.hpp"
 #include "../core/log.hpp"
 #include "builtins.hpp"
+#include "script_profiler.hpp"
 #include <iostream>
 #include <cmath>
 #include <memory>
@@ -36,6 +37,26 @@ void Interpreter::popEnv() {
     }
 }
 
+namespace {
+// Room Value::appendTo needs; exact except for numbers (upper bound).
+size_t concatSize(const Value& v) {
+    switch (v.type) {
+        case ValueType::String: return v.stringVal.size();
+        case ValueType::Number: return kMaxNumberChars;
+        case ValueType::Bool: return 5;
+        case ValueType::Function: return 11 + (v.functionVal ? v.functionVal->name.size() : 0);
+        case ValueType::Map: return 5;
+        case ValueType::Array: return 7;
+        case ValueType::Nil: return 3;
+    }
+    return 0;
+}
+
+bool isTextLiteral(const Expr* e) {
+    return e->getKind() == ExprKind::Literal && static_cast<const Literal*>(e)->type == LiteralType::String;
+}
+} // namespace
+
 bool isTruthy(const Value& v) {
     if (v.isNil()) return false;
     if (v.isBool()) return v.boolVal;
@@ -58,6 +79,7 @@ bool isEqual(const Value& a, const Value& b) {
 Value Interpreter::callFunction(FunctionValue* fn, const std::vector<Value>& args) {
     if (!fn || hasRuntimeErrors()) return Value::nilVal();
 
+    ScriptProfiler::Scope profile(scriptProfiler(), fn->isNative ? (const void*)fn->nativeFn : (const void*)fn->body, fn->name);
     if (fn->isNative) {
         if (fn->nativeFn) return fn->nativeFn(args);
         return Value::nilVal();
@@ -65,13 +87,15 @@ Value Interpreter::callFunction(FunctionValue* fn, const std::vector<Value>& arg
     std::string frameName = fn->name.empty() ? "<anon>" : fn->name;
     callStack.push_back(frameName);
     functionDepth++;
+    FunctionValue* caller = currentFunction;
+    currentFunction = fn;
 
     std::shared_ptr<Environment> closure = std::make_shared<Environment>(fn->closure);
     for (size_t i = 0; i < fn->parameters.size(); ++i) {
         if (i < args.size()) {
-            closure->define(fn->parameters[i], args[i]);
+            closure->define(*fn->parameters[i], args[i]);
         } else {
-            closure->define(fn->parameters[i], Value::nilVal());
+            closure->define(*fn->parameters[i], Value::nilVal());
         }
     }
 
@@ -81,8 +105,8 @@ Value Interpreter::callFunction(FunctionValue* fn, const std::vector<Value>& arg
     
     try {
         if (fn->body) {
-            for (const auto& stmt : fn->body->statements) {
-                evalStmt(stmt.get());
+            for (const Stmt* stmt : fn->body->statements) {
+                evalStmt(stmt);
             }
         }
     } catch (const ReturnSignal& sig) {
@@ -90,6 +114,7 @@ Value Interpreter::callFunction(FunctionValue* fn, const std::vector<Value>& arg
     }
     
     env = previous;
+    currentFunction = caller;
     functionDepth--;
     callStack.pop_back();
     return ret;
@@ -110,13 +135,14 @@ Value Interpreter::evalExpr(const Expr* expr) {
     switch (expr->getKind()) {
         case ExprKind::Literal: {
             const auto* l = static_cast<const Literal*>(expr);
-            char* end;
-            double d = std::strtod(l->value.c_str(), &end);
-            if (end != l->value.c_str() && *end == '\0') return Value::number(d);
-            if (l->value == "true") return Value::boolean(true);
-            if (l->value == "false") return Value::boolean(false);
-            if (l->value == "nil") return Value::nilVal();
-            return Value::string(l->value);
+            switch (l->type) {
+                case LiteralType::Number: return Value::number(l->number);
+                case LiteralType::True: return Value::boolean(true);
+                case LiteralType::False: return Value::boolean(false);
+                case LiteralType::Nil: return Value::nilVal();
+                case LiteralType::String: break;
+            }
+            return Value::string(std::string(l->value));
         }
         case ExprKind::VarExpr: {
             const auto* v = static_cast<const VarExpr*>(expr);
@@ -129,7 +155,7 @@ Value Interpreter::evalExpr(const Expr* expr) {
         }
         case ExprKind::AssignExpr: {
             const auto* a = static_cast<const AssignExpr*>(expr);
-            Value val = evalExpr(a->value.get());
+            Value val = evalExpr(a->value);
             if (!env->assign(a->name, val)) {
                 env->define(a->name, val);
             }
@@ -137,8 +163,8 @@ Value Interpreter::evalExpr(const Expr* expr) {
         }
         case ExprKind::Unary: {
             const auto* u = static_cast<const Unary*>(expr);
-            Value right = evalExpr(u->right.get());
-            std::string op = u->op.lexeme;
+            Value right = evalExpr(u->right);
+            const std::string& op = u->op.lexeme;
             if (op == "-") {
                 if (!right.isNumber()) {
                     reportRuntimeError("Unary '-' expects a number");
@@ -153,24 +179,28 @@ Value Interpreter::evalExpr(const Expr* expr) {
         }
         case ExprKind::Binary: {
             const auto* b = static_cast<const Binary*>(expr);
-            std::string op = b->op.lexeme;
+            const std::string& op = b->op.lexeme;
             if (op == "and") {
-                Value left = evalExpr(b->left.get());
+                Value left = evalExpr(b->left);
                 if (!isTruthy(left)) return left;
-                return evalExpr(b->right.get());
+                return evalExpr(b->right);
             }
             if (op == "or") {
-                Value left = evalExpr(b->left.get());
+                Value left = evalExpr(b->left);
                 if (isTruthy(left)) return left;
-                return evalExpr(b->right.get());
+                return evalExpr(b->right);
             }
 
-            Value left = evalExpr(b->left.get());
-            Value right = evalExpr(b->right.get());
+            Value left = evalExpr(b->left);
+            Value right = evalExpr(b->right);
             
             if (op == "+") {
                 if (left.isNumber() && right.isNumber()) return Value::number(left.numberVal + right.numberVal);
-                return Value::string(left.toString() + right.toString());
+                std::string text;
+                text.reserve(concatSize(left) + concatSize(right));
+                left.appendTo(text);
+                right.appendTo(text);
+                return Value::string(std::move(text));
             }
             if (op == "-" || op == "*" || op == "/" || op == "%" || op == ">" || op == ">=" || op == "<" || op == "<=") {
                 if (!left.isNumber() || !right.isNumber()) {
@@ -204,10 +234,11 @@ Value Interpreter::evalExpr(const Expr* expr) {
         }
         case ExprKind::Call: {
             const auto* c = static_cast<const Call*>(expr);
-            Value callee = evalExpr(c->callee.get());
+            Value callee = evalExpr(c->callee);
             std::vector<Value> args;
-            for (const auto& arg : c->arguments) {
-                args.push_back(evalExpr(arg.get()));
+            args.reserve(c->arguments.size());
+            for (const Expr* arg : c->arguments) {
+                args.push_back(evalExpr(arg));
             }
             return callFunction(callee, args);
         }
@@ -217,15 +248,16 @@ Value Interpreter::evalExpr(const Expr* expr) {
             fn->isNative = false;
             fn->name = "<lambda>";
             fn->parameters = f->parameters;
-            fn->body = f->body.get();
+            fn->body = f->body;
             fn->closure = env;
+            fn->module = currentFunction ? currentFunction->module : topLevelModule;
             allocatedFunctions.push_back(fn);
             return Value::function(fn);
         }
         case ExprKind::Index: {
             const auto* ix = static_cast<const IndexExpr*>(expr);
-            Value obj = evalExpr(ix->object.get());
-            Value idx = evalExpr(ix->index.get());
+            Value obj = evalExpr(ix->object);
+            Value idx = evalExpr(ix->index);
             if (obj.isArray()) {
                 if (!obj.arrayPtr) return Value::nilVal();
                 if (!idx.isNumber()) {
@@ -248,7 +280,7 @@ Value Interpreter::evalExpr(const Expr* expr) {
         }
         case ExprKind::Get: {
             const auto* gx = static_cast<const GetExpr*>(expr);
-            Value obj = evalExpr(gx->object.get());
+            Value obj = evalExpr(gx->object);
             if (obj.isMap()) {
                 if (!obj.mapPtr) return Value::nilVal();
                 auto it = obj.mapPtr->find(gx->name);
@@ -260,9 +292,9 @@ Value Interpreter::evalExpr(const Expr* expr) {
         }
         case ExprKind::SetIndex: {
             const auto* sx = static_cast<const SetIndexExpr*>(expr);
-            Value obj = evalExpr(sx->object.get());
-            Value idx = evalExpr(sx->index.get());
-            Value val = evalExpr(sx->value.get());
+            Value obj = evalExpr(sx->object);
+            Value idx = evalExpr(sx->index);
+            Value val = evalExpr(sx->value);
             if (obj.isArray()) {
                 if (!obj.arrayPtr) {
                     reportRuntimeError("Array assignment on nil array");
@@ -293,10 +325,35 @@ Value Interpreter::evalExpr(const Expr* expr) {
             reportRuntimeError("Index assignment expects array or map");
             return Value::nilVal();
         }
+        case ExprKind::Concat: {
+            // Evaluate every part first so the result is allocated once at
+            // its final size; string literals are appended straight from the AST.
+            const auto* c = static_cast<const ConcatExpr*>(expr);
+            size_t base = concatParts.size();
+            size_t size = 0;
+            for (const Expr* part : c->parts) {
+                if (isTextLiteral(part)) {
+                    size += static_cast<const Literal*>(part)->value.size();
+                    concatParts.push_back(Value::nilVal());
+                    continue;
+                }
+                Value v = evalExpr(part);
+                size += concatSize(v);
+                concatParts.push_back(std::move(v));
+            }
+            std::string text;
+            text.reserve(size);
+            for (size_t i = 0; i < c->parts.size(); ++i) {
+                if (isTextLiteral(c->parts[i])) text.append(static_cast<const Literal*>(c->parts[i])->value);
+                else concatParts[base + i].appendTo(text);
+            }
+            concatParts.resize(base);
+            return Value::string(std::move(text));
+        }
         case ExprKind::Set: {
             const auto* sx = static_cast<const SetExpr*>(expr);
-            Value obj = evalExpr(sx->object.get());
-            Value val = evalExpr(sx->value.get());
+            Value obj = evalExpr(sx->object);
+            Value val = evalExpr(sx->value);
             if (!obj.isMap() || !obj.mapPtr) {
                 reportRuntimeError("Property assignment expects map");
                 return Value::nilVal();
@@ -314,13 +371,13 @@ Value Interpreter::evalStmt(const Stmt* stmt) {
     switch (stmt->getKind()) {
         case StmtKind::Expression: {
             const auto* es = static_cast<const ExpressionStmt*>(stmt);
-            return evalExpr(es->expression.get());
+            return evalExpr(es->expression);
         }
         case StmtKind::VarDecl: {
             const auto* vs = static_cast<const VarDecl*>(stmt);
             Value val = Value::nilVal();
             if (vs->initializer) {
-                val = evalExpr(vs->initializer.get());
+                val = evalExpr(vs->initializer);
             }
             env->define(vs->name, val);
             return Value::nilVal();
@@ -337,8 +394,9 @@ Value Interpreter::evalStmt(const Stmt* stmt) {
             fn->isNative = false;
             fn->name = fs->name;
             fn->parameters = fs->parameters;
-            fn->body = fs->body.get();
+            fn->body = fs->body;
             fn->closure = env;
+            fn->module = currentFunction ? currentFunction->module : topLevelModule;
             allocatedFunctions.push_back(fn);
             env->define(fs->name, Value::function(fn));
             return Value::nilVal();
@@ -347,7 +405,7 @@ Value Interpreter::evalStmt(const Stmt* stmt) {
             const auto* rs = static_cast<const ReturnStmt*>(stmt);
             Value val = Value::nilVal();
             if (rs->value) {
-                val = evalExpr(rs->value.get());
+                val = evalExpr(rs->value);
             }
             if (functionDepth <= 0) {
                 reportRuntimeError("Return used outside of a function");
@@ -357,19 +415,19 @@ Value Interpreter::evalStmt(const Stmt* stmt) {
         }
         case StmtKind::If: {
             const auto* is = static_cast<const IfStmt*>(stmt);
-            if (isTruthy(evalExpr(is->condition.get()))) {
-                evalStmt(is->thenBranch.get());
+            if (isTruthy(evalExpr(is->condition))) {
+                evalStmt(is->thenBranch);
             } else if (is->elseBranch) {
-                evalStmt(is->elseBranch.get());
+                evalStmt(is->elseBranch);
             }
             return Value::nilVal();
         }
         case StmtKind::While: {
             const auto* ws = static_cast<const WhileStmt*>(stmt);
             loopDepth++;
-            while (isTruthy(evalExpr(ws->condition.get()))) {
+            while (isTruthy(evalExpr(ws->condition))) {
                 try {
-                    evalStmt(ws->body.get());
+                    evalStmt(ws->body);
                 } catch (const ContinueSignal&) {
                     continue;
                 } catch (const BreakSignal&) {
@@ -399,13 +457,13 @@ Value Interpreter::evalStmt(const Stmt* stmt) {
             bool shouldBreak = false;
             do {
                 try {
-                    evalStmt(ds->body.get());
+                    evalStmt(ds->body);
                 } catch (const ContinueSignal&) {
                 } catch (const BreakSignal&) {
                     shouldBreak = true;
                 }
                 if (shouldBreak) break;
-            } while (isTruthy(evalExpr(ds->condition.get())));
+            } while (isTruthy(evalExpr(ds->condition)));
             loopDepth--;
             return Value::nilVal();
         }
@@ -417,8 +475,8 @@ Value Interpreter::execBlock(const Block* block, std::shared_ptr<Environment> ne
     std::shared_ptr<Environment> previous = env;
     pushEnv(newEnv);
     try {
-        for (const auto& stmt : block->statements) {
-            evalStmt(stmt.get());
+        for (const Stmt* stmt : block->statements) {
+            evalStmt(stmt);
         }
     } catch (...) {
         env = previous;
@@ -428,10 +486,10 @@ Value Interpreter::execBlock(const Block* block, std::shared_ptr<Environment> ne
     return Value::nilVal();
 }
 
-Value Interpreter::exec(const std::vector<std::unique_ptr<Stmt>>& statements) {
+Value Interpreter::exec(const std::vector<Stmt*>& statements) {
     try {
-        for (const auto& stmt : statements) {
-            evalStmt(stmt.get());
+        for (const Stmt* stmt : statements) {
+            evalStmt(stmt);
             if (hasRuntimeErrors()) break;
         }
     } catch (const ReturnSignal& sig) {
@@ -440,8 +498,115 @@ Value Interpreter::exec(const std::vector<std::unique_ptr<Stmt>>& statements) {
     return Value::nilVal();
 }
 
-void Interpreter::retainModule(std::vector<std::unique_ptr<Stmt>>&& statements) {
-    ownedModules.push_back(std::move(statements));
+void Interpreter::retainModule(ScriptModule&& module) {
+    ownedModules.push_back(std::move(module));
+}
+
+namespace {
+constexpr int kMaxReloadMergeDepth = 8;
+using FunctionTable = std::unordered_map<std::string, std::vector<FunctionValue*>>;
+using FunctionHomes = std::unordered_map<FunctionValue*, std::string>;
+
+// A function bound under several paths (`var state = idle;`, an exports map)
+// belongs to one of them: its declared name, else the shortest path.
+bool betterHome(const std::string& a, const std::string& b, const FunctionValue* fn) {
+    if (a == fn->name || b == fn->name) return a == fn->name;
+    if (a.size() != b.size()) return a.size() < b.size();
+    return a < b;
+}
+
+void collectHomes(const Value& v, const std::string& path, FunctionHomes& homes, int depth) {
+    if (v.isFunction()) {
+        FunctionValue* fn = v.functionVal;
+        if (!fn || fn->isNative) return;
+        auto it = homes.emplace(fn, path).first;
+        if (betterHome(path, it->second, fn)) it->second = path;
+        return;
+    }
+    if (v.isMap() && v.mapPtr && depth < kMaxReloadMergeDepth) {
+        for (const auto& kv : *v.mapPtr) collectHomes(kv.second, path + "." + kv.first, homes, depth + 1);
+    }
+}
+
+FunctionHomes homesIn(const Environment& scope) {
+    FunctionHomes homes;
+    for (const auto& kv : scope.values) collectHomes(kv.second, kv.first, homes, 0);
+    return homes;
+}
+
+// Bindings only: new names and keys are added, everything else keeps its
+// current value. Functions are updated through the FunctionTable instead.
+void mergeReloaded(Value& current, const Value& fresh, int depth) {
+    if (current.isNil()) {
+        current = fresh;
+        return;
+    }
+    if (fresh.isMap() && current.isMap() && current.mapPtr != fresh.mapPtr && depth < kMaxReloadMergeDepth) {
+        for (const auto& kv : *fresh.mapPtr) mergeReloaded((*current.mapPtr)[kv.first], kv.second, depth + 1);
+    }
+}
+} // namespace
+
+void Interpreter::recordModuleFunctions(const std::shared_ptr<Environment>& scope) {
+    FunctionTable& table = moduleFunctions[scope.get()];
+    table.clear();
+    for (const auto& kv : homesIn(*scope)) table[kv.second].push_back(kv.first);
+}
+
+bool Interpreter::reloadInto(ScriptModule&& module, const std::shared_ptr<Environment>& target) {
+    auto scratch = std::make_shared<Environment>(target->parent ? target->parent : target);
+    auto dir = target->values.find("__module_dir");
+    if (dir != target->values.end()) scratch->define(dir->first, dir->second);
+    size_t firstFunction = allocatedFunctions.size();
+    std::shared_ptr<Environment> previous = env;
+    // Functions created by the new code point into this AST and keep it
+    // alive; once none of them does, it is freed.
+    auto code = std::make_shared<const ScriptModule>(std::move(module));
+    topLevelModule = code;
+    env = scratch;
+    exec(code->statements);
+    env = previous;
+    topLevelModule.reset();
+    if (hasRuntimeErrors()) {
+        // The top level may have handed some of them out already; they stay
+        // callable but do nothing.
+        for (size_t i = firstFunction; i < allocatedFunctions.size(); ++i) {
+            FunctionValue* fn = allocatedFunctions[i];
+            if (fn->module != code) continue;
+            fn->parameters = {};
+            fn->body = nullptr;
+            fn->closure.reset();
+            fn->module.reset();
+        }
+        return false;
+    }
+    for (size_t i = firstFunction; i < allocatedFunctions.size(); ++i) {
+        if (allocatedFunctions[i]->closure == scratch) allocatedFunctions[i]->closure = target;
+    }
+    // Patch the functions the previous version of each declaration created,
+    // wherever they are referenced from; what a name holds now is left alone
+    // (it may have been reassigned at runtime).
+    FunctionTable& table = moduleFunctions[target.get()];
+    FunctionTable next;
+    for (const auto& kv : homesIn(*scratch)) {
+        FunctionValue* src = kv.first;
+        std::vector<FunctionValue*>& same = next[kv.second];
+        auto old = table.find(kv.second);
+        if (old != table.end()) {
+            for (FunctionValue* dst : old->second) {
+                if (dst == src || dst->name != src->name) continue;
+                dst->parameters = src->parameters;
+                dst->body = src->body;
+                dst->closure = src->closure;
+                dst->module = src->module;
+                same.push_back(dst);
+            }
+        }
+        same.push_back(src);
+    }
+    table = std::move(next);
+    for (const auto& kv : scratch->values) mergeReloaded(target->values[kv.first], kv.second, 0);
+    return true;
 }
 
 void Interpreter::clearRuntimeErrors() {
@@ -28,10 +28,28 @@ public:
     Value execBlock(const Block* block, std::shared_ptr<Environment> newEnv);
     Value callFunction(FunctionValue* fn, const std::vector<Value>& args);
     Value callFunction(const Value& fn, const std::vector<Value>& args);
-    Value exec(const std::vector<std::unique_ptr<Stmt>>& statements);
+    Value exec(const std::vector<Stmt*>& statements);
     void clearRuntimeErrors();
     void runtimeError(const std::string& message);
-    void retainModule(std::vector<std::unique_ptr<Stmt>>&& statements);
+    // Keeps a module's AST alive for as long as the interpreter: functions it
+    // defined point into its arena.
+    void retainModule(ScriptModule&& module);
+    // Notes which function objects the top level of a module just run in
+    // `scope` bound to each name (and to each key of its maps, a few levels
+    // deep). reloadInto() only patches those, so call this right after the
+    // top level, before other code can reassign the module's globals.
+    void recordModuleFunctions(const std::shared_ptr<Environment>& scope);
+    // Hot reload: runs `module` in a scratch scope beside `target` and
+    // merges the result into it. The function objects the previous version
+    // of a declaration created (see recordModuleFunctions) are patched in
+    // place, so every reference (maps, entity callbacks, engine handlers)
+    // runs the new code; a name reassigned at runtime keeps its value. New
+    // names are added; existing data keeps its current value. Maps are
+    // merged the same way a few levels deep. The module's AST lives as long
+    // as a function still points into it. Returns false on a runtime error,
+    // leaving `target` untouched and disabling the functions the failed run
+    // created (calling one returns nil).
+    bool reloadInto(ScriptModule&& module, const std::shared_ptr<Environment>& target);
     bool hasRuntimeErrors() const { return !runtimeErrors.empty(); }
     const std::vector<std::string>& getRuntimeErrors() const { return runtimeErrors; }
     
@@ -49,7 +67,14 @@ private:
     std::vector<FunctionValue*> allocatedFunctions;
     std::vector<std::string> runtimeErrors;
     std::vector<std::string> callStack;
-    std::vector<std::vector<std::unique_ptr<Stmt>>> ownedModules;
+    std::vector<ScriptModule> ownedModules;
+    // Per module scope: binding path ("name" or "map.key") -> every function
+    // object created for that declaration so far.
+    using FunctionTable = std::unordered_map<std::string, std::vector<FunctionValue*>>;
+    std::unordered_map<const Environment*, FunctionTable> moduleFunctions;
+    std::shared_ptr<const ScriptModule> topLevelModule; // reloaded module while its top level runs
+    FunctionValue* currentFunction = nullptr;
+    std::vector<Value> concatParts; // stack of evaluated ConcatExpr parts (nested chains push above)
     int functionDepth = 0;
     int loopDepth = 0;
 };
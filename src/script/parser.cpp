@@ -3,22 +3,43 @@
 
 namespace yuki {
 
-Parser::Parser(const std::vector<Token>& tokens) : tokens(tokens) {}
+namespace {
+// Rough AST bytes per token, so typical scripts fit in the first block.
+constexpr size_t kArenaBytesPerToken = 40;
+}
+
+Parser::Parser(const std::vector<Token>& tokens) : tokens(tokens), arena(tokens.size() * kArenaBytesPerToken) {}
 
-std::vector<std::unique_ptr<Stmt>> Parser::parse() {
-    std::vector<std::unique_ptr<Stmt>> statements;
+ScriptModule Parser::parse() {
+    std::vector<Stmt*> statements;
     while (!isAtEnd()) {
-        std::unique_ptr<Stmt> stmt = declaration();
+        Stmt* stmt = declaration();
         if (stmt) {
-            statements.push_back(std::move(stmt));
+            statements.push_back(stmt);
         }
     }
-    return statements;
+    return ScriptModule{std::move(arena), std::move(statements)};
+}
+
+template <class T>
+NodeList<T> Parser::takeList(size_t start) {
+    // Nodes and interned names are gathered as void*; cast back on the way out.
+    NodeList<T> out;
+    size_t n = scratch.size() - start;
+    if (n > 0) {
+        T** items = arena.pointerArray<T>(n);
+        for (size_t i = 0; i < n; ++i) items[i] = static_cast<T*>(const_cast<void*>(scratch[start + i]));
+        out.items = items;
+        out.count = (uint32_t)n;
+    }
+    scratch.resize(start);
+    return out;
 }
 
-std::unique_ptr<Stmt> Parser::declaration() {
+Stmt* Parser::declaration() {
+    size_t scratchMark = scratch.size();
     try {
-        if (checkKeyword("fn")) {
+        if (check(TokenType::Fn)) {
             bool isNamed = false;
             if (current + 2 < (int)tokens.size()) {
                 isNamed = tokens[current + 1].type == TokenType::Identifier && tokens[current + 2].type == TokenType::LeftParen;
@@ -28,182 +49,174 @@ std::unique_ptr<Stmt> Parser::declaration() {
                 return funDecl();
             }
         }
-        if (matchKeyword("var")) return varDecl();
+        if (match({TokenType::Var})) return varDecl();
         return statement();
     } catch (const std::runtime_error&) {
+        scratch.resize(scratchMark);
         synchronize();
         return nullptr;
     }
 }
 
-std::unique_ptr<Stmt> Parser::funDecl() {
-    Token name = consume(TokenType::Identifier, "Expect function name.");
-    consume(TokenType::LeftParen, "Expect '(' after function name.");
-    
-    std::vector<std::string> parameters;
+ParamList Parser::parameterList() {
+    size_t start = scratch.size();
     if (!check(TokenType::RightParen)) {
         do {
-            parameters.push_back(consume(TokenType::Identifier, "Expect parameter name.").text);
+            scratch.push_back(&internName(consume(TokenType::Identifier, "Expect parameter name.").text));
         } while (match({TokenType::Comma}));
     }
     consume(TokenType::RightParen, "Expect ')' after parameters.");
-    std::unique_ptr<Block> body = block();
-    return std::make_unique<FunctionDecl>(name.text, std::move(parameters), std::move(body));
+    return takeList<const std::string>(start);
+}
+
+Stmt* Parser::funDecl() {
+    const Token& name = consume(TokenType::Identifier, "Expect function name.");
+    consume(TokenType::LeftParen, "Expect '(' after function name.");
+    ParamList parameters = parameterList();
+    Block* body = block();
+    return arena.make<FunctionDecl>(internName(name.text), parameters, body);
 }
 
-std::unique_ptr<Stmt> Parser::varDecl() {
-    Token name = consume(TokenType::Identifier, "Expect variable name.");
-    std::unique_ptr<Expr> initializer = nullptr;
+Stmt* Parser::varDecl() {
+    const Token& name = consume(TokenType::Identifier, "Expect variable name.");
+    Expr* initializer = nullptr;
     if (match({TokenType::Equal})) {
         initializer = expression();
     }
     consume(TokenType::Semicolon, "Expect ';' after variable declaration.");
-    return std::make_unique<VarDecl>(name.text, std::move(initializer));
-}
-
-std::unique_ptr<Stmt> Parser::statement() {
-    if (matchKeyword("if")) return ifStatement();
-    if (matchKeyword("while")) return whileStatement();
-    if (matchKeyword("for")) return forStatement();
-    if (matchKeyword("do")) {
-        std::unique_ptr<Stmt> body = statement();
-        consume(TokenType::Identifier, "Expect 'while' after do body.");
-        if (previous().text != "while") {
-            error(previous(), "Expect 'while' after do body.");
-            throw std::runtime_error("Expect 'while' after do body.");
-        }
+    return arena.make<VarDecl>(internName(name.text), initializer);
+}
+
+Stmt* Parser::statement() {
+    if (match({TokenType::If})) return ifStatement();
+    if (match({TokenType::While})) return whileStatement();
+    if (match({TokenType::For})) return forStatement();
+    if (match({TokenType::Do})) {
+        Stmt* body = statement();
+        consume(TokenType::While, "Expect 'while' after do body.");
         consume(TokenType::LeftParen, "Expect '(' after 'while'.");
-        std::unique_ptr<Expr> condition = expression();
+        Expr* condition = expression();
         consume(TokenType::RightParen, "Expect ')' after condition.");
         consume(TokenType::Semicolon, "Expect ';' after do-while.");
-        return std::make_unique<DoWhileStmt>(std::move(body), std::move(condition));
+        return arena.make<DoWhileStmt>(body, condition);
     }
-    if (matchKeyword("return")) return returnStatement();
-    if (matchKeyword("break")) { consume(TokenType::Semicolon, "Expect ';' after break."); return std::make_unique<BreakStmt>(); }
-    if (matchKeyword("continue")) { consume(TokenType::Semicolon, "Expect ';' after continue."); return std::make_unique<ContinueStmt>(); }
-    if (check(TokenType::LeftBrace)) return block(); 
+    if (match({TokenType::Return})) return returnStatement();
+    if (match({TokenType::Break})) { consume(TokenType::Semicolon, "Expect ';' after break."); return arena.make<BreakStmt>(); }
+    if (match({TokenType::Continue})) { consume(TokenType::Semicolon, "Expect ';' after continue."); return arena.make<ContinueStmt>(); }
+    if (check(TokenType::LeftBrace)) return block();
     return exprStmt();
 }
 
-std::unique_ptr<Stmt> Parser::ifStatement() {
+Stmt* Parser::ifStatement() {
     consume(TokenType::LeftParen, "Expect '(' after 'if'.");
-    std::unique_ptr<Expr> condition = expression();
+    Expr* condition = expression();
     consume(TokenType::RightParen, "Expect ')' after if condition.");
-    std::unique_ptr<Stmt> thenBranch = statement();
-    std::unique_ptr<Stmt> elseBranch = nullptr;
-    if (matchKeyword("else")) {
+    Stmt* thenBranch = statement();
+    Stmt* elseBranch = nullptr;
+    if (match({TokenType::Else})) {
         elseBranch = statement();
     }
-    return std::make_unique<IfStmt>(std::move(condition), std::move(thenBranch), std::move(elseBranch));
+    return arena.make<IfStmt>(condition, thenBranch, elseBranch);
 }
 
-std::unique_ptr<Stmt> Parser::whileStatement() {
+Stmt* Parser::whileStatement() {
     consume(TokenType::LeftParen, "Expect '(' after 'while'.");
-    std::unique_ptr<Expr> condition = expression();
+    Expr* condition = expression();
     consume(TokenType::RightParen, "Expect ')' after while condition.");
-    std::unique_ptr<Stmt> body = statement();
-    return std::make_unique<WhileStmt>(std::move(condition), std::move(body));
+    Stmt* body = statement();
+    return arena.make<WhileStmt>(condition, body);
 }
 
-std::unique_ptr<Stmt> Parser::forStatement() {
+Stmt* Parser::forStatement() {
     consume(TokenType::LeftParen, "Expect '(' after 'for'.");
 
-    std::unique_ptr<Stmt> initializer;
+    Stmt* initializer = nullptr;
     if (match({TokenType::Semicolon})) {
         initializer = nullptr;
-    } else if (matchKeyword("var")) {
+    } else if (match({TokenType::Var})) {
         initializer = varDecl();
     } else {
         initializer = exprStmt();
     }
 
-    std::unique_ptr<Expr> condition;
+    Expr* condition = nullptr;
     if (!check(TokenType::Semicolon)) {
         condition = expression();
     }
     consume(TokenType::Semicolon, "Expect ';' after loop condition.");
 
-    std::unique_ptr<Expr> increment;
+    Expr* increment = nullptr;
     if (!check(TokenType::RightParen)) {
         increment = expression();
     }
     consume(TokenType::RightParen, "Expect ')' after for clauses.");
 
-    std::unique_ptr<Stmt> body = statement();
+    Stmt* body = statement();
 
     if (increment) {
-        std::vector<std::unique_ptr<Stmt>> stmts;
-        stmts.push_back(std::move(body));
-        stmts.push_back(std::make_unique<ExpressionStmt>(std::move(increment)));
-        body = std::make_unique<Block>(std::move(stmts));
+        Stmt* stmts[] = {body, arena.make<ExpressionStmt>(increment)};
+        body = arena.make<Block>(arena.list<Stmt>(stmts, 2));
     }
 
     if (!condition) {
-        condition = std::make_unique<Literal>("true");
+        condition = makeLiteral(arena, "true");
     }
-    body = std::make_unique<WhileStmt>(std::move(condition), std::move(body));
+    body = arena.make<WhileStmt>(condition, body);
 
     if (initializer) {
-        std::vector<std::unique_ptr<Stmt>> stmts;
-        stmts.push_back(std::move(initializer));
-        stmts.push_back(std::move(body));
-        body = std::make_unique<Block>(std::move(stmts));
+        Stmt* stmts[] = {initializer, body};
+        body = arena.make<Block>(arena.list<Stmt>(stmts, 2));
     }
 
     return body;
 }
 
-std::unique_ptr<Stmt> Parser::returnStatement() {
-    std::unique_ptr<Expr> value = nullptr;
+Stmt* Parser::returnStatement() {
+    Expr* value = nullptr;
     if (!check(TokenType::Semicolon)) {
         value = expression();
     }
     consume(TokenType::Semicolon, "Expect ';' after return value.");
-    return std::make_unique<ReturnStmt>(std::move(value));
+    return arena.make<ReturnStmt>(value);
 }
 
-std::unique_ptr<Block> Parser::block() {
+Block* Parser::block() {
     consume(TokenType::LeftBrace, "Expect '{' to begin block.");
-    std::vector<std::unique_ptr<Stmt>> statements;
+    size_t start = scratch.size();
     while (!check(TokenType::RightBrace) && !isAtEnd()) {
-        statements.push_back(declaration());
+        scratch.push_back(declaration());
     }
     consume(TokenType::RightBrace, "Expect '}' after block.");
-    return std::make_unique<Block>(std::move(statements));
+    return arena.make<Block>(takeList<Stmt>(start));
 }
 
-std::unique_ptr<Stmt> Parser::exprStmt() {
-    std::unique_ptr<Expr> expr = expression();
+Stmt* Parser::exprStmt() {
+    Expr* expr = expression();
     consume(TokenType::Semicolon, "Expect ';' after expression.");
-    return std::make_unique<ExpressionStmt>(std::move(expr));
+    return arena.make<ExpressionStmt>(expr);
 }
 
-std::unique_ptr<Expr> Parser::expression() {
+Expr* Parser::expression() {
     return assignment();
 }
 
-std::unique_ptr<Expr> Parser::assignment() {
-    std::unique_ptr<Expr> expr = logicOr();
+Expr* Parser::assignment() {
+    Expr* expr = logicOr();
 
     if (match({TokenType::Equal})) {
-        Token equals = previous();
-        std::unique_ptr<Expr> value = assignment();
+        const Token& equals = previous();
+        Expr* value = assignment();
 
         if (expr->getKind() == ExprKind::VarExpr) {
-            std::string name = static_cast<VarExpr*>(expr.get())->name;
-            return std::make_unique<AssignExpr>(name, std::move(value));
+            return arena.make<AssignExpr>(static_cast<VarExpr*>(expr)->name, value);
         }
         if (expr->getKind() == ExprKind::Index) {
-            auto* ix = static_cast<IndexExpr*>(expr.get());
-            std::unique_ptr<Expr> obj = std::move(ix->object);
-            std::unique_ptr<Expr> idx = std::move(ix->index);
-            return std::make_unique<SetIndexExpr>(std::move(obj), std::move(idx), std::move(value));
+            auto* ix = static_cast<IndexExpr*>(expr);
+            return arena.make<SetIndexExpr>(ix->object, ix->index, value);
         }
         if (expr->getKind() == ExprKind::Get) {
-            auto* gx = static_cast<GetExpr*>(expr.get());
-            std::unique_ptr<Expr> obj = std::move(gx->object);
-            std::string name = gx->name;
-            return std::make_unique<SetExpr>(std::move(obj), name, std::move(value));
+            auto* gx = static_cast<GetExpr*>(expr);
+            return arena.make<SetExpr>(gx->object, gx->name, value);
         }
 
         error(equals, "Invalid assignment target.");
@@ -212,92 +225,103 @@ std::unique_ptr<Expr> Parser::assignment() {
     return expr;
 }
 
-std::unique_ptr<Expr> Parser::logicOr() {
-    std::unique_ptr<Expr> expr = logicAnd();
-    while (matchKeyword("or")) {
-        Token op = previous();
-        std::unique_ptr<Expr> right = logicAnd();
-        expr = std::make_unique<Binary>(std::move(expr), (int)op.type, op.text, std::move(right));
+Expr* Parser::binary(Expr* left, const Token& op, Expr* right) {
+    return arena.make<Binary>(left, (int)op.type, internName(op.text), right);
+}
+
+Expr* Parser::concat(std::vector<Expr*>& parts) {
+    Expr* expr = arena.make<ConcatExpr>(arena.list<Expr>(parts.data(), parts.size()));
+    parts.clear();
+    return expr;
+}
+
+Expr* Parser::logicOr() {
+    Expr* expr = logicAnd();
+    while (match({TokenType::Or})) {
+        const Token& op = previous();
+        expr = binary(expr, op, logicAnd());
     }
     return expr;
 }
 
-std::unique_ptr<Expr> Parser::logicAnd() {
-    std::unique_ptr<Expr> expr = equality();
-    while (matchKeyword("and")) {
-        Token op = previous();
-        std::unique_ptr<Expr> right = equality();
-        expr = std::make_unique<Binary>(std::move(expr), (int)op.type, op.text, std::move(right));
+Expr* Parser::logicAnd() {
+    Expr* expr = equality();
+    while (match({TokenType::And})) {
+        const Token& op = previous();
+        expr = binary(expr, op, equality());
     }
     return expr;
 }
 
-std::unique_ptr<Expr> Parser::equality() {
-    std::unique_ptr<Expr> expr = comparison();
+Expr* Parser::equality() {
+    Expr* expr = comparison();
     while (match({TokenType::BangEqual, TokenType::EqualEqual})) {
-        Token op = previous();
-        std::unique_ptr<Expr> right = comparison();
-        expr = std::make_unique<Binary>(std::move(expr), (int)op.type, op.text, std::move(right));
+        const Token& op = previous();
+        expr = binary(expr, op, comparison());
     }
     return expr;
 }
 
-std::unique_ptr<Expr> Parser::comparison() {
-    std::unique_ptr<Expr> expr = term();
+Expr* Parser::comparison() {
+    Expr* expr = term();
     while (match({TokenType::Greater, TokenType::GreaterEqual, TokenType::Less, TokenType::LessEqual})) {
-        Token op = previous();
-        std::unique_ptr<Expr> right = term();
-        expr = std::make_unique<Binary>(std::move(expr), (int)op.type, op.text, std::move(right));
+        const Token& op = previous();
+        expr = binary(expr, op, term());
     }
     return expr;
 }
 
-std::unique_ptr<Expr> Parser::term() {
-    std::unique_ptr<Expr> expr = factor();
+Expr* Parser::term() {
+    auto isText = [](const Expr* e) {
+        return e->getKind() == ExprKind::Literal && static_cast<const Literal*>(e)->type == LiteralType::String;
+    };
+    Expr* expr = factor();
+    std::vector<Expr*> parts; // open concatenation chain
     while (match({TokenType::Minus, TokenType::Plus})) {
-        Token op = previous();
-        std::unique_ptr<Expr> right = factor();
-        expr = std::make_unique<Binary>(std::move(expr), (int)op.type, op.text, std::move(right));
+        const Token& op = previous();
+        Expr* right = factor();
+        if (op.type == TokenType::Plus && (!parts.empty() || isText(expr) || isText(right))) {
+            if (parts.empty()) parts.push_back(expr);
+            parts.push_back(right);
+            continue;
+        }
+        if (!parts.empty()) expr = concat(parts);
+        expr = binary(expr, op, right);
     }
+    if (!parts.empty()) expr = concat(parts);
     return expr;
 }
 
-std::unique_ptr<Expr> Parser::factor() {
-    std::unique_ptr<Expr> expr = unary();
+Expr* Parser::factor() {
+    Expr* expr = unary();
     while (match({TokenType::Slash, TokenType::Star, TokenType::Percent})) {
-        Token op = previous();
-        std::unique_ptr<Expr> right = unary();
-        expr = std::make_unique<Binary>(std::move(expr), (int)op.type, op.text, std::move(right));
+        const Token& op = previous();
+        expr = binary(expr, op, unary());
     }
     return expr;
 }
 
-std::unique_ptr<Expr> Parser::unary() {
-    if (match({TokenType::Bang})) {
-        Token op = previous();
-        std::unique_ptr<Expr> right = unary();
-        return std::make_unique<Unary>((int)op.type, op.text, std::move(right));
-    }
-    if (match({TokenType::Minus})) { 
-        Token op = previous();
-        std::unique_ptr<Expr> right = unary();
-        return std::make_unique<Unary>((int)op.type, op.text, std::move(right));
+Expr* Parser::unary() {
+    if (match({TokenType::Bang, TokenType::Minus})) {
+        const Token& op = previous();
+        Expr* right = unary();
+        return arena.make<Unary>((int)op.type, internName(op.text), right);
     }
     return call();
 }
 
-std::unique_ptr<Expr> Parser::call() {
-    std::unique_ptr<Expr> expr = primary();
+Expr* Parser::call() {
+    Expr* expr = primary();
     while (true) {
         if (match({TokenType::LeftParen})) {
-            expr = finishCall(std::move(expr));
+            expr = finishCall(expr);
         } else if (match({TokenType::LeftBracket})) {
-            std::unique_ptr<Expr> index = expression();
+            Expr* index = expression();
             consume(TokenType::RightBracket, "Expect ']' after index.");
-            expr = std::make_unique<IndexExpr>(std::move(expr), std::move(index));
+            expr = arena.make<IndexExpr>(expr, index);
         } else if (match({TokenType::Dot})) {
-            Token name = consume(TokenType::Identifier, "Expect property name after '.'.");
-            expr = std::make_unique<GetExpr>(std::move(expr), name.text);
+            const Token& name = consumeName("Expect property name after '.'.");
+            expr = arena.make<GetExpr>(expr, internName(name.text));
         } else {
             break;
         }
@@ -305,46 +329,45 @@ std::unique_ptr<Expr> Parser::call() {
     return expr;
 }
 
-std::unique_ptr<Expr> Parser::finishCall(std::unique_ptr<Expr> callee) {
-    std::vector<std::unique_ptr<Expr>> arguments;
+Expr* Parser::finishCall(Expr* callee) {
+    size_t start = scratch.size();
     if (!check(TokenType::RightParen)) {
         do {
-            arguments.push_back(expression());
+            scratch.push_back(expression());
         } while (match({TokenType::Comma}));
     }
     consume(TokenType::RightParen, "Expect ')' after arguments.");
-    return std::make_unique<Call>(std::move(callee), std::move(arguments));
+    return arena.make<Call>(callee, takeList<Expr>(start));
 }
 
-std::unique_ptr<Expr> Parser::primary() {
-    if (match({TokenType::False})) return std::make_unique<Literal>("false");
-    if (match({TokenType::True})) return std::make_unique<Literal>("true");
-    if (match({TokenType::Nil})) return std::make_unique<Literal>("nil");
+Expr* Parser::primary() {
+    if (match({TokenType::False})) return makeLiteral(arena, "false");
+    if (match({TokenType::True})) return makeLiteral(arena, "true");
+    if (match({TokenType::Nil})) return makeLiteral(arena, "nil");
     if (match({TokenType::LeftBracket})) return arrayLiteral();
     if (match({TokenType::LeftBrace})) return mapLiteral();
-    if (matchKeyword("fn")) {
+    if (match({TokenType::Fn})) {
         consume(TokenType::LeftParen, "Expect '(' after 'fn'.");
-        std::vector<std::string> parameters;
-        if (!check(TokenType::RightParen)) {
-            do {
-                parameters.push_back(consume(TokenType::Identifier, "Expect parameter name.").text);
-            } while (match({TokenType::Comma}));
-        }
-        consume(TokenType::RightParen, "Expect ')' after parameters.");
-        std::unique_ptr<Block> body = block();
-        return std::make_unique<FunctionExpr>(std::move(parameters), std::move(body));
+        ParamList parameters = parameterList();
+        Block* body = block();
+        return arena.make<FunctionExpr>(parameters, body);
+    }
+
+    if (match({TokenType::Number})) {
+        return makeLiteral(arena, previous().text);
     }
-    
-    if (match({TokenType::Number, TokenType::String})) {
-        return std::make_unique<Literal>(previous().text);
+    if (match({TokenType::String})) {
+        const Token& tok = previous();
+        if (tok.text.find('\\') == std::string_view::npos) return makeLiteral(arena, tok.text);
+        return makeLiteral(arena, unescapeString(tok.text));
     }
 
     if (match({TokenType::Identifier})) {
-        return std::make_unique<VarExpr>(previous().text);
+        return arena.make<VarExpr>(internName(previous().text));
     }
 
     if (match({TokenType::LeftParen})) {
-        std::unique_ptr<Expr> expr = expression();
+        Expr* expr = expression();
         consume(TokenType::RightParen, "Expect ')' after expression.");
         return expr;
     }
@@ -353,34 +376,32 @@ std::unique_ptr<Expr> Parser::primary() {
     throw std::runtime_error("Expect expression.");
 }
 
-std::unique_ptr<Expr> Parser::arrayLiteral() {
-    std::vector<std::unique_ptr<Expr>> elements;
+Expr* Parser::arrayLiteral() {
+    size_t start = scratch.size();
     if (!check(TokenType::RightBracket)) {
         do {
-            elements.push_back(expression());
+            scratch.push_back(expression());
         } while (match({TokenType::Comma}));
     }
     consume(TokenType::RightBracket, "Expect ']' after array literal.");
-    auto arr = std::make_unique<Call>(std::make_unique<VarExpr>("array"), std::move(elements));
-    return arr;
+    return arena.make<Call>(arena.make<VarExpr>(internName("array")), takeList<Expr>(start));
 }
 
-std::unique_ptr<Expr> Parser::mapLiteral() {
-    std::vector<std::unique_ptr<Expr>> args;
+Expr* Parser::mapLiteral() {
+    size_t start = scratch.size();
     if (!check(TokenType::RightBrace)) {
         do {
-            Token key = consume(TokenType::Identifier, "Expect identifier key in map literal.");
+            const Token& key = consumeName("Expect identifier key in map literal.");
             consume(TokenType::Colon, "Expect ':' after key in map literal.");
-            args.push_back(std::make_unique<Literal>(key.text));
-            args.push_back(expression());
+            scratch.push_back(makeLiteral(arena, key.text));
+            scratch.push_back(expression());
         } while (match({TokenType::Comma}));
     }
     consume(TokenType::RightBrace, "Expect '}' after map literal.");
-    auto m = std::make_unique<Call>(std::make_unique<VarExpr>("map"), std::move(args));
-    return m;
+    return arena.make<Call>(arena.make<VarExpr>(internName("map")), takeList<Expr>(start));
 }
 
-bool Parser::match(const std::vector<TokenType>& types) {
+bool Parser::match(std::initializer_list<TokenType> types) {
     for (TokenType type : types) {
         if (check(type)) {
             advance();
@@ -390,50 +411,44 @@ bool Parser::match(const std::vector<TokenType>& types) {
     return false;
 }
 
-bool Parser::matchKeyword(const std::string& keyword) {
-    if (checkKeyword(keyword)) {
-        advance();
-        return true;
-    }
-    return false;
-}
-
-bool Parser::check(TokenType type) {
+bool Parser::check(TokenType type) const {
     if (isAtEnd()) return false;
     return peek().type == type;
 }
 
-bool Parser::checkKeyword(const std::string& keyword) {
-    if (isAtEnd()) return false;
-    return peek().type == TokenType::Identifier && peek().text == keyword;
-}
-
-Token Parser::advance() {
+const Token& Parser::advance() {
     if (!isAtEnd()) current++;
     return previous();
 }
 
-bool Parser::isAtEnd() {
+bool Parser::isAtEnd() const {
     return peek().type == TokenType::Eof;
 }
 
-Token Parser::peek() {
+const Token& Parser::peek() const {
     return tokens[current];
 }
 
-Token Parser::previous() {
+const Token& Parser::previous() const {
     return tokens[current - 1];
 }
 
-Token Parser::consume(TokenType type, const std::string& message) {
+const Token& Parser::consume(TokenType type, const std::string& message) {
     if (check(type)) return advance();
     error(peek(), message);
     throw std::runtime_error(message);
 }
 
-void Parser::error(Token token, const std::string& message) {
+// Property names and map keys may be keywords (`{do: 1}`, `obj.for`).
+const Token& Parser::consumeName(const std::string& message) {
+    if (check(TokenType::Identifier) || (!isAtEnd() && isKeywordName(peek().type))) return advance();
+    error(peek(), message);
+    throw std::runtime_error(message);
+}
+
+void Parser::error(const Token& token, const std::string& message) {
     std::string loc = "line " + std::to_string(token.line) + ", col " + std::to_string(token.column);
-    std::string msg = "[Parser] " + loc + " at '" + token.text + "': " + message;
+    std::string msg = "[Parser] " + loc + " at '" + std::string(token.text) + "': " + message;
     errors.push_back(msg);
     std::cerr << msg << std::endl;
 }
@@ -442,9 +457,13 @@ void Parser::synchronize() {
     advance();
     while (!isAtEnd()) {
         if (previous().type == TokenType::Semicolon) return;
-        if (peek().type == TokenType::Identifier) {
-            const std::string& t = peek().text;
-            if (t == "fn" || t == "var" || t == "if" || t == "while" || t == "for" || t == "do" || t == "return" || t == "break" || t == "continue") return;
+        switch (peek().type) {
+            case TokenType::Fn: case TokenType::Var: case TokenType::If: case TokenType::While:
+            case TokenType::For: case TokenType::Do: case TokenType::Return: case TokenType::Break:
+            case TokenType::Continue:
+                return;
+            default:
+                break;
         }
         advance();
     }
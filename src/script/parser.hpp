@@ -1,5 +1,6 @@
 #pragma once
 
+#include <initializer_list>
 #include <vector>
 #include <memory>
 #include <string>
@@ -11,7 +12,8 @@ namespace yuki {
 class Parser {
 public:
     Parser(const std::vector<Token>& tokens);
-    std::vector<std::unique_ptr<Stmt>> parse();
+    // Builds the module's nodes in a fresh arena sized from the token count.
+    ScriptModule parse();
     bool hadError() const { return !errors.empty(); }
     const std::vector<std::string>& getErrors() const { return errors; }
 
@@ -19,43 +21,52 @@ private:
     const std::vector<Token>& tokens;
     int current = 0;
     std::vector<std::string> errors;
+    AstArena arena;
+    // Child lists are gathered here (stack-like, nested lists push above their
+    // parent's entries) and then copied into the arena in one piece.
+    std::vector<const void*> scratch;
 
-    std::unique_ptr<Stmt> declaration();
-    std::unique_ptr<Stmt> funDecl();
-    std::unique_ptr<Stmt> varDecl();
-    std::unique_ptr<Stmt> statement();
-    std::unique_ptr<Stmt> ifStatement();
-    std::unique_ptr<Stmt> whileStatement();
-    std::unique_ptr<Stmt> forStatement();
-    std::unique_ptr<Stmt> returnStatement();
-    std::unique_ptr<Stmt> exprStmt();
-    std::unique_ptr<Block> block();
-
-    std::unique_ptr<Expr> expression();
-    std::unique_ptr<Expr> assignment();
-    std::unique_ptr<Expr> logicOr();
-    std::unique_ptr<Expr> logicAnd();
-    std::unique_ptr<Expr> equality();
-    std::unique_ptr<Expr> comparison();
-    std::unique_ptr<Expr> term();
-    std::unique_ptr<Expr> factor();
-    std::unique_ptr<Expr> unary();
-    std::unique_ptr<Expr> call();
-    std::unique_ptr<Expr> finishCall(std::unique_ptr<Expr> callee);
-    std::unique_ptr<Expr> primary();
-    std::unique_ptr<Expr> arrayLiteral();
-    std::unique_ptr<Expr> mapLiteral();
-
-    bool match(const std::vector<TokenType>& types);
-    bool matchKeyword(const std::string& keyword);
-    bool check(TokenType type);
-    bool checkKeyword(const std::string& keyword);
-    Token advance();
-    bool isAtEnd();
-    Token peek();
-    Token previous();
-    Token consume(TokenType type, const std::string& message);
-    void error(Token token, const std::string& message);
+    Stmt* declaration();
+    Stmt* funDecl();
+    Stmt* varDecl();
+    Stmt* statement();
+    Stmt* ifStatement();
+    Stmt* whileStatement();
+    Stmt* forStatement();
+    Stmt* returnStatement();
+    Stmt* exprStmt();
+    Block* block();
+
+    Expr* expression();
+    Expr* assignment();
+    Expr* logicOr();
+    Expr* logicAnd();
+    Expr* equality();
+    Expr* comparison();
+    Expr* term();
+    Expr* factor();
+    Expr* unary();
+    Expr* call();
+    Expr* finishCall(Expr* callee);
+    Expr* primary();
+    Expr* arrayLiteral();
+    Expr* mapLiteral();
+    ParamList parameterList();
+
+    template <class T>
+    NodeList<T> takeList(size_t start);
+    Expr* binary(Expr* left, const Token& op, Expr* right);
+    Expr* concat(std::vector<Expr*>& parts);
+
+    bool match(std::initializer_list<TokenType> types);
+    bool check(TokenType type) const;
+    const Token& advance();
+    bool isAtEnd() const;
+    const Token& peek() const;
+    const Token& previous() const;
+    const Token& consume(TokenType type, const std::string& message);
+    const Token& consumeName(const std::string& message);
+    void error(const Token& token, const std::string& message);
     void synchronize();
 };
 
@@ -0,0 +1,142 @@
+#include "script_profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+
+namespace yuki {
+
+ScriptProfiler::Scope::Scope(ScriptProfiler& p, const void* key, const std::string& name) {
+    if (!p.running) return;
+    p.enter(key, name);
+    profiler = &p;
+}
+
+ScriptProfiler::Scope::~Scope() {
+    if (profiler) profiler->leave();
+}
+
+void ScriptProfiler::start() {
+    nodes.clear();
+    stack.clear();
+    nodes.push_back(Node{});
+    running = true;
+    startedAt = Clock::now();
+}
+
+void ScriptProfiler::stop() {
+    if (!running) return;
+    running = false;
+    stoppedAt = Clock::now();
+    // Calls still open (stop() from inside a script) keep the time so far.
+    while (!stack.empty()) leave();
+}
+
+double ScriptProfiler::recordedMs() const {
+    if (nodes.empty()) return 0.0;
+    Clock::time_point end = running ? Clock::now() : stoppedAt;
+    return std::chrono::duration<double, std::milli>(end - startedAt).count();
+}
+
+int ScriptProfiler::childOf(int parent, const void* key, const std::string& name) {
+    for (int c = nodes[(size_t)parent].firstChild; c >= 0; c = nodes[(size_t)c].nextSibling) {
+        if (nodes[(size_t)c].key == key && nodes[(size_t)c].name == name) return c;
+    }
+    Node node;
+    node.key = key;
+    node.name = name;
+    node.parent = parent;
+    node.nextSibling = nodes[(size_t)parent].firstChild;
+    int index = (int)nodes.size();
+    nodes.push_back(std::move(node));
+    nodes[(size_t)parent].firstChild = index;
+    return index;
+}
+
+void ScriptProfiler::enter(const void* key, const std::string& name) {
+    int parent = stack.empty() ? 0 : stack.back().node;
+    int node = childOf(parent, key, name);
+    nodes[(size_t)node].calls++;
+    stack.push_back(Frame{node, Clock::now()});
+}
+
+void ScriptProfiler::leave() {
+    if (stack.empty()) return;
+    Frame frame = stack.back();
+    stack.pop_back();
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - frame.start).count();
+    Node& node = nodes[(size_t)frame.node];
+    node.totalNs += ns;
+    if (node.parent > 0) nodes[(size_t)node.parent].childNs += ns;
+}
+
+std::vector<ScriptProfiler::FunctionStats> ScriptProfiler::functionStats() const {
+    std::vector<FunctionStats> out;
+    std::unordered_map<std::string, size_t> index;
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        const Node& node = nodes[i];
+        auto it = index.find(node.name);
+        if (it == index.end()) {
+            it = index.emplace(node.name, out.size()).first;
+            out.push_back(FunctionStats{node.name});
+        }
+        FunctionStats& stats = out[it->second];
+        stats.calls += node.calls;
+        stats.selfMs += (double)(node.totalNs - node.childNs) / 1e6;
+        // Only the outermost activation counts towards inclusive time.
+        bool nested = false;
+        for (int p = node.parent; p > 0 && !nested; p = nodes[(size_t)p].parent) {
+            nested = nodes[(size_t)p].name == node.name;
+        }
+        if (!nested) stats.totalMs += (double)node.totalNs / 1e6;
+    }
+    std::sort(out.begin(), out.end(), [](const FunctionStats& a, const FunctionStats& b) { return a.selfMs > b.selfMs; });
+    return out;
+}
+
+std::vector<std::string> ScriptProfiler::report(size_t top) const {
+    std::vector<std::string> lines;
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "script profile: %.1f ms recorded%s", recordedMs(), running ? " (running)" : "");
+    lines.push_back(buf);
+    lines.push_back("   self ms   total ms     calls  function");
+    std::vector<FunctionStats> stats = functionStats();
+    for (size_t i = 0; i < stats.size() && i < top; ++i) {
+        std::snprintf(buf, sizeof(buf), "%10.2f %10.2f %9llu  %s", stats[i].selfMs, stats[i].totalMs,
+                      (unsigned long long)stats[i].calls, stats[i].name.c_str());
+        lines.push_back(buf);
+    }
+    return lines;
+}
+
+bool ScriptProfiler::writeCollapsed(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    auto frameName = [](std::string name) {
+        std::replace(name.begin(), name.end(), ';', ':');
+        std::replace(name.begin(), name.end(), ' ', '_');
+        return name.empty() ? std::string("<anon>") : name;
+    };
+    std::vector<int> chain;
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        const Node& node = nodes[i];
+        long long us = (long long)((node.totalNs - node.childNs) / 1000);
+        if (us <= 0) continue;
+        chain.clear();
+        for (int p = (int)i; p > 0; p = nodes[(size_t)p].parent) chain.push_back(p);
+        std::string line;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            if (!line.empty()) line += ';';
+            line += frameName(nodes[(size_t)*it].name);
+        }
+        out << line << ' ' << us << '\n';
+    }
+    return (bool)out;
+}
+
+ScriptProfiler& scriptProfiler() {
+    static ScriptProfiler profiler;
+    return profiler;
+}
+
+} // namespace yuki
@@ -0,0 +1,74 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yuki {
+
+// Instrumenting profiler for script calls. While running, every call made
+// through Interpreter::callFunction (script functions and builtins) is
+// recorded in a call tree with call counts and inclusive/self time. Results
+// can be listed per function or exported as collapsed stacks ("a;b;c <us>"),
+// the input format of flamegraph.pl and speedscope.
+class ScriptProfiler {
+public:
+    struct FunctionStats {
+        std::string name;
+        uint64_t calls = 0;
+        double selfMs = 0.0;
+        double totalMs = 0.0; // recursion counted once
+    };
+
+    // RAII call marker; a no-op unless the profiler is running.
+    class Scope {
+    public:
+        Scope(ScriptProfiler& profiler, const void* key, const std::string& name);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        ScriptProfiler* profiler = nullptr;
+    };
+
+    // Starting discards the previous profile.
+    void start();
+    void stop();
+    bool active() const { return running; }
+    double recordedMs() const;
+
+    std::vector<FunctionStats> functionStats() const; // by self time, descending
+    std::vector<std::string> report(size_t top) const;
+    bool writeCollapsed(const std::string& path) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Node {
+        const void* key = nullptr; // function body or native fn; name breaks ties
+        std::string name;
+        int parent = -1;
+        int firstChild = -1;
+        int nextSibling = -1;
+        uint64_t calls = 0;
+        int64_t totalNs = 0;
+        int64_t childNs = 0;
+    };
+    struct Frame {
+        int node;
+        Clock::time_point start;
+    };
+
+    void enter(const void* key, const std::string& name);
+    void leave();
+    int childOf(int parent, const void* key, const std::string& name);
+
+    bool running = false;
+    std::vector<Node> nodes; // nodes[0] is the root; parents precede children
+    std::vector<Frame> stack;
+    Clock::time_point startedAt;
+    Clock::time_point stoppedAt;
+};
+
+ScriptProfiler& scriptProfiler();
+
+} // namespace yuki
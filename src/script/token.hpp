@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 namespace yuki {
 enum class TokenType {
@@ -12,22 +13,34 @@ enum class TokenType {
     Plus, Minus, Star, Slash, Percent, Equal, Bang,
     EqualEqual, BangEqual, Less, LessEqual, Greater, GreaterEqual,
     True, False,
+    // Keywords; Fn..Or are contextual and still usable as property names/map keys.
+    Fn, Var, If, Else, While, For, Do, Return, Break, Continue, And, Or,
     Eof
 };
+inline bool isKeywordName(TokenType type) { return type >= TokenType::Fn && type <= TokenType::Or; }
+
+// Token text is a view into the source given to the Tokenizer, which must
+// outlive the tokens. String tokens hold the raw text between the quotes;
+// use unescapeString() to get the value.
 struct Token {
     TokenType type;
-    std::string text;
+    std::string_view text;
     int line = 1;
     int column = 1;
 };
+
+// Keyword type for `text`, or Identifier.
+TokenType keywordType(std::string_view text);
+std::string unescapeString(std::string_view raw);
+
 class Tokenizer {
 public:
-    Tokenizer(const std::string& source);
+    Tokenizer(std::string_view source);
     std::vector<Token> scanTokens();
     bool hadError() const { return !errors.empty(); }
     const std::vector<std::string>& getErrors() const { return errors; }
 private:
-    std::string source;
+    std::string_view source;
     std::vector<std::string> errors;
 };
 }
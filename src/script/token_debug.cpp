@@ -7,6 +7,9 @@ std::string tokenTypeToString(TokenType type) {
         case TokenType::Identifier: return "Identifier";
         case TokenType::Number: return "Number";
         case TokenType::String: return "String";
+        case TokenType::Nil: return "Nil";
+        case TokenType::LeftBracket: return "LeftBracket";
+        case TokenType::RightBracket: return "RightBracket";
         case TokenType::LeftParen: return "LeftParen";
         case TokenType::RightParen: return "RightParen";
         case TokenType::LeftBrace: return "LeftBrace";
@@ -19,6 +22,7 @@ std::string tokenTypeToString(TokenType type) {
         case TokenType::Minus: return "Minus";
         case TokenType::Star: return "Star";
         case TokenType::Slash: return "Slash";
+        case TokenType::Percent: return "Percent";
         case TokenType::Equal: return "Equal";
         case TokenType::Bang: return "Bang";
         case TokenType::EqualEqual: return "EqualEqual";
@@ -29,6 +33,18 @@ std::string tokenTypeToString(TokenType type) {
         case TokenType::GreaterEqual: return "GreaterEqual";
         case TokenType::True: return "True";
         case TokenType::False: return "False";
+        case TokenType::Fn: return "Fn";
+        case TokenType::Var: return "Var";
+        case TokenType::If: return "If";
+        case TokenType::Else: return "Else";
+        case TokenType::While: return "While";
+        case TokenType::For: return "For";
+        case TokenType::Do: return "Do";
+        case TokenType::Return: return "Return";
+        case TokenType::Break: return "Break";
+        case TokenType::Continue: return "Continue";
+        case TokenType::And: return "And";
+        case TokenType::Or: return "Or";
         case TokenType::Eof: return "Eof";
         default: return "Unknown";
     }
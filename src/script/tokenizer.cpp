@@ -1,9 +1,59 @@
 #include "token.hpp"
+#include <array>
 #include <cctype>
 namespace yuki {
-Tokenizer::Tokenizer(const std::string& source) : source(source) {}
+namespace {
+struct Keyword {
+    std::string_view text;
+    TokenType type = TokenType::Identifier;
+};
+
+// Perfect hash over the keyword set: (first char * 3 + length) & 31 is
+// collision-free, so a lookup is one table read plus one compare.
+constexpr size_t keywordSlot(char first, size_t length) { return ((size_t)(unsigned char)first * 3 + length) & 31; }
+
+constexpr std::array<Keyword, 32> buildKeywordTable() {
+    constexpr Keyword keywords[] = {
+        {"true", TokenType::True}, {"false", TokenType::False}, {"nil", TokenType::Nil},
+        {"fn", TokenType::Fn}, {"var", TokenType::Var}, {"if", TokenType::If},
+        {"else", TokenType::Else}, {"while", TokenType::While}, {"for", TokenType::For},
+        {"do", TokenType::Do}, {"return", TokenType::Return}, {"break", TokenType::Break},
+        {"continue", TokenType::Continue}, {"and", TokenType::And}, {"or", TokenType::Or},
+    };
+    std::array<Keyword, 32> table{};
+    for (const Keyword& k : keywords) table[keywordSlot(k.text[0], k.text.size())] = k;
+    return table;
+}
+constexpr std::array<Keyword, 32> kKeywordTable = buildKeywordTable();
+} // namespace
+
+TokenType keywordType(std::string_view text) {
+    if (text.size() < 2 || text.size() > 8) return TokenType::Identifier;
+    const Keyword& k = kKeywordTable[keywordSlot(text[0], text.size())];
+    return k.text == text ? k.type : TokenType::Identifier;
+}
+
+std::string unescapeString(std::string_view raw) {
+    if (raw.find('\\') == std::string_view::npos) return std::string(raw);
+    std::string val;
+    val.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        if (raw[i] == '\\' && i + 1 < raw.size()) {
+            char esc = raw[i + 1];
+            if (esc == 'n') { val.push_back('\n'); ++i; continue; }
+            if (esc == 't') { val.push_back('\t'); ++i; continue; }
+            if (esc == '"') { val.push_back('\"'); ++i; continue; }
+            if (esc == '\\') { val.push_back('\\'); ++i; continue; }
+        }
+        val.push_back(raw[i]);
+    }
+    return val;
+}
+
+Tokenizer::Tokenizer(std::string_view source) : source(source) {}
 std::vector<Token> Tokenizer::scanTokens() {
     std::vector<Token> tokens;
+    tokens.reserve(source.size() / 4 + 1);
     errors.clear();
     size_t current = 0;
     int line = 1;
@@ -11,22 +61,38 @@ std::vector<Token> Tokenizer::scanTokens() {
     while (current < source.size()) {
         int startLine = line;
         int startCol = col;
+        size_t start = current;
         char c = source[current++];
         col++;
+        auto emit = [&](TokenType type) {
+            tokens.push_back({type, source.substr(start, current - start), startLine, startCol});
+        };
+        auto emitPair = [&](TokenType pair, TokenType single) {
+            if (current < source.size() && source[current] == '=') {
+                current++;
+                col++;
+                emit(pair);
+            } else {
+                emit(single);
+            }
+        };
         switch (c) {
             case ' ': case '\r': case '\t': break;
             case '\n': line++; col = 1; break;
-            case '(': tokens.push_back({TokenType::LeftParen, "(", startLine, startCol}); break;
-            case ')': tokens.push_back({TokenType::RightParen, ")", startLine, startCol}); break;
-            case '{': tokens.push_back({TokenType::LeftBrace, "{", startLine, startCol}); break;
-            case '}': tokens.push_back({TokenType::RightBrace, "}", startLine, startCol}); break;
-            case ',': tokens.push_back({TokenType::Comma, ",", startLine, startCol}); break;
-            case ':': tokens.push_back({TokenType::Colon, ":", startLine, startCol}); break;
-            case ';': tokens.push_back({TokenType::Semicolon, ";", startLine, startCol}); break;
-            case '.': tokens.push_back({TokenType::Dot, ".", startLine, startCol}); break;
-            case '+': tokens.push_back({TokenType::Plus, "+", startLine, startCol}); break;
-            case '-': tokens.push_back({TokenType::Minus, "-", startLine, startCol}); break;
-            case '*': tokens.push_back({TokenType::Star, "*", startLine, startCol}); break;
+            case '(': emit(TokenType::LeftParen); break;
+            case ')': emit(TokenType::RightParen); break;
+            case '{': emit(TokenType::LeftBrace); break;
+            case '}': emit(TokenType::RightBrace); break;
+            case '[': emit(TokenType::LeftBracket); break;
+            case ']': emit(TokenType::RightBracket); break;
+            case ',': emit(TokenType::Comma); break;
+            case ':': emit(TokenType::Colon); break;
+            case ';': emit(TokenType::Semicolon); break;
+            case '.': emit(TokenType::Dot); break;
+            case '+': emit(TokenType::Plus); break;
+            case '-': emit(TokenType::Minus); break;
+            case '*': emit(TokenType::Star); break;
+            case '%': emit(TokenType::Percent); break;
             case '/':
                 if (current < source.size() && source[current] == '/') {
                     // line comment, consume until newline
@@ -53,113 +119,67 @@ std::vector<Token> Tokenizer::scanTokens() {
                         errors.push_back("[Tokenizer] line " + std::to_string(startLine) + ", col " + std::to_string(startCol) + ": Unterminated block comment");
                     }
                 } else {
-                    tokens.push_back({TokenType::Slash, "/", startLine, startCol});
-                }
-                break;
-            case '%': tokens.push_back({TokenType::Percent, "%", startLine, startCol}); break;
-            case '=': 
-                if (current < source.size() && source[current] == '=') {
-                    current++;
-                    col++;
-                    tokens.push_back({TokenType::EqualEqual, "==", startLine, startCol});
-                } else {
-                    tokens.push_back({TokenType::Equal, "=", startLine, startCol});
-                }
-                break;
-            case '!':
-                if (current < source.size() && source[current] == '=') {
-                    current++;
-                    col++;
-                    tokens.push_back({TokenType::BangEqual, "!=", startLine, startCol});
-                } else {
-                    tokens.push_back({TokenType::Bang, "!", startLine, startCol});
-                }
-                break;
-            case '<':
-                if (current < source.size() && source[current] == '=') {
-                    current++;
-                    col++;
-                    tokens.push_back({TokenType::LessEqual, "<=", startLine, startCol});
-                } else {
-                    tokens.push_back({TokenType::Less, "<", startLine, startCol});
-                }
-                break;
-            case '>':
-                if (current < source.size() && source[current] == '=') {
-                    current++;
-                    col++;
-                    tokens.push_back({TokenType::GreaterEqual, ">=", startLine, startCol});
-                } else {
-                    tokens.push_back({TokenType::Greater, ">", startLine, startCol});
+                    emit(TokenType::Slash);
                 }
                 break;
+            case '=': emitPair(TokenType::EqualEqual, TokenType::Equal); break;
+            case '!': emitPair(TokenType::BangEqual, TokenType::Bang); break;
+            case '<': emitPair(TokenType::LessEqual, TokenType::Less); break;
+            case '>': emitPair(TokenType::GreaterEqual, TokenType::Greater); break;
             case '"': {
-                std::string val;
+                // Only find the end here; escapes are resolved by the parser.
+                size_t bodyStart = current;
                 while (current < source.size() && source[current] != '"') {
                     if (source[current] == '\n') { line++; col = 1; }
                     if (source[current] == '\\' && current + 1 < source.size()) {
                         char esc = source[current + 1];
-                        if (esc == 'n') { val.push_back('\n'); current += 2; col += 2; continue; }
-                        if (esc == 't') { val.push_back('\t'); current += 2; col += 2; continue; }
-                        if (esc == '"') { val.push_back('\"'); current += 2; col += 2; continue; }
-                        if (esc == '\\') { val.push_back('\\'); current += 2; col += 2; continue; }
+                        if (esc == 'n' || esc == 't' || esc == '"' || esc == '\\') {
+                            current += 2;
+                            col += 2;
+                            continue;
+                        }
                     }
-                    val += source[current++];
+                    current++;
                     col++;
                 }
+                std::string_view body = source.substr(bodyStart, current - bodyStart);
                 if (current >= source.size()) {
                     errors.push_back("[Tokenizer] line " + std::to_string(startLine) + ", col " + std::to_string(startCol) + ": Unterminated string");
-                    tokens.push_back({TokenType::String, val, startLine, startCol});
                 } else {
                     current++;
                     col++;
-                    tokens.push_back({TokenType::String, val, startLine, startCol});
                 }
+                tokens.push_back({TokenType::String, body, startLine, startCol});
                 break;
             }
-            case '[': tokens.push_back({TokenType::LeftBracket, "[", startLine, startCol}); break;
-            case ']': tokens.push_back({TokenType::RightBracket, "]", startLine, startCol}); break;
             default:
-                if (std::isdigit(c)) {
-                    std::string val;
-                    val += c;
-                    while (current < source.size() && std::isdigit(source[current])) {
-                        val += source[current++];
+                if (std::isdigit((unsigned char)c)) {
+                    while (current < source.size() && std::isdigit((unsigned char)source[current])) {
+                        current++;
                         col++;
                     }
                     if (current < source.size() && source[current] == '.') {
-                        val += source[current++];
+                        current++;
                         col++;
-                        while (current < source.size() && std::isdigit(source[current])) {
-                            val += source[current++];
+                        while (current < source.size() && std::isdigit((unsigned char)source[current])) {
+                            current++;
                             col++;
                         }
                     }
-                    tokens.push_back({TokenType::Number, val, startLine, startCol});
+                    emit(TokenType::Number);
                 } else if (std::isalpha((unsigned char)c) || c == '_') {
-                    std::string val;
-                    val += c;
                     while (current < source.size() && (std::isalnum((unsigned char)source[current]) || source[current] == '_')) {
-                        val += source[current++];
+                        current++;
                         col++;
                     }
-                    if (val == "true") tokens.push_back({TokenType::True, "true", startLine, startCol});
-                    else if (val == "false") tokens.push_back({TokenType::False, "false", startLine, startCol});
-                    else if (val == "nil") tokens.push_back({TokenType::Nil, "nil", startLine, startCol});
-                    else if (val == "fn") tokens.push_back({TokenType::Identifier, "fn", startLine, startCol});
-                    else if (val == "var") tokens.push_back({TokenType::Identifier, "var", startLine, startCol});
-                    else if (val == "if") tokens.push_back({TokenType::Identifier, "if", startLine, startCol});
-                    else if (val == "else") tokens.push_back({TokenType::Identifier, "else", startLine, startCol});
-                    else if (val == "while") tokens.push_back({TokenType::Identifier, "while", startLine, startCol});
-                    else if (val == "return") tokens.push_back({TokenType::Identifier, "return", startLine, startCol});
-                    else tokens.push_back({TokenType::Identifier, val, startLine, startCol});
+                    emit(keywordType(source.substr(start, current - start)));
                 } else {
                     errors.push_back("[Tokenizer] line " + std::to_string(startLine) + ", col " + std::to_string(startCol) + ": Unexpected character '" + std::string(1, c) + "'");
                 }
                 break;
         }
     }
-    tokens.push_back({TokenType::Eof, "", line, col});
+    tokens.push_back({TokenType::Eof, std::string_view(), line, col});
     return tokens;
 }
 }
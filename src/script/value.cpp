@@ -1,7 +1,25 @@
 #include "value.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
 
 namespace yuki {
 
+size_t formatNumber(double v, char* out) {
+    // -0 prints as 0.
+    if (v == 0.0) {
+        out[0] = '0';
+        return 1;
+    }
+    // Integral values (counters, pixel positions) skip the float path.
+    if (std::fabs(v) < 9007199254740992.0 && v == std::trunc(v)) {
+        return (size_t)(std::to_chars(out, out + kMaxNumberChars, (int64_t)v).ptr - out);
+    }
+    double a = std::fabs(v);
+    std::chars_format format = a >= 1e-6 && a < 1e21 ? std::chars_format::fixed : std::chars_format::scientific;
+    return (size_t)(std::to_chars(out, out + kMaxNumberChars, v, format).ptr - out);
+}
+
 Value::Value() 
     : type(ValueType::Nil), 
       numberVal(0.0), 
@@ -33,6 +51,13 @@ Value Value::string(const std::string& val) {
     return v;
 }
 
+Value Value::string(std::string&& val) {
+    Value v;
+    v.type = ValueType::String;
+    v.stringVal = std::move(val);
+    return v;
+}
+
 Value Value::function(FunctionValue* val) {
     Value v;
     v.type = ValueType::Function;
@@ -80,7 +105,10 @@ bool Value::isArray() const {
 
 std::string Value::toString() const {
     switch (type) {
-        case ValueType::Number:   return std::to_string(numberVal);
+        case ValueType::Number: {
+            char buf[kMaxNumberChars];
+            return std::string(buf, formatNumber(numberVal, buf));
+        }
         case ValueType::Bool:     return boolVal ? "true" : "false";
         case ValueType::String:   return stringVal;
         case ValueType::Function: return "<function " + (functionVal ? functionVal->name : "") + ">";
@@ -90,4 +118,15 @@ std::string Value::toString() const {
     }
 }
 
+void Value::appendTo(std::string& out) const {
+    if (type == ValueType::String) {
+        out += stringVal;
+    } else if (type == ValueType::Number) {
+        char buf[kMaxNumberChars];
+        out.append(buf, formatNumber(numberVal, buf));
+    } else {
+        out += toString();
+    }
+}
+
 }
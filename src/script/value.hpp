@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include "function_value.hpp"
@@ -9,6 +10,13 @@
 
 namespace yuki {
 
+// Number to text: the shortest digits that read back as the same double
+// (std::to_chars), plain decimal for 1e-6 <= |v| < 1e21 and exponent form
+// outside that range, so 3 prints as "3" and 0.1 as "0.1". Writes at most
+// kMaxNumberChars bytes (no terminator) and returns the length.
+constexpr size_t kMaxNumberChars = 32;
+size_t formatNumber(double v, char* out);
+
 enum class ValueType {
     Nil,
     Number,
@@ -36,6 +44,7 @@ struct Value {
     static Value number(double val);
     static Value boolean(bool val);
     static Value string(const std::string& val);
+    static Value string(std::string&& val);
     static Value function(FunctionValue* val);
     static Value map(const std::unordered_map<std::string, Value>& val);
     static Value array(const std::vector<Value>& val);
@@ -51,6 +60,8 @@ struct Value {
 
     // Conversion
     std::string toString() const;
+    // Appends toString() to `out` without a temporary for numbers/strings.
+    void appendTo(std::string& out) const;
 };
 
 }